@@ -8,6 +8,7 @@
 #include <iostream>
 #include <memory>
 #include <numeric>
+#include <sstream>
 
 #if defined(TRROJAN_FOR_UWP)
 #include <Windows.h>
@@ -16,10 +17,13 @@
 
 #include "trrojan/cmd_line.h"
 #include "trrojan/console_output.h"
+#include "trrojan/csv_output_params.h"
 #include "trrojan/executive.h"
+#include "trrojan/journal.h"
 #include "trrojan/log.h"
 #include "trrojan/power_collector.h"
 #include "trrojan/power_state_scope.h"
+#include "trrojan/shard.h"
 
 #include "app.h"
 
@@ -77,6 +81,28 @@ int main(const int argc, const char **argv) {
                 << std::endl << std::endl;
         }
 
+        /* Merge the results of a sharded run if requested. */
+        {
+            auto it = trrojan::find_switch(std::string("--merge-shards"),
+                cmdLine.begin(), cmdLine.end());
+            if (it != cmdLine.end()) {
+                // The switch is followed by the output path and the paths of
+                // all shards up to the next option.
+                auto end = std::find_if(++it, cmdLine.end(),
+                    [](const std::string& s) { return (s.find("--") == 0); });
+                if (std::distance(it, end) < 2) {
+                    throw std::invalid_argument("--merge-shards requires the "
+                        "path of the output and at least one shard.");
+                }
+
+                const trrojan::csv_output_params params(*it, cmdLine.begin(),
+                    cmdLine.end());
+                std::vector<std::string> inputs(it + 1, end);
+                trrojan::merge_shards(*it, inputs, params.separator());
+                return 0;
+            }
+        }
+
 #if defined(TRROJAN_WITH_POWER_OVERWHELMING)
         {
             auto it = trrojan::find_argument("--power", cmdLine.begin(),
@@ -129,6 +155,40 @@ int main(const int argc, const char **argv) {
             }
         }
 
+        /* Configure sharding. */
+        trrojan::shard shard;
+        {
+            auto it = trrojan::find_argument("--shard", cmdLine.begin(),
+                cmdLine.end());
+            if (it != cmdLine.end()) {
+                shard = trrojan::shard::parse(*it);
+            }
+        }
+        {
+            auto it = trrojan::find_argument("--shard-affinity",
+                cmdLine.begin(), cmdLine.end());
+            if (it != cmdLine.end()) {
+                std::istringstream affinity(*it);
+                std::string factor;
+                shard.affinity.clear();
+                while (std::getline(affinity, factor, ',')) {
+                    if (!factor.empty()) {
+                        shard.affinity.push_back(factor);
+                    }
+                }
+            }
+        }
+
+        /* Open the journal of a campaign that might be resumed. */
+        trrojan::journal::pointer journal;
+        {
+            auto it = trrojan::find_argument("--resume", cmdLine.begin(),
+                cmdLine.end());
+            if (it != cmdLine.end()) {
+                journal = std::make_shared<trrojan::journal>(*it);
+            }
+        }
+
         /* Configure the executive. */
         trrojan::executive exe;
         exe.load_plugins(cmdLine);
@@ -142,7 +202,7 @@ int main(const int argc, const char **argv) {
                     trrojan::log_level::information, "Running benchmarks "
                     "configured in TRROLL script \"{}\" ...", *it);
                 exe.trroll(*it, *output, coolDown, continue_at,
-                    power_collector);
+                    power_collector, shard, journal);
             }
         }
 
@@ -121,7 +121,10 @@ namespace trrojan {
         /// of switching them is minimal for the benchmark.
         /// </summary>
         /// <remarks>
-        /// The default implementation does nothing.
+        /// The default implementation orders the factors by the costs
+        /// declared in <see cref="_switch_costs" /> and enumerates them in
+        /// Gray code order if the benchmark declared any costs. Otherwise, it
+        /// does nothing.
         /// </remarks>
         /// <param name="inOutConfs">The configuration set to be optimised.
         /// </param>
@@ -170,6 +173,16 @@ namespace trrojan {
 
         virtual result run(const configuration& config) = 0;
 
+        /// <summary>
+        /// Answer the estimated costs of switching the manifestations of the
+        /// factors, which the benchmark uses to optimise the order of its
+        /// configurations.
+        /// </summary>
+        inline const configuration_set::switch_cost_map& switch_costs(
+                void) const {
+            return this->_switch_costs;
+        }
+
         // TODO: define the interface.
 
     protected:
@@ -265,6 +278,25 @@ namespace trrojan {
         virtual void check_required_factors(
             const trrojan::configuration_set& cs) const;
 
+        /// <summary>
+        /// Expands a configuration enumerated from the configuration set into
+        /// the configurations that are actually run.
+        /// </summary>
+        /// <remarks>
+        /// <para>The default implementation of <see cref="run" /> calls this
+        /// method for each configuration and reports a separate result for
+        /// each of the returned ones. Subclasses can override it to derive a
+        /// sweep from the other factors, eg problem sizes depending on the
+        /// caches, or to skip a configuration by returning none.</para>
+        /// <para>The default implementation returns <paramref name="c" />
+        /// itself.</para>
+        /// </remarks>
+        /// <param name="c">The configuration including the system factors.
+        /// </param>
+        /// <returns>The configurations to be run.</returns>
+        virtual std::vector<trrojan::configuration> expand_configuration(
+            const trrojan::configuration& c);
+
         /// <summary>
         /// Write an informational message to the log that we are now running
         /// <paramref name="c" />.
@@ -284,6 +316,18 @@ namespace trrojan {
         /// </remarks>
         trrojan::configuration_set _default_configs;
 
+        /// <summary>
+        /// The estimated cost of switching the manifestation of a factor in
+        /// milliseconds, eg for reloading a data set or rebuilding GPU
+        /// resources.
+        /// </summary>
+        /// <remarks>
+        /// Subclasses should declare the costs of all factors which make them
+        /// rebuild expensive state in their constructor. Factors that are not
+        /// declared are considered free to switch.
+        /// </remarks>
+        configuration_set::switch_cost_map _switch_costs;
+
     private:
 
         /// <summary>
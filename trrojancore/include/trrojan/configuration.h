@@ -190,6 +190,24 @@ namespace trrojan {
             this->_factors.reserve(size);
         }
 
+        /// <summary>
+        /// Replaces the value of the <paramref name="i" />th factor, but
+        /// keeps its name.
+        /// </summary>
+        inline void replace_value(const size_t i, trrojan::variant&& value) {
+            this->_factors[i].value() = std::move(value);
+        }
+
+        /// <summary>
+        /// Removes all but the first <paramref name="size" /> factors.
+        /// </summary>
+        inline void truncate(const size_t size) {
+            if (size < this->_factors.size()) {
+                this->_factors.erase(this->_factors.begin() + size,
+                    this->_factors.end());
+            }
+        }
+
         /// <summary>
         /// Answer the <paramref name="i" />th factor.
         /// </summary>
@@ -6,14 +6,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "trrojan/configuration.h"
 #include "trrojan/environment.h"
 #include "trrojan/export.h"
 #include "trrojan/factor.h"
+#include "trrojan/journal.h"
+#include "trrojan/shard.h"
 
 
 namespace trrojan {
@@ -38,6 +42,12 @@ namespace trrojan {
         /// </summary>
         typedef std::vector<factor> factor_list;
 
+        /// <summary>
+        /// Maps the names of factors to the estimated cost of switching
+        /// between their manifestations, eg in milliseconds.
+        /// </summary>
+        typedef std::unordered_map<std::string, double> switch_cost_map;
+
         /// <summary>
         /// Add an additional factor to be tested.
         /// </summary>
@@ -67,6 +77,22 @@ namespace trrojan {
             return (this->findFactor(name) != this->_factors.cend());
         }
 
+        /// <summary>
+        /// Answer the number of configurations in the set, which is the
+        /// product of the number of manifestations of all factors.
+        /// </summary>
+        size_t count_configurations(void) const;
+
+        /// <summary>
+        /// Estimates the total cost of switching factors while enumerating
+        /// all configurations in the current order.
+        /// </summary>
+        /// <param name="costs">The cost of switching each factor. Factors not
+        /// in the map are considered free.</param>
+        /// <returns>The sum of the costs of all manifestation changes between
+        /// consecutive configurations.</returns>
+        double estimate_switch_cost(const switch_cost_map& costs) const;
+
         /// <summary>
         /// Gets the <see cref="trrojan::factor" />s defining the
         /// configurations.
@@ -91,10 +117,51 @@ namespace trrojan {
         /// </summary>
         /// <remarks>
         /// <paramref name="cb" /> will be called until the last configuration
-        /// is reached or until the first invocation returns <c>false</c>
+        /// is reached or until the first invocation returns <c>false</c>. The
+        /// configuration passed to the callback is reused for the next one,
+        /// so only the values of the factors are updated between the calls.
         /// </remarks>
-        bool foreach_configuration(
-            std::function<bool(configuration&)> cb) const;
+        /// <param name="cb">The callback to be invoked.</param>
+        /// <param name="first">The index of the first configuration to be
+        /// passed to the callback. All configurations before it are skipped
+        /// without being enumerated.</param>
+        bool foreach_configuration(std::function<bool(configuration&)> cb,
+            const size_t first = 0) const;
+
+        /// <summary>
+        /// Answer the configuration with the given index in the order of
+        /// <see cref="foreach_configuration" />.
+        /// </summary>
+        /// <remarks>
+        /// The first factor in the set changes with every index. Only the
+        /// manifestations that make up the requested configuration are
+        /// retrieved, so any configuration can be accessed without
+        /// enumerating the ones before it.
+        /// </remarks>
+        /// <param name="i">The index of the configuration, which must be less
+        /// than <see cref="count_configurations" />.</param>
+        /// <param name="dst">Receives the configuration. If it already holds
+        /// the factors of the set in the same order, eg from a previous call,
+        /// only the values are replaced and any factors added after them are
+        /// removed.</param>
+        /// <exception cref="std::out_of_range">If <paramref name="i" /> is not
+        /// a valid index.</exception>
+        void get_configuration(const size_t i, configuration& dst) const;
+
+        /// <summary>
+        /// Answer the configuration with the given index in the order of
+        /// <see cref="foreach_configuration" />.
+        /// </summary>
+        /// <param name="i">The index of the configuration, which must be less
+        /// than <see cref="count_configurations" />.</param>
+        /// <returns>The <paramref name="i" />th configuration.</returns>
+        /// <exception cref="std::out_of_range">If <paramref name="i" /> is not
+        /// a valid index.</exception>
+        inline configuration operator [](const size_t i) const {
+            configuration retval;
+            this->get_configuration(i, retval);
+            return retval;
+        }
 
         /// <summary>
         /// Merge <paramref name="other" /> into this configuration set.
@@ -132,8 +199,122 @@ namespace trrojan {
         /// list.</param>.
         void optimise_order(const std::vector<std::string>& factors);
 
+        /// <summary>
+        /// Reorder the factors in the configuration set such that the total
+        /// cost of switching between the configurations is minimal.
+        /// </summary>
+        /// <remarks>
+        /// <para>The factors are sorted by ascending cost, ie the most
+        /// expensive factor changes at the lowest rate. The configurations
+        /// are then enumerated in reflected mixed-radix Gray code order, in
+        /// which exactly one factor changes between consecutive
+        /// configurations, because a factor does not wrap around to its first
+        /// manifestation when the next factor changes, but runs backwards
+        /// instead.</para>
+        /// <para>For this enumeration, the total cost is
+        /// <c>sum(c_i * (n_i - 1) * n_(i + 1) * ... * n_(m - 1))</c>, which is
+        /// minimal if the factors are sorted by <c>c_i</c>.</para>
+        /// </remarks>
+        /// <param name="costs">The cost of switching each factor. Factors not
+        /// in the map are considered free.</param>
+        void optimise_order(const switch_cost_map& costs);
+
+        /// <summary>
+        /// Restrict <see cref="foreach_configuration" /> to the configurations
+        /// belonging to the given shard.
+        /// </summary>
+        /// <remarks>
+        /// The indices of the configurations are not changed by sharding,
+        /// but each configuration passed to the callback of a sharded
+        /// enumeration is extended by the entry of the shard in the
+        /// <see cref="shard::entry_factor_name" /> factor and by its index in
+        /// the <see cref="shard::factor_name" /> factor.
+        /// </remarks>
+        /// <param name="shard">The shard to be enumerated.</param>
+        inline void select_shard(const trrojan::shard& shard) {
+            this->_shard = shard;
+        }
+
+        /// <summary>
+        /// Answer the journal that benchmarks running this configuration set
+        /// should use to skip completed configurations and record the ones
+        /// they complete.
+        /// </summary>
+        /// <returns>The journal, which might be <c>nullptr</c>.</returns>
+        inline const trrojan::journal::pointer& selected_journal(void) const {
+            return this->_journal;
+        }
+
+        /// <summary>
+        /// Sets the journal returned by <see cref="selected_journal" />.
+        /// </summary>
+        /// <param name="journal">The journal of the campaign, which may be
+        /// <c>nullptr</c> to run all configurations.</param>
+        inline void select_journal(const trrojan::journal::pointer& journal) {
+            this->_journal = journal;
+        }
+
+        /// <summary>
+        /// Answer the index of the shard the configuration with the given
+        /// index belongs to.
+        /// </summary>
+        /// <remarks>
+        /// If the set holds fewer groups of configurations sharing the
+        /// affinity factors of the selected shard than there are shards, the
+        /// affinity is ignored and the configurations are distributed
+        /// individually, because some shards would otherwise remain idle.
+        /// </remarks>
+        /// <param name="i">The index of the configuration, which must be less
+        /// than <see cref="count_configurations" />.</param>
+        /// <returns>The zero-based index of the shard.</returns>
+        size_t shard_of(const size_t i) const;
+
     private:
 
+        /// <summary>
+        /// Removes the least significant digit of the configuration index
+        /// <paramref name="r" /> and answers the index of the manifestation
+        /// of <paramref name="factor" /> it represents.
+        /// </summary>
+        inline size_t next_manifestation(size_t& r,
+                const factor& factor) const {
+            auto retval = r % factor.size();
+            r /= factor.size();
+            if (this->_is_reflected && ((r % 2) != 0)) {
+                // In Gray code order, the factor runs backwards whenever the
+                // number formed by the more significant factors is odd.
+                retval = factor.size() - 1 - retval;
+            }
+            return retval;
+        }
+
+        /// <summary>
+        /// Answer the index of the combination of the affinity factors of the
+        /// selected shard in the configuration with the given index.
+        /// </summary>
+        size_t affinity_group(const size_t i) const;
+
+        /// <summary>
+        /// Answer the number of consecutive configurations which are
+        /// guaranteed to share the same combination of affinity factors.
+        /// </summary>
+        size_t count_affinity_block(void) const;
+
+        /// <summary>
+        /// Answer the number of distinct combinations of the affinity factors
+        /// of the selected shard, or zero if the set contains none of them.
+        /// </summary>
+        size_t count_affinity_groups(void) const;
+
+        /// <summary>
+        /// Answer whether <paramref name="factor" /> is one of the affinity
+        /// factors of the selected shard.
+        /// </summary>
+        inline bool is_affinity_factor(const factor& factor) const {
+            auto& a = this->_shard.affinity;
+            return (std::find(a.begin(), a.end(), factor.name()) != a.end());
+        }
+
         inline factor_list::iterator findFactor(const std::string& name) {
             return std::find_if(this->_factors.begin(), this->_factors.end(),
                 [&name](const factor& f) { return (f.name() == name); });
@@ -149,5 +330,21 @@ namespace trrojan {
         /// Holds all the factors defining the configurations.
         /// </summary>
         factor_list _factors;
+
+        /// <summary>
+        /// Determines whether the configurations are enumerated in reflected
+        /// Gray code order rather than in lexicographic order.
+        /// </summary>
+        bool _is_reflected = false;
+
+        /// <summary>
+        /// The journal of completed configurations, if any.
+        /// </summary>
+        trrojan::journal::pointer _journal;
+
+        /// <summary>
+        /// The part of the configurations to be enumerated.
+        /// </summary>
+        trrojan::shard _shard;
     };
 }
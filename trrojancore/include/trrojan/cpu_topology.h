@@ -0,0 +1,207 @@
+﻿// <copyright file="cpu_topology.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <vector>
+
+#include "trrojan/export.h"
+
+
+namespace trrojan {
+
+    /// <summary>
+    /// Describes how the logical processors of the machine are distributed
+    /// over physical cores and processor packages (sockets).
+    /// </summary>
+    /// <remarks>
+    /// The topology is retrieved from sysfs on Linux and from
+    /// <c>GetLogicalProcessorInformationEx</c> on Windows. On Linux, it only
+    /// comprises the processors in the affinity mask of the process, ie the
+    /// ones left by <c>taskset</c> or the cpuset of a container. If the
+    /// information is not available, the topology falls back to one package
+    /// with one physical core per logical processor reported by the standard
+    /// library.
+    /// </remarks>
+    class TRROJANCORE_API cpu_topology final {
+
+    public:
+
+        /// <summary>
+        /// Describes a data or unified cache level.
+        /// </summary>
+        struct cache {
+
+            /// <summary>
+            /// The level of the cache, starting with 1 for the cache closest
+            /// to the core.
+            /// </summary>
+            std::uint32_t level;
+
+            /// <summary>
+            /// The size of one instance of the cache in bytes.
+            /// </summary>
+            std::size_t size;
+
+            /// <summary>
+            /// The size of a cache line in bytes.
+            /// </summary>
+            std::size_t line_size;
+
+            /// <summary>
+            /// The number of logical processors sharing one instance of the
+            /// cache.
+            /// </summary>
+            std::uint32_t sharing;
+        };
+
+        /// <summary>
+        /// The type of the list of caches.
+        /// </summary>
+        typedef std::vector<cache> cache_list;
+
+        /// <summary>
+        /// Describes a single logical processor (hardware thread).
+        /// </summary>
+        struct logical_processor {
+
+            /// <summary>
+            /// The index of the logical processor as used by the operating
+            /// system.
+            /// </summary>
+            /// <remarks>
+            /// On Linux, this is the CPU number. On Windows, it is the
+            /// processor group multiplied by 64 plus <see cref="number" />.
+            /// </remarks>
+            std::uint32_t id;
+
+            /// <summary>
+            /// The processor group the logical processor belongs to. This is
+            /// always zero on platforms that do not have processor groups.
+            /// </summary>
+            std::uint16_t group;
+
+            /// <summary>
+            /// The index of the logical processor within its
+            /// <see cref="group" />.
+            /// </summary>
+            std::uint8_t number;
+
+            /// <summary>
+            /// The zero-based, dense index of the processor package (socket).
+            /// </summary>
+            std::uint32_t package;
+
+            /// <summary>
+            /// The zero-based, dense index of the physical core, which is
+            /// unique across all packages.
+            /// </summary>
+            std::uint32_t core;
+
+            /// <summary>
+            /// The index of the hardware thread on its physical
+            /// <see cref="core" />, ie 0 for the first hardware thread, 1 for
+            /// its SMT sibling and so on.
+            /// </summary>
+            std::uint32_t smt;
+
+            /// <summary>
+            /// The number of the NUMA node the logical processor belongs to
+            /// as used by the operating system.
+            /// </summary>
+            std::uint32_t node;
+        };
+
+        /// <summary>
+        /// The type of the list of logical processors.
+        /// </summary>
+        typedef std::vector<logical_processor> processor_list;
+
+        /// <summary>
+        /// Retrieves the current topology from the operating system.
+        /// </summary>
+        /// <returns>The topology of the machine the process is running on.
+        /// </returns>
+        static cpu_topology collect(void);
+
+        /// <summary>
+        /// Gets a lazily collected topology of the machine.
+        /// </summary>
+        /// <returns>The topology of the machine.</returns>
+        static const cpu_topology& instance(void);
+
+        /// <summary>
+        /// Gets the affinity mask for the given processor within its
+        /// <see cref="logical_processor::group" />.
+        /// </summary>
+        static inline std::uint64_t affinity_mask(
+                const logical_processor& processor) {
+            return (static_cast<std::uint64_t>(1) << processor.number);
+        }
+
+        /// <summary>
+        /// Initialises an empty topology.
+        /// </summary>
+        cpu_topology(void) = default;
+
+        /// <summary>
+        /// Gets the data and unified caches of the first logical processor
+        /// ordered by their level.
+        /// </summary>
+        /// <remarks>
+        /// The list is empty if the cache hierarchy could not be retrieved.
+        /// All logical processors are assumed to have the same caches.
+        /// </remarks>
+        inline const cache_list& caches(void) const {
+            return this->_caches;
+        }
+
+        /// <summary>
+        /// Answer the number of logical processors.
+        /// </summary>
+        inline std::size_t logical_cores(void) const {
+            return this->_processors.size();
+        }
+
+        /// <summary>
+        /// Gets all logical processors ordered by their
+        /// <see cref="logical_processor::id" />.
+        /// </summary>
+        inline const processor_list& logical_processors(void) const {
+            return this->_processors;
+        }
+
+        /// <summary>
+        /// Answer the number of processor packages (sockets).
+        /// </summary>
+        std::size_t packages(void) const;
+
+        /// <summary>
+        /// Answer the distinct NUMA nodes the logical processors belong to in
+        /// ascending order.
+        /// </summary>
+        std::vector<std::uint32_t> numa_nodes(void) const;
+
+        /// <summary>
+        /// Answer the number of physical cores.
+        /// </summary>
+        std::size_t physical_cores(void) const;
+
+    private:
+
+        /// <summary>
+        /// Assigns dense package and core indices and the SMT indices after
+        /// the raw information has been retrieved.
+        /// </summary>
+        void normalise(void);
+
+        cache_list _caches;
+        processor_list _processors;
+    };
+
+}
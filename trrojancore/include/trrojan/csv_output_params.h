@@ -55,8 +55,9 @@ namespace trrojan {
         inline csv_output_params(const std::string& path,
             const std::string& separator, const bool quote_strings,
             const std::string& line_break)
-            : basic_output_params(path), _line_break(line_break),
-            _quote_strings(quote_strings), _separator(separator) { }
+            : basic_output_params(path), _append(false),
+            _line_break(line_break), _quote_strings(quote_strings),
+            _separator(separator) { }
 
         /// <summary>
         /// Initialises a new instance from a command line.
@@ -69,7 +70,7 @@ namespace trrojan {
             I cmdLineBegin, I cmdLineEnd);
 
         inline explicit csv_output_params(const basic_output_params& params)
-            : basic_output_params(params.path()),
+            : basic_output_params(params.path()), _append(false),
             _line_break(default_line_break), _quote_strings(true),
             _separator(default_separator) { }
 
@@ -78,6 +79,14 @@ namespace trrojan {
         /// </summary>
         virtual ~csv_output_params(void);
 
+        /// <summary>
+        /// Answer whether results should be appended to an existing file,
+        /// which is the case if a campaign is resumed.
+        /// </summary>
+        inline bool append(void) const {
+            return this->_append;
+        }
+
         inline const std::string& line_break(void) const {
             return this->_line_break;
         }
@@ -92,6 +101,8 @@ namespace trrojan {
 
     private:
 
+        bool _append;
+
         std::string _line_break;
 
         bool _quote_strings;
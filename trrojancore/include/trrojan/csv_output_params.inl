@@ -12,6 +12,9 @@ template<class I>
 trrojan::csv_output_params::csv_output_params(const std::string& path,
         I cmdLineBegin, I cmdLineEnd) : basic_output_params(path) {
 
+    this->_append = (trrojan::find_argument("--resume", cmdLineBegin,
+        cmdLineEnd) != cmdLineEnd);
+
     {
         auto it = trrojan::find_argument("--separator", cmdLineBegin,
             cmdLineEnd);
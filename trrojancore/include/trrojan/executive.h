@@ -27,9 +27,11 @@
 #include "trrojan/environment.h"
 #include "trrojan/export.h"
 #include "trrojan/image_helper.h"
+#include "trrojan/journal.h"
 #include "trrojan/output.h"
 #include "trrojan/power_collector.h"
 #include "trrojan/plugin.h"
+#include "trrojan/shard.h"
 #include "trrojan/trroll_parser.h"
 
 
@@ -181,15 +183,24 @@ namespace trrojan {
         /// results.</param>
         /// <param name="cool_down">Controls regular cool-down periods between
         /// benchmarks that are running over weeks.</param>
-        /// <param name="continue_at">Instructs the benchmark to skip all
-        /// configurations until the given one.</param>
+        /// <param name="continue_at">The zero-based index of the first
+        /// configuration to be run. All configurations before it are skipped
+        /// without being enumerated.</param>
         /// <param name="power_collector">If not <c>nullptr</c>, enables the
         /// benchmark to measure the power consumption of its work.</param>
+        /// <param name="shard">Restricts the benchmarks to the part of their
+        /// configurations that is assigned to this process if a sweep is
+        /// distributed over multiple processes.</param>
+        /// <param name="journal">If not <c>nullptr</c>, the benchmarks skip
+        /// the configurations recorded as completed in the journal and
+        /// record the ones they complete.</param>
         void trroll(const troll_input_type& path,
             output_base& output,
             const cool_down& cool_down,
             const std::size_t continue_at,
-            power_collector::pointer power_collector);
+            power_collector::pointer power_collector,
+            const trrojan::shard& shard = trrojan::shard(),
+            const journal::pointer& journal = nullptr);
 
         executive operator =(const executive&) = delete;
 
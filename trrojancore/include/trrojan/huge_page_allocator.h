@@ -0,0 +1,121 @@
+﻿// <copyright file="huge_page_allocator.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+
+#include "trrojan/page_size.h"
+
+
+namespace trrojan {
+
+    /// <summary>
+    /// An allocator that places each allocation on its own pages, which can
+    /// be huge pages to reduce TLB misses for large buffers.
+    /// </summary>
+    /// <remarks>
+    /// Each allocation is rounded up to full pages, so this allocator should
+    /// only be used for large buffers.
+    /// </remarks>
+    /// <typeparam name="TType"></typeparam>
+    template<class TType> class huge_page_allocator {
+
+    public:
+
+        /// <summary>
+        /// The type used to express counters and memory size.
+        /// </summary>
+        typedef std::size_t size_type;
+
+        /// <summary>
+        /// The type determining the size of one object allocated by this
+        /// allocator.
+        /// </summary>
+        typedef TType value_type;
+
+        /// <summary>
+        /// Initialises a new instance.
+        /// </summary>
+        /// <param name="pages">The kind of pages to back the allocations.
+        /// </param>
+        huge_page_allocator(const page_size pages = page_size::huge_2m)
+            noexcept : _page_size(pages) { }
+
+        /// <summary>
+        /// Clone <paramref name="rhs" />.
+        /// </summary>
+        /// <typeparam name="T"></typeparam>
+        /// <param name="rhs"></param>
+        /// <returns></returns>
+        template<class T>
+        huge_page_allocator(const huge_page_allocator<T> &rhs) noexcept
+            : _page_size(rhs._page_size) { }
+
+        /// <summary>
+        /// Allocates memory for <paramref name="n" /> elements of
+        /// <see cref="value_type" /> on pages of the configured size.
+        /// </summary>
+        /// <param name="n"></param>
+        /// <returns></returns>
+        value_type *allocate(const size_type n);
+
+        /// <summary>
+        /// Frees an allocation created by this allocator.
+        /// </summary>
+        /// <param name="p"></param>
+        /// <param name="n"></param>
+        /// <returns></returns>
+        void deallocate(value_type *p, const size_type n) noexcept;
+
+        /// <summary>
+        /// Answer the kind of pages backing the allocations.
+        /// </summary>
+        inline trrojan::page_size page_size(void) const noexcept {
+            return this->_page_size;
+        }
+
+        /// <summary>
+        /// Assignment
+        /// </summary>
+        /// <typeparam name="T"></typeparam>
+        /// <param name="rhs"></param>
+        /// <returns></returns>
+        template<class T>
+        huge_page_allocator& operator =(const huge_page_allocator<T> &rhs);
+
+        /// <summary>
+        /// Test for equality, which requires the same kind of pages.
+        /// </summary>
+        template<class T>
+        inline bool operator ==(const huge_page_allocator<T>& rhs)
+                const noexcept {
+            return (this->_page_size == rhs._page_size);
+        }
+
+        /// <summary>
+        /// Test for inequality.
+        /// </summary>
+        template<class T>
+        inline bool operator !=(const huge_page_allocator<T>& rhs)
+                const noexcept {
+            return !(*this == rhs);
+        }
+
+    private:
+
+        trrojan::page_size _page_size;
+
+        // Allow siblings copy the page size.
+        template<class T> friend class huge_page_allocator;
+    };
+
+} /* end namespace trrojan */
+
+#include "trrojan/huge_page_allocator.inl"
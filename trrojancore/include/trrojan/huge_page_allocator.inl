@@ -0,0 +1,40 @@
+﻿// <copyright file="huge_page_allocator.inl" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+
+/*
+ * trrojan::huge_page_allocator<TType>::allocate
+ */
+template<class TType>
+typename trrojan::huge_page_allocator<TType>::value_type *
+trrojan::huge_page_allocator<TType>::allocate(const size_type n) {
+    assert(n <= (std::numeric_limits<size_type>::max)() / sizeof(value_type));
+    auto retval = allocate_pages(n * sizeof(value_type), this->_page_size);
+    return static_cast<value_type *>(retval);
+}
+
+
+/*
+ * trrojan::huge_page_allocator<TType>::deallocate
+ */
+template<class TType>
+void trrojan::huge_page_allocator<TType>::deallocate(value_type *p,
+        const size_type n) noexcept {
+    free_pages(p, n * sizeof(value_type), this->_page_size);
+}
+
+
+/*
+ * trrojan::huge_page_allocator<TType>::operator =
+ */
+template<class TType>
+template<class T>
+trrojan::huge_page_allocator<TType>&
+trrojan::huge_page_allocator<TType>::operator =(
+        const huge_page_allocator<T>& rhs) {
+    this->_page_size = rhs._page_size;
+    return *this;
+}
@@ -0,0 +1,129 @@
+﻿// <copyright file="journal.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "trrojan/configuration.h"
+#include "trrojan/export.h"
+
+
+namespace trrojan {
+
+    /// <summary>
+    /// An append-only record of the configurations that have been completed
+    /// in a benchmark campaign, which allows for resuming the campaign after
+    /// a crash.
+    /// </summary>
+    /// <remarks>
+    /// <para>Each line of the journal holds the hash of a completed
+    /// configuration, the sequence number of the entry, ie the number of
+    /// entries before it, and the name of the benchmark. The sequence number
+    /// is not a position in the output, which is only appended to on resume,
+    /// but it allows for restoring the order of the entries. The hash
+    /// only depends on the name of the benchmark and the names and values of
+    /// the factors, but not on their order, so the journal remains valid if
+    /// the TRROLL script or the enumeration order is changed.</para>
+    /// <para>An entry is only appended after the result has been written to
+    /// the output. If the process is terminated between the two, the
+    /// configuration is run again on resume and its result is written
+    /// twice.</para>
+    /// </remarks>
+    class TRROJANCORE_API journal final {
+
+    public:
+
+        /// <summary>
+        /// A pointer type by which the journal is referenced.
+        /// </summary>
+        typedef std::shared_ptr<journal> pointer;
+
+        /// <summary>
+        /// Computes the stable hash identifying a configuration of the given
+        /// benchmark.
+        /// </summary>
+        /// <remarks>
+        /// System factors, the factors added by sharding and the power collector
+        /// are ignored, because they change between runs of the same
+        /// configuration.
+        /// </remarks>
+        /// <param name="benchmark">The name of the benchmark.</param>
+        /// <param name="config">The configuration to be hashed.</param>
+        /// <returns>The 64-bit FNV-1a hash of the configuration.</returns>
+        static std::uint64_t hash(const std::string& benchmark,
+            const configuration& config);
+
+        /// <summary>
+        /// Opens the journal at the given location, reading the entries of a
+        /// previous run if the file exists.
+        /// </summary>
+        /// <param name="path">The path to the journal file.</param>
+        /// <exception cref="std::runtime_error">If the journal could not be
+        /// opened for appending.</exception>
+        explicit journal(const std::string& path);
+
+        journal(const journal&) = delete;
+
+        /// <summary>
+        /// Finalises the instance.
+        /// </summary>
+        ~journal(void) = default;
+
+        /// <summary>
+        /// Records that the given configuration has been completed and its
+        /// result has been written to the output.
+        /// </summary>
+        /// <param name="benchmark">The name of the benchmark.</param>
+        /// <param name="config">The configuration that has been run.</param>
+        /// <exception cref="std::runtime_error">If the entry could not be
+        /// written.</exception>
+        void append(const std::string& benchmark, const configuration& config);
+
+        /// <summary>
+        /// Answer whether the given configuration has already been completed.
+        /// </summary>
+        /// <param name="benchmark">The name of the benchmark.</param>
+        /// <param name="config">The configuration to be checked.</param>
+        /// <returns><c>true</c> if the journal holds an entry for the
+        /// configuration, <c>false</c> otherwise.</returns>
+        bool contains(const std::string& benchmark,
+            const configuration& config) const;
+
+        /// <summary>
+        /// Answer the number of entries recorded in the journal.
+        /// </summary>
+        inline std::size_t size(void) const {
+            return this->_cnt_entries;
+        }
+
+        journal& operator =(const journal&) = delete;
+
+    private:
+
+        /// <summary>
+        /// The number of entries recorded, which is the sequence number of the
+        /// next one.
+        /// </summary>
+        std::size_t _cnt_entries;
+
+        /// <summary>
+        /// The hashes of all completed configurations.
+        /// </summary>
+        std::unordered_set<std::uint64_t> _completed;
+
+        /// <summary>
+        /// The file the entries are appended to.
+        /// </summary>
+        std::ofstream _file;
+    };
+
+}
@@ -99,6 +99,14 @@ namespace trrojan {
             return this->_value;
         }
 
+        /// <summary>
+        /// Answer the value of the item.
+        /// </summary>
+        /// <returns></returns>
+        inline variant& value(void) {
+            return this->_value;
+        }
+
         /// <summary>
         /// Implicit conversion to <see cref="trrojan::variant" />.
         /// </summary>
@@ -0,0 +1,125 @@
+﻿// <copyright file="page_size.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "trrojan/enum_dispatch_list.h"
+#include "trrojan/export.h"
+
+
+namespace trrojan {
+
+    /// <summary>
+    /// The kinds of virtual memory pages that can back an allocation.
+    /// </summary>
+    enum class page_size {
+
+        /// <summary>
+        /// The default page size of the system, which is 4 KiB on x86.
+        /// </summary>
+        regular,
+
+        /// <summary>
+        /// Regular pages that the operating system is asked to promote to
+        /// huge pages (transparent huge pages on Linux).
+        /// </summary>
+        transparent,
+
+        /// <summary>
+        /// Explicitly allocated 2 MiB pages (or the minimum large page size
+        /// on Windows).
+        /// </summary>
+        huge_2m,
+
+        /// <summary>
+        /// Explicitly allocated 1 GiB pages.
+        /// </summary>
+        huge_1g
+    };
+
+
+    /// <summary>
+    /// A traits class for parsing page sizes.
+    /// </summary>
+    template<page_size P> struct page_size_traits { };
+
+#define __TRROJANCORE_DECL_PAGE_SIZE_TRAITS(p)                                 \
+    template<> struct page_size_traits<page_size::p> {                         \
+        static inline const std::string& name(void) {                          \
+            static const std::string retval(#p);                               \
+            return retval;                                                     \
+        }                                                                      \
+    }
+
+    __TRROJANCORE_DECL_PAGE_SIZE_TRAITS(regular);
+    __TRROJANCORE_DECL_PAGE_SIZE_TRAITS(transparent);
+    __TRROJANCORE_DECL_PAGE_SIZE_TRAITS(huge_2m);
+    __TRROJANCORE_DECL_PAGE_SIZE_TRAITS(huge_1g);
+
+#undef __TRROJANCORE_DECL_PAGE_SIZE_TRAITS
+
+
+    template<page_size... V>
+    using page_size_list_t = enum_dispatch_list<page_size, V...>;
+
+    typedef page_size_list_t<page_size::regular, page_size::transparent,
+        page_size::huge_2m, page_size::huge_1g> page_size_list;
+
+
+    /// <summary>
+    /// Allocates at least <paramref name="size" /> bytes of page-aligned,
+    /// readable and writable memory backed by the requested kind of pages.
+    /// </summary>
+    /// <remarks>
+    /// If the requested pages are not available, eg because no huge pages
+    /// have been reserved or the process lacks the privilege to lock memory,
+    /// a warning is issued and the allocation falls back to the next smaller
+    /// kind of page. The size of the allocation is rounded up to
+    /// <see cref="round_to_pages" />. On Windows, the memory is committed
+    /// immediately.
+    /// </remarks>
+    /// <param name="size">The minimum size of the allocation in bytes.
+    /// </param>
+    /// <param name="pages">The kind of pages to be used.</param>
+    /// <param name="populate">If <c>true</c>, the physical pages are
+    /// allocated before the function returns rather than on first touch. On
+    /// Linux, this uses <c>MAP_POPULATE</c> or, for transparent huge pages,
+    /// <c>MADV_POPULATE_WRITE</c>. Where neither is available, each page is
+    /// written once.</param>
+    /// <returns>The begin of the allocation, which must be released using
+    /// <see cref="free_pages" />.</returns>
+    /// <exception cref="std::system_error">If the allocation failed even for
+    /// regular pages.</exception>
+    TRROJANCORE_API void *allocate_pages(const std::size_t size,
+        const page_size pages, const bool populate = false);
+
+    /// <summary>
+    /// Releases an allocation made by <see cref="allocate_pages" />.
+    /// </summary>
+    /// <param name="data">The begin of the allocation.</param>
+    /// <param name="size">The size that was requested from
+    /// <see cref="allocate_pages" />.</param>
+    /// <param name="pages">The kind of pages that was requested from
+    /// <see cref="allocate_pages" />.</param>
+    TRROJANCORE_API void free_pages(void *data, const std::size_t size,
+        const page_size pages) noexcept;
+
+    /// <summary>
+    /// Answer the size of a single page of the given kind in bytes.
+    /// </summary>
+    TRROJANCORE_API std::size_t get_page_size(const page_size pages);
+
+    /// <summary>
+    /// Rounds <paramref name="size" /> up to a multiple of the size of the
+    /// given kind of pages.
+    /// </summary>
+    TRROJANCORE_API std::size_t round_to_pages(const std::size_t size,
+        const page_size pages);
+
+} /* end namespace trrojan */
@@ -0,0 +1,217 @@
+﻿// <copyright file="perf_counters.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "trrojan/export.h"
+#include "trrojan/result.h"
+
+
+namespace trrojan {
+
+    /// <summary>
+    /// The hardware events that can be counted by a
+    /// <see cref="perf_counter_group" />.
+    /// </summary>
+    enum class perf_counter {
+
+        /// <summary>
+        /// The number of CPU cycles.
+        /// </summary>
+        cycles = 0,
+
+        /// <summary>
+        /// The number of retired instructions.
+        /// </summary>
+        instructions,
+
+        /// <summary>
+        /// The number of misses in the last-level cache.
+        /// </summary>
+        llc_misses,
+
+        /// <summary>
+        /// The number of misses in the data TLB.
+        /// </summary>
+        dtlb_misses,
+
+        /// <summary>
+        /// The number of bytes read and written by the integrated memory
+        /// controllers, which is counted for the whole system.
+        /// </summary>
+        imc_bytes,
+
+        /// <summary>
+        /// The number of counters, which must be the last member.
+        /// </summary>
+        count
+    };
+
+
+    /// <summary>
+    /// A set of hardware performance counters that are started and stopped
+    /// together around a measured section of code.
+    /// </summary>
+    /// <remarks>
+    /// <para>On Linux, the counters are opened using <c>perf_event_open</c>
+    /// and count the events of the thread that created the group, wherever
+    /// it is scheduled. The core events are opened as one group such that
+    /// they are always scheduled together. If the kernel needs to multiplex
+    /// the counters, the values are scaled to the whole measurement.</para>
+    /// <para>Counting the bytes transferred by the memory controllers
+    /// requires access to the uncore PMUs, which usually requires
+    /// <c>/proc/sys/kernel/perf_event_paranoid</c> to be at most zero. As
+    /// these counters are system-wide, only one group of a multi-threaded
+    /// benchmark should request them.</para>
+    /// <para>Counters that cannot be opened are reported as
+    /// <see cref="perf_counter_group::invalid_value" /> and a warning is
+    /// issued once when the group is created. On other platforms, all
+    /// counters are invalid.</para>
+    /// <para>Instances must not be copied, because they own the file
+    /// descriptors of the counters.</para>
+    /// </remarks>
+    class TRROJANCORE_API perf_counter_group {
+
+    public:
+
+        /// <summary>
+        /// The type of a counter value.
+        /// </summary>
+        typedef std::uint64_t value_type;
+
+        /// <summary>
+        /// The values of all counters indexed by
+        /// <see cref="perf_counter" />.
+        /// </summary>
+        typedef std::array<value_type,
+            static_cast<std::size_t>(perf_counter::count)> values_type;
+
+        /// <summary>
+        /// The value reported for counters that are not available.
+        /// </summary>
+        static constexpr value_type invalid_value
+            = (std::numeric_limits<value_type>::max)();
+
+        /// <summary>
+        /// Appends the result names of all counters that are valid in
+        /// <paramref name="values" /> to <paramref name="names" />.
+        /// </summary>
+        static void append_result_names(
+            basic_result::result_names_type& names,
+            const values_type& values);
+
+        /// <summary>
+        /// Appends all counters that are valid in <paramref name="values" />
+        /// to <paramref name="results" /> in the order of
+        /// <see cref="append_result_names" />.
+        /// </summary>
+        static void append_results(basic_result::result_type& results,
+            const values_type& values);
+
+        /// <summary>
+        /// Appends the counters that are valid in <paramref name="columns" />
+        /// to <paramref name="results" />, which allows for reporting
+        /// values that have been captured by different groups in the same
+        /// columns.
+        /// </summary>
+        /// <remarks>
+        /// Counters that are valid in <paramref name="columns" />, but not in
+        /// <paramref name="values" />, are added as empty variants.
+        /// </remarks>
+        static void append_results(basic_result::result_type& results,
+            const values_type& values, const values_type& columns);
+
+        /// <summary>
+        /// Adds the valid counters from <paramref name="rhs" /> to
+        /// <paramref name="lhs" />, eg to aggregate the counters of multiple
+        /// threads.
+        /// </summary>
+        /// <remarks>
+        /// A counter of the sum is valid if it is valid in any of the
+        /// operands.
+        /// </remarks>
+        static void accumulate(values_type& lhs, const values_type& rhs);
+
+        /// <summary>
+        /// Answer a set of values that are all invalid.
+        /// </summary>
+        static values_type invalid_values(void);
+
+        /// <summary>
+        /// Answer the name of the result column of
+        /// <paramref name="counter" />.
+        /// </summary>
+        static const std::string& result_name(const perf_counter counter);
+
+        /// <summary>
+        /// Opens the counters for the calling thread.
+        /// </summary>
+        /// <param name="uncore">If <c>true</c>, the system-wide memory
+        /// controller counters are opened, too.</param>
+        explicit perf_counter_group(const bool uncore = true);
+
+        perf_counter_group(const perf_counter_group&) = delete;
+
+        /// <summary>
+        /// Finalises the instance.
+        /// </summary>
+        ~perf_counter_group(void);
+
+        /// <summary>
+        /// Answer whether any of the counters could be opened.
+        /// </summary>
+        bool available(void) const;
+
+        /// <summary>
+        /// Resets and enables all counters.
+        /// </summary>
+        void start(void);
+
+        /// <summary>
+        /// Disables all counters and answers the events counted since the
+        /// last call to <see cref="start" />.
+        /// </summary>
+        values_type stop(void);
+
+        perf_counter_group& operator =(const perf_counter_group&) = delete;
+
+    private:
+
+        /// <summary>
+        /// The handle of the leader of the core event group.
+        /// </summary>
+        int _leader;
+
+        /// <summary>
+        /// The counter each member of the core event group is counting in the
+        /// order the events are read.
+        /// </summary>
+        std::vector<perf_counter> _members;
+
+        /// <summary>
+        /// The handles of all core events including the leader.
+        /// </summary>
+        std::vector<int> _handles;
+
+        /// <summary>
+        /// The handles of the counters of the memory controllers.
+        /// </summary>
+        std::vector<int> _uncore;
+
+        /// <summary>
+        /// The number of bytes per counted memory controller event.
+        /// </summary>
+        std::vector<double> _uncore_scales;
+    };
+
+} /* end namespace trrojan */
@@ -0,0 +1,142 @@
+﻿// <copyright file="shard.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "trrojan/export.h"
+
+
+namespace trrojan {
+
+    /// <summary>
+    /// Configuration of which part of the configuration space the
+    /// <see cref="executive" /> should run if a sweep is distributed over
+    /// multiple processes or machines.
+    /// </summary>
+    /// <remarks>
+    /// <para>The configurations are partitioned into groups that share the
+    /// same manifestations of the <see cref="affinity" /> factors, which are
+    /// the ones requiring expensive state like a loaded data set. The groups
+    /// are assigned to the shards in contiguous blocks, ie all configurations
+    /// of a group are run by the same shard. If none of the affinity factors
+    /// is present, each configuration forms its own group.</para>
+    /// <para>The partitioning only depends on the configuration set, so all
+    /// shards running the same TRROLL script on the same kind of machine
+    /// agree on it without communicating.</para>
+    /// </remarks>
+    struct TRROJANCORE_API shard {
+
+        /// <summary>
+        /// The default names of the factors whose configurations should be
+        /// kept on the same shard.
+        /// </summary>
+        static const std::vector<std::string> default_affinity;
+
+        /// <summary>
+        /// The name of the factor that is added to every configuration of a
+        /// sharded run and holds the <see cref="entry" /> of the TRROLL script
+        /// it stems from.
+        /// </summary>
+        /// <remarks>
+        /// The index in <see cref="factor_name" /> restarts for every entry,
+        /// so the results can only be ordered by both factors.
+        /// </remarks>
+        static const std::string entry_factor_name;
+
+        /// <summary>
+        /// The name of the factor that is added to every configuration of a
+        /// sharded run and holds the index of the configuration in the
+        /// complete enumeration of its configuration set.
+        /// </summary>
+        /// <remarks>
+        /// Together with <see cref="entry_factor_name" />, this factor allows
+        /// for merging the results of all shards in the order they would have
+        /// been produced by a single process.
+        /// </remarks>
+        static const std::string factor_name;
+
+        /// <summary>
+        /// Parses a shard specification of the form &quot;i/n&quot;.
+        /// </summary>
+        /// <param name="str">The specification to be parsed.</param>
+        /// <returns>The zero-based shard <c>i</c> out of <c>n</c> using the
+        /// <see cref="default_affinity" />.</returns>
+        /// <exception cref="std::invalid_argument">If <paramref name="str" />
+        /// is not a valid specification or if <c>i</c> is not less than
+        /// <c>n</c>.</exception>
+        static shard parse(const std::string& str);
+
+        /// <summary>
+        /// The names of the factors whose configurations must be run by the
+        /// same shard.
+        /// </summary>
+        std::vector<std::string> affinity;
+
+        /// <summary>
+        /// The total number of shards.
+        /// </summary>
+        /// <remarks>
+        /// If this value is one, the whole configuration space is run.
+        /// </remarks>
+        std::size_t count;
+
+        /// <summary>
+        /// The zero-based ordinal of the configuration set within the run,
+        /// ie the position of its entry in the TRROLL script as executed.
+        /// </summary>
+        std::size_t entry;
+
+        /// <summary>
+        /// The zero-based index of the shard to be run.
+        /// </summary>
+        std::size_t index;
+
+        /// <summary>
+        /// Initialises a new instance representing the whole configuration
+        /// space.
+        /// </summary>
+        inline shard(void) : affinity(default_affinity), count(1), entry(0),
+            index(0) { }
+
+        /// <summary>
+        /// Answer whether the configuration space is actually split.
+        /// </summary>
+        /// <returns><c>true</c> if there is more than one shard, <c>false</c>
+        /// otherwise.</returns>
+        inline bool enabled(void) const {
+            return (this->count > 1);
+        }
+    };
+
+
+    /// <summary>
+    /// Merges the CSV files produced by all shards of a sweep into a single
+    /// file.
+    /// </summary>
+    /// <remarks>
+    /// The rows are ordered by the <see cref="shard::entry_factor_name" />
+    /// column and then by the <see cref="shard::factor_name" /> column. Rows
+    /// with the same entry and index, which stem from multiple measurements
+    /// of the same configuration, retain their order. All inputs must have
+    /// the same header.
+    /// </remarks>
+    /// <param name="output">The path to the merged file.</param>
+    /// <param name="inputs">The paths to the CSV files of the shards.</param>
+    /// <param name="separator">The column separator used in the inputs.
+    /// </param>
+    /// <returns>The number of rows written, excluding the header.</returns>
+    /// <exception cref="std::invalid_argument">If the inputs have different
+    /// headers or lack the entry or index column.</exception>
+    /// <exception cref="std::runtime_error">If an input could not be read or
+    /// the output could not be written.</exception>
+    TRROJANCORE_API std::size_t merge_shards(const std::string& output,
+        const std::vector<std::string>& inputs,
+        const std::string& separator);
+}
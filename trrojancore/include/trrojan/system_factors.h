@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "trrojan/export.h"
 #include "trrojan/named_variant.h"
@@ -36,6 +38,25 @@ namespace trrojan {
         /// </summary>
         typedef variant(trrojan::system_factors::*retriever_type)(void) const;
 
+        /// <summary>
+        /// Determines whether the value of a system factor might change while
+        /// the programme is running.
+        /// </summary>
+        enum class volatility {
+
+            /// <summary>
+            /// The factor is retrieved once and then answered from the
+            /// snapshot of the system factors.
+            /// </summary>
+            constant,
+
+            /// <summary>
+            /// The factor is retrieved again whenever the system factors are
+            /// requested.
+            /// </summary>
+            variable
+        };
+
         /// <summary>
         /// Answer the only instance of this class.
         /// </summary>
@@ -50,6 +71,16 @@ namespace trrojan {
         /// </summary>
         static bool is_system_factor(const std::string& factor);
 
+        /// <summary>
+        /// Answer whether the value of the given system factor might change
+        /// while the programme is running.
+        /// </summary>
+        /// <remarks>
+        /// Factors that are not system factors are reported as
+        /// <see cref="volatility::variable" />.
+        /// </remarks>
+        static volatility get_volatility(const std::string& factor);
+
         /// <summary>
         /// Name of the built-in factor describing the BIOS.
         /// </summary>
@@ -65,6 +96,12 @@ namespace trrojan {
         /// </summary>
         static const std::string factor_cpu;
 
+        /// <summary>
+        /// Name of the built-in factor describing the data caches of the
+        /// CPU.
+        /// </summary>
+        static const std::string factor_cpu_caches;
+
         /// <summary>
         /// Name of the factor that indicates whether TRRojan was running as a
         /// debug build.
@@ -132,6 +169,18 @@ namespace trrojan {
         /// </summary>
         static const std::string factor_tdr_level;
 
+        /// <summary>
+        /// Name of the built-in factor describing the time a call to the
+        /// <see cref="trrojan::timer" /> takes in milliseconds.
+        /// </summary>
+        static const std::string factor_timer_overhead;
+
+        /// <summary>
+        /// Name of the built-in factor describing the smallest time in
+        /// milliseconds the <see cref="trrojan::timer" /> can resolve.
+        /// </summary>
+        static const std::string factor_timer_resolution;
+
         /// <summary>
         /// Gets a string representation of the current date and time.
         /// </summary>
@@ -148,6 +197,8 @@ namespace trrojan {
 
         variant cpu(void) const;
 
+        variant cpu_caches(void) const;
+
         variant debug_build(void) const;
 
         variant gaming_device(void) const;
@@ -157,9 +208,14 @@ namespace trrojan {
         /// <summary>
         /// Answer all system factors.
         /// </summary>
+        /// <remarks>
+        /// Only the factors classified as <see cref="volatility::variable" />
+        /// are retrieved on each call. All others are taken from a snapshot
+        /// that is made on the first call.
+        /// </remarks>
         template<class I> inline void get(I oit) const {
-            for (auto r : system_factors::get_retrievers()) {
-                *oit++ = named_variant(r.first, (this->*(r.second))());
+            for (auto& f : this->snapshot()) {
+                *oit++ = f;
             }
         }
 
@@ -195,6 +251,10 @@ namespace trrojan {
 #endif  /* defined(TRROJAN_FOR_UWP) */
         }
 
+        variant timer_overhead(void) const;
+
+        variant timer_resolution(void) const;
+
         variant timestamp(void) const;
 
         variant user_name(void) const;
@@ -208,13 +268,48 @@ namespace trrojan {
 
         system_factors(const system_factors&) = delete;
 
+        /// <summary>
+        /// Answer the values of all system factors, updating the variable
+        /// ones and retrieving all of them on the first call.
+        /// </summary>
+        std::vector<named_variant> snapshot(void) const;
+
         system_factors& operator =(const system_factors&) = delete;
 
+        /// <summary>
+        /// Retrieves all system factors into <see cref="_snapshot" />.
+        /// </summary>
+        /// <remarks>
+        /// The caller must hold <see cref="_snapshot_lock" />.
+        /// </remarks>
+        void take_snapshot(void) const;
+
 #if !defined(TRROJAN_FOR_UWP)
         sysinfo::hardware_info hwinfo;
         sysinfo::os_info osinfo;
         sysinfo::smbios_information smbios;
 #endif /* !defined(TRROJAN_FOR_UWP) */
 
+        /// <summary>
+        /// The most recent values of all system factors.
+        /// </summary>
+        mutable std::vector<named_variant> _snapshot;
+
+        /// <summary>
+        /// The indices of all factors in <see cref="_snapshot" /> by their
+        /// name.
+        /// </summary>
+        mutable std::unordered_map<std::string, std::size_t> _snapshot_indices;
+
+        /// <summary>
+        /// Serialises the updates of <see cref="_snapshot" />.
+        /// </summary>
+        mutable std::mutex _snapshot_lock;
+
+        /// <summary>
+        /// The indices of the variable factors in <see cref="_snapshot" />.
+        /// </summary>
+        mutable std::vector<std::size_t> _variable_factors;
+
     };
 }
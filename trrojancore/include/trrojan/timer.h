@@ -17,12 +17,31 @@
 #include <Windows.h>
 #endif /* _WIN32 */
 
+#if (defined(TRROJAN_WITH_TSC_CLOCK) && (defined(_M_X64) || defined(_M_IX86) \
+    || defined(__x86_64__) || defined(__i386__)))
+#define TRROJAN_TSC_CLOCK
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else /* defined(_MSC_VER) */
+#include <x86intrin.h>
+#endif /* defined(_MSC_VER) */
+#endif /* (defined(TRROJAN_WITH_TSC_CLOCK) && ... */
+
 
 namespace trrojan {
 
     /// <summary>
     /// A utility class for measuring wall clock times.
     /// </summary>
+    /// <remarks>
+    /// <para>The timer uses the performance counter on Windows and
+    /// <c>std::chrono::high_resolution_clock</c> on all other platforms. If
+    /// TRRojan is built with <c>TRROJAN_WITH_TSC_CLOCK</c> for x86, the
+    /// time-stamp counter is read via <c>rdtscp</c> instead, which is only
+    /// reliable if the processor has an invariant TSC.</para>
+    /// <para>The overhead of reading the clock and its resolution can be
+    /// determined once using <see cref="timer::calibrate" />.</para>
+    /// </remarks>
     class TRROJANCORE_API timer {
 
     public:
@@ -30,7 +49,8 @@ namespace trrojan {
         /// <summary>
         /// Represents the difference between two points in time.
         /// </summary>
-#if (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK))
+#if (defined(TRROJAN_TSC_CLOCK) \
+    || (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK)))
         typedef std::int64_t difference_type;
 #else /* (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK)) */
         typedef std::chrono::high_resolution_clock::duration difference_type;
@@ -44,7 +64,8 @@ namespace trrojan {
         /// <summary>
         /// Represents a point in time.
         /// </summary>
-#if (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK))
+#if (defined(TRROJAN_TSC_CLOCK) \
+    || (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK)))
         typedef std::uint64_t value_type;
 #else /* (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK)) */
         typedef std::chrono::high_resolution_clock::time_point value_type;
@@ -55,7 +76,12 @@ namespace trrojan {
         /// </summary>
         /// <returns>The current timer value.</returns>
         static inline value_type now(void) {
-#if (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK))
+#if defined(TRROJAN_TSC_CLOCK)
+            // rdtscp waits for all previous instructions to complete, which
+            // prevents the measured code from being reordered across it.
+            unsigned int aux;
+            return __rdtscp(&aux);
+#elif (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK))
             LARGE_INTEGER retval;
             if (::QueryPerformanceCounter(&retval)) {
                 return retval.QuadPart;
@@ -69,6 +95,50 @@ namespace trrojan {
 #endif /* (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK)) */
         }
 
+        /// <summary>
+        /// The properties of the clock determined by
+        /// <see cref="timer::calibrate" />.
+        /// </summary>
+        struct calibration {
+
+            /// <summary>
+            /// The average time a call to <see cref="timer::now" /> takes in
+            /// milliseconds.
+            /// </summary>
+            millis_type overhead;
+
+            /// <summary>
+            /// The smallest non-zero difference between two consecutive
+            /// values of <see cref="timer::now" /> in milliseconds.
+            /// </summary>
+            millis_type resolution;
+
+            /// <summary>
+            /// Indicates whether the processor has an invariant time-stamp
+            /// counter, which ticks at a constant rate regardless of the
+            /// power state of the cores.
+            /// </summary>
+            bool invariant_tsc;
+        };
+
+        /// <summary>
+        /// Determines the overhead and the resolution of the clock.
+        /// </summary>
+        /// <remarks>
+        /// The calibration is performed only once on the first call. It
+        /// takes a few milliseconds and should therefore be triggered before
+        /// measuring anything.
+        /// </remarks>
+        /// <returns>The properties of the clock.</returns>
+        static const calibration& calibrate(void);
+
+        /// <summary>
+        /// Answer whether the processor has an invariant time-stamp counter.
+        /// </summary>
+        /// <returns><c>true</c> if the TSC is invariant, <c>false</c> if it
+        /// is not or if this cannot be determined on the platform.</returns>
+        static bool has_invariant_tsc(void);
+
         /// <summary>
         /// Converts a point in time to milliseconds since the epoch.
         /// </summary>
@@ -83,6 +153,31 @@ namespace trrojan {
         /// <returns>The value as milliseconds</returns>
         static millis_type to_millis(const difference_type value);
 
+        /// <summary>
+        /// Subtracts the calibrated overhead of reading the clock from a
+        /// measured duration.
+        /// </summary>
+        /// <remarks>
+        /// A duration measured by a <see cref="timer" /> includes the time
+        /// of one call to <see cref="timer::now" />, which is not negligible
+        /// for very short measurements.
+        /// </remarks>
+        /// <param name="value">The measured duration in milliseconds.</param>
+        /// <returns>The duration without the overhead, which is never
+        /// negative.</returns>
+        static inline millis_type subtract_overhead(const millis_type value) {
+            auto retval = value - timer::calibrate().overhead;
+            return (retval > 0) ? retval : static_cast<millis_type>(0);
+        }
+
+#if defined(TRROJAN_TSC_CLOCK)
+        /// <summary>
+        /// Answer the number of ticks of the time-stamp counter per
+        /// millisecond, which is measured against the steady clock once.
+        /// </summary>
+        static millis_type tsc_frequency(void);
+#endif /* defined(TRROJAN_TSC_CLOCK) */
+
         /// <summary>
         /// Initialises a new instance.
         /// </summary>
@@ -94,7 +94,11 @@ bool trrojan::benchmark_base::can_run(environment env,
 /*
  * trrojan::benchmark_base::optimise_order
  */
-void trrojan::benchmark_base::optimise_order(configuration_set& inOutConfs) { }
+void trrojan::benchmark_base::optimise_order(configuration_set& inOutConfs) {
+    if (!this->_switch_costs.empty()) {
+        inOutConfs.optimise_order(this->_switch_costs);
+    }
+}
 
 
 /*
@@ -127,21 +131,42 @@ size_t trrojan::benchmark_base::run(const configuration_set& configs,
     auto c = configs;
     c.merge(this->_default_configs, false);
 
-    // Invoke each configuration.
+    // The default factors have been appended after the executive optimised
+    // the order, so the costs must be applied to the merged set once more.
+    if (!this->_switch_costs.empty()) {
+        c.optimise_order(this->_switch_costs);
+    }
+
+    // Invoke each configuration. The ones before 'continue_at' are not even
+    // enumerated, because the configuration set can jump directly to it.
     cool_down_evaluator cde(coolDown);
-    size_t retval = 0;
+    auto journal = c.selected_journal();
+    size_t retval = (std::min)(continue_at, c.count_configurations());
     c.foreach_configuration([&](configuration& c) -> bool {
         try {
+            if ((journal != nullptr) && journal->contains(this->name(), c)) {
+                ++retval;
+                log::instance().write_line(log_level::verbose, "Skipping "
+                    "configuration #{0}, which the journal records as "
+                    "completed.", retval);
+                return true;
+            }
+
             auto e = c.get<trrojan::environment>(environment_base::factor_name);
             auto d = c.get<trrojan::device>(device_base::factor_name);
 
             cde.check();
 
             if (this->can_run(e, d)) {
-                if (retval >= continue_at) {
-                    c.add_system_factors();
-                    this->log_run(c);
-                    auto r = resultCallback(std::move(this->run(c)));
+                c.add_system_factors();
+                for (auto& x : this->expand_configuration(c)) {
+                    this->log_run(x);
+                    resultCallback(std::move(this->run(x)));
+                }
+                if (journal != nullptr) {
+                    // Record the configuration only after the result has been
+                    // written, such that it is repeated if we crash before.
+                    journal->append(this->name(), c);
                 }
                 ++retval;
                 log::instance().write_line(log_level::information, "Completed "
@@ -151,6 +176,7 @@ size_t trrojan::benchmark_base::run(const configuration_set& configs,
                 log::instance().write_line(log_level::information, "A "
                     "benchmark cannot run with the specified combination of "
                     "environment and device. Skipping it ...");
+                ++retval;
                 return true;
             }
 
@@ -169,7 +195,7 @@ size_t trrojan::benchmark_base::run(const configuration_set& configs,
                 "exception was encountered while running a benchmark.");
             return false;
         }
-    });
+    }, continue_at);
 
     log::instance().write_line(log_level::information, "Completed benchmarking "
         "of {0} individual configuration(s). ", retval);
@@ -258,6 +284,15 @@ void trrojan::benchmark_base::check_required_factors(
 }
 
 
+/*
+ * trrojan::benchmark_base::expand_configuration
+ */
+std::vector<trrojan::configuration>
+trrojan::benchmark_base::expand_configuration(const trrojan::configuration& c) {
+    return std::vector<trrojan::configuration> { c };
+}
+
+
 /*
  * trrojan::benchmark_base::log_run
  */
@@ -7,7 +7,9 @@
 
 #include "trrojan/configuration_set.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <stdexcept>
 
 #include "trrojan/log.h"
@@ -53,6 +55,36 @@ void trrojan::configuration_set::replace_factor(const factor& factor) {
     }
 }
 
+/*
+ * trrojan::configuration_set::estimate_switch_cost
+ */
+double trrojan::configuration_set::estimate_switch_cost(
+        const switch_cost_map& costs) const {
+    double retval = 0.0;
+    size_t cntOuter = 1;
+
+    // Iterate from the most significant factor, which changes at the lowest
+    // rate, and count the configurations formed by the factors before.
+    for (auto it = this->_factors.rbegin(); it != this->_factors.rend(); ++it) {
+        const auto n = it->size();
+        const auto c = costs.find(it->name());
+
+        if ((n > 1) && (c != costs.end())) {
+            // In lexicographic order, the factor also changes when it wraps
+            // around, which the reflected order avoids.
+            auto cntChanges = this->_is_reflected
+                ? (n - 1) * cntOuter
+                : n * cntOuter - 1;
+            retval += c->second * static_cast<double>(cntChanges);
+        }
+
+        cntOuter *= n;
+    }
+
+    return retval;
+}
+
+
 /*
  * trrojan::configuration_set::find_factor
  */
@@ -63,36 +95,98 @@ const trrojan::factor *trrojan::configuration_set::find_factor(
 }
 
 
+/*
+ * trrojan::configuration_set::count_configurations
+ */
+size_t trrojan::configuration_set::count_configurations(void) const {
+    size_t retval = this->_factors.empty() ? 0 : 1;
+
+    for (auto& f : this->_factors) {
+        retval *= f.size();
+    }
+
+    return retval;
+}
+
+
 /*
  * trrojan::configuration_set::foreach_configuration
  */
 bool trrojan::configuration_set::foreach_configuration(
-        std::function<bool(configuration&)> cb) const {
+        std::function<bool(configuration&)> cb, const size_t first) const {
     bool retval = true;
 
     if (!this->_factors.empty() && cb) {
-        size_t cntTests = 1;
+        const auto cntTests = this->count_configurations();
         configuration config;
-        std::vector<size_t> frequencies;
-
-        config.reserve(this->_factors.size());
-        for (auto& f : this->_factors) {
-            frequencies.push_back(cntTests);
-            cntTests *= f.size();
-        }
 
         log::instance().write_line(log_level::information, "The configuration "
             "set comprises {0} individual configuration(s).", cntTests);
+        if (first > 0) {
+            log::instance().write_line(log_level::information, "Skipping the "
+                "first {0} configuration(s).", first);
+        }
+
+        if (this->_shard.enabled()) {
+            const auto cntGroups = this->count_affinity_groups();
+            const auto cntShards = this->_shard.count;
+            const auto idxShard = this->_shard.index;
+
+            log::instance().write_line(log_level::information, "Running shard "
+                "{0} of {1}.", idxShard, cntShards);
 
-        for (size_t i = 0; (i < cntTests) && retval; ++i) {
-            config.clear();
-            for (size_t j = 0; j < this->_factors.size(); ++j) {
-                auto& f = this->_factors[j];
-                auto ij = (i / frequencies[j]) % f.size();
-                config.add(this->_factors[j].name(),
-                    std::move(this->_factors[j][ij]));
+            auto visit = [&](const size_t i) {
+                this->get_configuration(i, config);
+                config.add(shard::entry_factor_name,
+                    static_cast<std::uint64_t>(this->_shard.entry));
+                config.add(shard::factor_name,
+                    static_cast<std::uint64_t>(i));
+                return cb(config);
+            };
+
+            if (cntGroups < cntShards) {
+                if (cntGroups > 0) {
+                    log::instance().write_line(log_level::warning, "The "
+                        "affinity factors only form {0} group(s) of "
+                        "configurations, which is less than the number of "
+                        "shards. The configurations are therefore distributed "
+                        "individually.", cntGroups);
+                }
+
+                // The shard owns all i with i * cntShards / cntTests being its
+                // index, which is a single contiguous range.
+                auto begin = (idxShard * cntTests + cntShards - 1) / cntShards;
+                auto end = ((idxShard + 1) * cntTests + cntShards - 1)
+                    / cntShards;
+                for (auto i = (std::max)(begin, first); (i < end) && retval;
+                        ++i) {
+                    retval = visit(i);
+                }
+
+            } else {
+                // All configurations in a block share their affinity group, so
+                // the group only needs to be determined once per block and the
+                // blocks of the other shards can be skipped as a whole.
+                const auto cntBlock = this->count_affinity_block();
+                for (auto b = first - first % cntBlock;
+                        (b < cntTests) && retval; b += cntBlock) {
+                    auto group = this->affinity_group(b);
+                    if (group * cntShards / cntGroups != idxShard) {
+                        continue;
+                    }
+
+                    for (auto i = (std::max)(b, first);
+                            (i < b + cntBlock) && retval; ++i) {
+                        retval = visit(i);
+                    }
+                }
+            }
+
+        } else {
+            for (size_t i = first; (i < cntTests) && retval; ++i) {
+                this->get_configuration(i, config);
+                retval = cb(config);
             }
-            retval = cb(config);
         }
     } /* end if (!this->factors.empty()) */
 
@@ -100,6 +194,48 @@ bool trrojan::configuration_set::foreach_configuration(
 }
 
 
+/*
+ * trrojan::configuration_set::get_configuration
+ */
+void trrojan::configuration_set::get_configuration(const size_t i,
+        configuration& dst) const {
+    const auto cntFactors = this->_factors.size();
+
+    if (i >= this->count_configurations()) {
+        throw std::out_of_range("The configuration index is out of range.");
+    }
+
+    // If the configuration already holds our factors, keep their names and
+    // only replace the values, which saves us from copying all names for
+    // every configuration.
+    auto isReusable = (dst.size() >= cntFactors);
+    for (size_t j = 0; isReusable && (j < cntFactors); ++j) {
+        isReusable = (dst[j].name() == this->_factors[j].name());
+    }
+
+    if (isReusable) {
+        dst.truncate(cntFactors);
+    } else {
+        dst.clear();
+        dst.reserve(cntFactors);
+    }
+
+    // The index is a mixed-radix number with the manifestations of the first
+    // factor as the least significant digit.
+    auto r = i;
+    for (size_t j = 0; j < cntFactors; ++j) {
+        auto& f = this->_factors[j];
+        auto ij = this->next_manifestation(r, f);
+
+        if (isReusable) {
+            dst.replace_value(j, f[ij]);
+        } else {
+            dst.add(f.name(), f[ij]);
+        }
+    }
+}
+
+
 /*
  * trrojan::configuration_set::merge
  */
@@ -139,3 +275,120 @@ void trrojan::configuration_set::optimise_order(
         }
     }
 }
+
+
+/*
+ * trrojan::configuration_set::optimise_order
+ */
+void trrojan::configuration_set::optimise_order(const switch_cost_map& costs) {
+    auto cost = [&costs](const factor& f) {
+        auto it = costs.find(f.name());
+        return (it != costs.end()) ? it->second : 0.0;
+    };
+
+    const auto before = this->estimate_switch_cost(costs);
+
+    // Note: We sort indices and copy the factors, because the factors must
+    // not be swapped (cf. the other overload).
+    std::vector<size_t> order(this->_factors.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t l, size_t r) {
+        return (cost(this->_factors[l]) < cost(this->_factors[r]));
+    });
+
+    factor_list factors;
+    factors.reserve(this->_factors.size());
+    for (auto i : order) {
+        factors.push_back(this->_factors[i]);
+    }
+
+    this->_factors = std::move(factors);
+    this->_is_reflected = true;
+
+    log::instance().write_line(log_level::verbose, "Reordering the factors "
+        "reduced the estimated cost of switching between configurations from "
+        "{0} to {1}.", before, this->estimate_switch_cost(costs));
+}
+
+
+/*
+ * trrojan::configuration_set::shard_of
+ */
+size_t trrojan::configuration_set::shard_of(const size_t i) const {
+    const auto cntTests = this->count_configurations();
+    const auto cntGroups = this->count_affinity_groups();
+    const auto cntShards = this->_shard.count;
+
+    if (i >= cntTests) {
+        throw std::out_of_range("The configuration index is out of range.");
+    }
+
+    if (cntGroups < cntShards) {
+        // Distribute contiguous blocks of configurations, because each of
+        // them might be a group on its own.
+        return i * cntShards / cntTests;
+    }
+
+    // Distribute contiguous blocks of the groups.
+    return this->affinity_group(i) * cntShards / cntGroups;
+}
+
+
+/*
+ * trrojan::configuration_set::affinity_group
+ */
+size_t trrojan::configuration_set::affinity_group(const size_t i) const {
+    // Find the index of the combination of the affinity factors using the
+    // same mixed-radix decoding as get_configuration.
+    size_t retval = 0;
+    size_t radix = 1;
+    auto r = i;
+
+    for (auto& f : this->_factors) {
+        auto ij = this->next_manifestation(r, f);
+
+        if (this->is_affinity_factor(f)) {
+            retval += ij * radix;
+            radix *= f.size();
+        }
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::configuration_set::count_affinity_block
+ */
+size_t trrojan::configuration_set::count_affinity_block(void) const {
+    size_t retval = 1;
+
+    // The manifestations of the affinity factors only depend on the digits
+    // from the least significant affinity factor upwards, so the
+    // configurations are grouped in blocks of the product of the sizes of
+    // all factors before it.
+    for (auto& f : this->_factors) {
+        if (this->is_affinity_factor(f)) {
+            break;
+        }
+        retval *= f.size();
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::configuration_set::count_affinity_groups
+ */
+size_t trrojan::configuration_set::count_affinity_groups(void) const {
+    size_t retval = 0;
+
+    for (auto& f : this->_factors) {
+        if (this->is_affinity_factor(f)) {
+            retval = (std::max)(retval, static_cast<size_t>(1)) * f.size();
+        }
+    }
+
+    return retval;
+}
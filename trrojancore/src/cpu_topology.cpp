@@ -0,0 +1,403 @@
+﻿// <copyright file="cpu_topology.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "trrojan/cpu_topology.h"
+
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else /* defined(_WIN32) */
+#include <sched.h>
+#endif /* defined(_WIN32) */
+
+#include "trrojan/log.h"
+
+
+#if !defined(_WIN32)
+namespace {
+
+    /// <summary>
+    /// Reads the first line of a (sysfs) file, which is empty if the file
+    /// could not be read.
+    /// </summary>
+    std::string read_sysfs_line(const std::string& path) {
+        std::ifstream stream(path);
+        std::string retval;
+        std::getline(stream, retval);
+        return retval;
+    }
+
+    /// <summary>
+    /// Parses a Linux CPU list like &quot;0-3,8-11&quot;.
+    /// </summary>
+    std::vector<std::uint32_t> parse_cpu_list(const std::string& list) {
+        std::vector<std::uint32_t> retval;
+        std::stringstream stream(list);
+        std::string range;
+
+        while (std::getline(stream, range, ',')) {
+            if (range.empty()) {
+                continue;
+            }
+
+            auto dash = range.find('-');
+            auto begin = std::stoul(range.substr(0, dash));
+            auto end = (dash == std::string::npos)
+                ? begin
+                : std::stoul(range.substr(dash + 1));
+
+            for (auto i = begin; i <= end; ++i) {
+                retval.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+
+        return retval;
+    }
+}
+#endif /* !defined(_WIN32) */
+
+
+/*
+ * trrojan::cpu_topology::collect
+ */
+trrojan::cpu_topology trrojan::cpu_topology::collect(void) {
+    cpu_topology retval;
+
+#if defined(_WIN32)
+    DWORD size = 0;
+    ::GetLogicalProcessorInformationEx(RelationAll, nullptr, &size);
+    std::vector<std::uint8_t> buffer(size);
+    auto info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(
+        buffer.data());
+
+    if ((size > 0) && ::GetLogicalProcessorInformationEx(RelationAll, info,
+            &size)) {
+        std::map<std::uint32_t, std::uint32_t> nodes;
+        std::map<std::uint32_t, std::uint32_t> packages;
+        std::uint32_t cntCores = 0;
+        std::uint32_t cntPackages = 0;
+
+        for (DWORD o = 0; o < size; o += info->Size) {
+            info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(
+                buffer.data() + o);
+
+            switch (info->Relationship) {
+                case RelationProcessorCore: {
+                    auto& gm = info->Processor.GroupMask[0];
+                    for (BYTE i = 0; i < sizeof(gm.Mask) * CHAR_BIT; ++i) {
+                        if ((gm.Mask & (static_cast<KAFFINITY>(1) << i)) != 0) {
+                            logical_processor p;
+                            p.group = gm.Group;
+                            p.number = i;
+                            p.id = p.group * 64 + p.number;
+                            p.package = 0;
+                            p.core = cntCores;
+                            p.smt = 0;
+                            p.node = 0;
+                            retval._processors.push_back(p);
+                        }
+                    }
+                    ++cntCores;
+                    } break;
+
+                case RelationNumaNode: {
+                    auto& gm = info->NumaNode.GroupMask;
+                    for (BYTE i = 0; i < sizeof(gm.Mask) * CHAR_BIT; ++i) {
+                        if ((gm.Mask & (static_cast<KAFFINITY>(1) << i)) != 0) {
+                            nodes[gm.Group * 64 + i]
+                                = info->NumaNode.NodeNumber;
+                        }
+                    }
+                    } break;
+
+                case RelationCache: {
+                    // Remember the first cache of each level that the first
+                    // processor uses for data.
+                    auto& c = info->Cache;
+                    if ((c.Type != CacheData) && (c.Type != CacheUnified)) {
+                        break;
+                    }
+                    if ((c.GroupMask.Group != 0)
+                            || ((c.GroupMask.Mask & 1) == 0)) {
+                        break;
+                    }
+
+                    cache entry;
+                    entry.level = c.Level;
+                    entry.size = c.CacheSize;
+                    entry.line_size = c.LineSize;
+                    entry.sharing = 0;
+                    for (BYTE i = 0; i < sizeof(c.GroupMask.Mask) * CHAR_BIT;
+                            ++i) {
+                        if ((c.GroupMask.Mask & (static_cast<KAFFINITY>(1)
+                                << i)) != 0) {
+                            ++entry.sharing;
+                        }
+                    }
+                    retval._caches.push_back(entry);
+                    } break;
+
+                case RelationProcessorPackage:
+                    for (WORD g = 0; g < info->Processor.GroupCount; ++g) {
+                        auto& gm = info->Processor.GroupMask[g];
+                        for (BYTE i = 0; i < sizeof(gm.Mask) * CHAR_BIT; ++i) {
+                            if ((gm.Mask & (static_cast<KAFFINITY>(1) << i))
+                                    != 0) {
+                                packages[gm.Group * 64 + i] = cntPackages;
+                            }
+                        }
+                    }
+                    ++cntPackages;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        for (auto& p : retval._processors) {
+            auto it = packages.find(p.id);
+            if (it != packages.end()) {
+                p.package = it->second;
+            }
+
+            it = nodes.find(p.id);
+            if (it != nodes.end()) {
+                p.node = it->second;
+            }
+        }
+
+    } else {
+        log::instance().write(log_level::warning, "The processor topology "
+            "could not be retrieved (error {}).\n", ::GetLastError());
+    }
+
+#else /* defined(_WIN32) */
+    static const std::string root("/sys/devices/system/cpu/");
+    static const std::string nodeRoot("/sys/devices/system/node/");
+    auto online = parse_cpu_list(read_sysfs_line(root + "online"));
+    std::map<std::uint32_t, std::uint32_t> nodes;
+
+    // Only consider the processors the process is allowed to run on, which
+    // excludes the ones removed by taskset or by the cpuset of a container.
+    {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (::sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+            online.erase(std::remove_if(online.begin(), online.end(),
+                [&allowed](const std::uint32_t id) {
+                    return ((id >= CPU_SETSIZE) || !CPU_ISSET(id, &allowed));
+                }), online.end());
+        } else {
+            log::instance().write(log_level::warning, "The affinity mask of "
+                "the process could not be retrieved. All online processors "
+                "are considered available.\n");
+        }
+    }
+
+    for (auto n : parse_cpu_list(read_sysfs_line(nodeRoot + "online"))) {
+        auto path = nodeRoot + "node" + std::to_string(n) + "/cpulist";
+        for (auto id : parse_cpu_list(read_sysfs_line(path))) {
+            nodes[id] = n;
+        }
+    }
+
+    for (auto id : online) {
+        auto dir = root + "cpu" + std::to_string(id) + "/topology/";
+        auto package = read_sysfs_line(dir + "physical_package_id");
+        auto core = read_sysfs_line(dir + "core_id");
+
+        logical_processor p;
+        p.id = id;
+        p.group = static_cast<std::uint16_t>(id / 64);
+        p.number = static_cast<std::uint8_t>(id % 64);
+        try {
+            p.package = package.empty() ? 0 : std::stoul(package);
+            p.core = core.empty() ? id : std::stoul(core);
+        } catch (...) {
+            p.package = 0;
+            p.core = id;
+        }
+        p.smt = 0;
+
+        auto it = nodes.find(id);
+        p.node = (it != nodes.end()) ? it->second : 0;
+
+        retval._processors.push_back(p);
+    }
+
+    if (!online.empty()) {
+        auto dir = root + "cpu" + std::to_string(online.front()) + "/cache/";
+
+        for (std::uint32_t i = 0;; ++i) {
+            auto index = dir + "index" + std::to_string(i) + "/";
+            auto level = read_sysfs_line(index + "level");
+            if (level.empty()) {
+                break;
+            }
+
+            auto type = read_sysfs_line(index + "type");
+            if ((type != "Data") && (type != "Unified")) {
+                continue;
+            }
+
+            try {
+                // The size is given in KiB with a unit like "48K".
+                auto size = read_sysfs_line(index + "size");
+                std::size_t end = 0;
+                cache entry;
+                entry.level = std::stoul(level);
+                entry.size = std::stoull(size, &end);
+                switch ((end < size.size()) ? size[end] : 'K') {
+                    case 'M': entry.size *= 1024 * 1024; break;
+                    case 'G': entry.size *= 1024 * 1024 * 1024; break;
+                    default: entry.size *= 1024; break;
+                }
+                auto line = read_sysfs_line(index + "coherency_line_size");
+                entry.line_size = line.empty() ? 64 : std::stoull(line);
+                entry.sharing = static_cast<std::uint32_t>(parse_cpu_list(
+                    read_sysfs_line(index + "shared_cpu_list")).size());
+                retval._caches.push_back(entry);
+            } catch (...) {
+                log::instance().write(log_level::warning, "The description of "
+                    "cache {} is invalid and will be ignored.\n", index);
+            }
+        }
+    }
+#endif /* defined(_WIN32) */
+
+    std::sort(retval._caches.begin(), retval._caches.end(),
+        [](const cache& l, const cache& r) {
+            return (l.level < r.level);
+        });
+    for (auto& c : retval._caches) {
+        if (c.sharing < 1) {
+            c.sharing = 1;
+        }
+    }
+
+    if (retval._processors.empty()) {
+        auto cnt = (std::max)(std::thread::hardware_concurrency(), 1u);
+        log::instance().write(log_level::warning, "No processor topology is "
+            "available. Assuming {} independent cores in a single package.\n",
+            cnt);
+
+        for (std::uint32_t i = 0; i < cnt; ++i) {
+            logical_processor p;
+            p.id = i;
+            p.group = static_cast<std::uint16_t>(i / 64);
+            p.number = static_cast<std::uint8_t>(i % 64);
+            p.package = 0;
+            p.core = i;
+            p.smt = 0;
+            p.node = 0;
+            retval._processors.push_back(p);
+        }
+    }
+
+    retval.normalise();
+    return retval;
+}
+
+
+/*
+ * trrojan::cpu_topology::instance
+ */
+const trrojan::cpu_topology& trrojan::cpu_topology::instance(void) {
+    static const cpu_topology instance = cpu_topology::collect();
+    return instance;
+}
+
+
+/*
+ * trrojan::cpu_topology::packages
+ */
+std::size_t trrojan::cpu_topology::packages(void) const {
+    std::set<std::uint32_t> retval;
+    for (auto& p : this->_processors) {
+        retval.insert(p.package);
+    }
+    return retval.size();
+}
+
+
+/*
+ * trrojan::cpu_topology::numa_nodes
+ */
+std::vector<std::uint32_t> trrojan::cpu_topology::numa_nodes(void) const {
+    std::set<std::uint32_t> nodes;
+    for (auto& p : this->_processors) {
+        nodes.insert(p.node);
+    }
+    return std::vector<std::uint32_t>(nodes.begin(), nodes.end());
+}
+
+
+/*
+ * trrojan::cpu_topology::physical_cores
+ */
+std::size_t trrojan::cpu_topology::physical_cores(void) const {
+    std::set<std::uint32_t> retval;
+    for (auto& p : this->_processors) {
+        retval.insert(p.core);
+    }
+    return retval.size();
+}
+
+
+/*
+ * trrojan::cpu_topology::normalise
+ */
+void trrojan::cpu_topology::normalise(void) {
+    typedef std::pair<std::uint32_t, std::uint32_t> core_key;
+    std::map<std::uint32_t, std::uint32_t> packages;
+    std::map<core_key, std::uint32_t> cores;
+    std::map<core_key, std::uint32_t> siblings;
+
+    std::sort(this->_processors.begin(), this->_processors.end(),
+        [](const logical_processor& l, const logical_processor& r) {
+            return (l.id < r.id);
+        });
+
+    // Core IDs reported by the OS are only unique within a package and may
+    // have gaps, so we use the combination of both to assign dense indices.
+    for (auto& p : this->_processors) {
+        packages.emplace(p.package, 0);
+        cores.emplace(core_key(p.package, p.core), 0);
+    }
+
+    {
+        std::uint32_t i = 0;
+        for (auto& p : packages) {
+            p.second = i++;
+        }
+    }
+
+    {
+        std::uint32_t i = 0;
+        for (auto& c : cores) {
+            c.second = i++;
+        }
+    }
+
+    // As the processors are sorted by their ID, the SMT index is the number of
+    // processors on the same core we have seen before.
+    for (auto& p : this->_processors) {
+        core_key key(p.package, p.core);
+        p.smt = siblings[key]++;
+        p.core = cores[key];
+        p.package = packages[p.package];
+    }
+}
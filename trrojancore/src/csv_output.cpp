@@ -52,7 +52,8 @@ void trrojan::csv_output::open(const output_params& params) {
 
     // Note: We use the binary mode such that we can control the type of line
     // break being generated.
-    this->file.open(this->params->path(), std::ios::trunc | std::ios::binary);
+    auto mode = this->params->append() ? std::ios::app : std::ios::trunc;
+    this->file.open(this->params->path(), mode | std::ios::binary);
     if (!this->file) {
         std::stringstream msg;
         msg << "Failed to open output file \"" << this->params->path() << "\""
@@ -60,7 +61,9 @@ void trrojan::csv_output::open(const output_params& params) {
         throw std::runtime_error(msg.str());
     }
 
-    this->first_line = true;
+    // If we resume a previous run, the header has already been written.
+    this->file.seekp(0, std::ios::end);
+    this->first_line = (this->file.tellp() <= 0);
 }
 
 
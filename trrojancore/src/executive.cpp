@@ -324,11 +324,14 @@ void trrojan::executive::trroll(const troll_input_type& path,
         output_base& output,
         const cool_down& cool_down,
         const std::size_t continue_at,
-        power_collector::pointer power_collector) {
+        power_collector::pointer power_collector,
+        const trrojan::shard& shard,
+        const journal::pointer& journal) {
     typedef trroll_parser::benchmark_configs bcs;
     auto bcss = trroll_parser::parse(path);
     std::vector<benchmark> benchmarks;
     plugin curPlugin;
+    auto entryShard = shard;
 
     // Make sure that the benchmark configurations are grouped. This will ensure
     // that we are not repeatedly retrieving benchmarks from the plugins when
@@ -380,7 +383,11 @@ void trrojan::executive::trroll(const troll_input_type& path,
                     "benchmark \"{}\" from plugin \"{}\".\n",
                     b.benchmark.c_str(), b.plugin.c_str());
 
+                // Note: The shard must be selected after optimising the order,
+                // because the assignment depends on the enumeration.
                 (**it).optimise_order(b.configs);
+                b.configs.select_shard(entryShard);
+                b.configs.select_journal(journal);
                 this->run(*it, b.configs, output, cool_down, continue_at);
 
             } else {
@@ -389,6 +396,10 @@ void trrojan::executive::trroll(const troll_input_type& path,
                     "skipped.\n", b.benchmark.c_str(), b.plugin.c_str());
             }
         }
+
+        // The configuration indices restart for each entry, so the entries
+        // must be numbered for merging the results of the shards.
+        ++entryShard.entry;
     } /* end for (auto b : bcss) */
 }
 
@@ -0,0 +1,138 @@
+﻿// <copyright file="journal.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "trrojan/journal.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "trrojan/log.h"
+#include "trrojan/power_collector.h"
+#include "trrojan/shard.h"
+#include "trrojan/system_factors.h"
+
+
+namespace {
+
+    /// <summary>
+    /// Continues the 64-bit FNV-1a hash <paramref name="hash" /> with the
+    /// characters of <paramref name="str" />.
+    /// </summary>
+    std::uint64_t fnv1a(std::uint64_t hash, const std::string& str) {
+        for (auto c : str) {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= UINT64_C(1099511628211);
+        }
+        return hash;
+    }
+}
+
+
+/*
+ * trrojan::journal::hash
+ */
+std::uint64_t trrojan::journal::hash(const std::string& benchmark,
+        const configuration& config) {
+    std::vector<std::string> factors;
+    factors.reserve(config.size());
+
+    for (auto& f : config) {
+        if (!system_factors::is_system_factor(f.name())
+                && (f.name() != shard::entry_factor_name)
+                && (f.name() != shard::factor_name)
+                && (f.name() != power_collector::factor_name)) {
+            std::stringstream factor;
+            factor << f.name() << "=" << f.value();
+            factors.push_back(factor.str());
+        }
+    }
+
+    // Sort the factors such that the hash does not depend on their order in
+    // the configuration set.
+    std::sort(factors.begin(), factors.end());
+
+    auto retval = fnv1a(UINT64_C(14695981039346656037), benchmark);
+    for (auto& f : factors) {
+        retval = fnv1a(retval, "\n");
+        retval = fnv1a(retval, f);
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::journal::journal
+ */
+trrojan::journal::journal(const std::string& path) : _cnt_entries(0) {
+    {
+        std::ifstream file(path);
+        std::string line;
+
+        while (std::getline(file, line)) {
+            std::istringstream entry(line);
+            std::uint64_t hash;
+            std::size_t sequence;
+
+            if (entry >> std::hex >> hash >> std::dec >> sequence) {
+                this->_completed.insert(hash);
+                this->_cnt_entries = (std::max)(this->_cnt_entries,
+                    sequence + 1);
+            } else if (!line.empty()) {
+                // This is most likely the last line, which was being written
+                // when the process was terminated.
+                log::instance().write_line(log_level::warning, "Ignoring the "
+                    "malformed entry \"{}\" in the journal \"{}\".", line,
+                    path);
+            }
+        }
+    }
+
+    if (!this->_completed.empty()) {
+        log::instance().write_line(log_level::information, "The journal \"{}\" "
+            "records {} completed configuration(s), which will be skipped.",
+            path, this->_completed.size());
+    }
+
+    this->_file.open(path, std::ios::app);
+    if (!this->_file) {
+        std::stringstream msg;
+        msg << "Failed to open journal \"" << path << "\"" << std::ends;
+        throw std::runtime_error(msg.str());
+    }
+}
+
+
+/*
+ * trrojan::journal::append
+ */
+void trrojan::journal::append(const std::string& benchmark,
+        const configuration& config) {
+    auto hash = journal::hash(benchmark, config);
+
+    this->_file << std::hex << std::setw(16) << std::setfill('0') << hash
+        << std::dec << "\t" << this->_cnt_entries << "\t" << benchmark
+        << std::endl;
+    if (!this->_file) {
+        throw std::runtime_error("Failed to write to the journal.");
+    }
+
+    this->_completed.insert(hash);
+    ++this->_cnt_entries;
+}
+
+
+/*
+ * trrojan::journal::contains
+ */
+bool trrojan::journal::contains(const std::string& benchmark,
+        const configuration& config) const {
+    auto hash = journal::hash(benchmark, config);
+    return (this->_completed.find(hash) != this->_completed.end());
+}
@@ -6,6 +6,8 @@
 
 #include "trrojan/output.h"
 
+#include <stdexcept>
+
 #include "trrojan/console_output.h"
 #include "trrojan/console_output_params.h"
 #include "trrojan/csv_output.h"
@@ -112,6 +114,20 @@ trrojan::output trrojan::open_output(const trrojan::cmd_line& cmdLine) {
         params = console_output_params::create();
     }
 
+    // Only the CSV output can continue the results of a previous run, all
+    // other file-based outputs would be overwritten.
+    {
+        auto it = trrojan::find_argument("--resume", cmdLine.begin(),
+            cmdLine.end());
+        if ((it != cmdLine.end())
+                && (std::dynamic_pointer_cast<csv_output>(retval) == nullptr)
+                && (std::dynamic_pointer_cast<console_output>(retval)
+                == nullptr)) {
+            throw std::invalid_argument("Resuming a campaign requires the "
+                "output to be a CSV file.");
+        }
+    }
+
     retval->open(params);
 
     return retval;
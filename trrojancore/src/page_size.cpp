@@ -0,0 +1,288 @@
+﻿// <copyright file="page_size.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "trrojan/page_size.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else /* defined(_WIN32) */
+#include <sys/mman.h>
+#include <unistd.h>
+#endif /* defined(_WIN32) */
+
+#include "trrojan/log.h"
+
+
+namespace {
+
+    /// <summary>
+    /// The size of a 2 MiB page in bytes.
+    /// </summary>
+    const std::size_t size_2m = static_cast<std::size_t>(2) * 1024 * 1024;
+
+    /// <summary>
+    /// The size of a 1 GiB page in bytes.
+    /// </summary>
+    const std::size_t size_1g = static_cast<std::size_t>(1024) * 1024 * 1024;
+
+    /// <summary>
+    /// Writes to every regular page of the given range, which forces the
+    /// operating system to back it with physical memory.
+    /// </summary>
+    void touch(void *data, const std::size_t size) {
+        const auto step = trrojan::get_page_size(trrojan::page_size::regular);
+        auto d = static_cast<volatile std::uint8_t *>(data);
+        for (std::size_t o = 0; o < size; o += step) {
+            d[o] = 0;
+        }
+    }
+
+#if defined(_WIN32)
+    /// <summary>
+    /// Enables the privilege to lock pages in memory for the process, which
+    /// is required for large pages.
+    /// </summary>
+    bool enable_lock_memory_privilege(void) {
+        static const bool retval = [](void) {
+            HANDLE token = NULL;
+            TOKEN_PRIVILEGES privileges;
+
+            if (!::OpenProcessToken(::GetCurrentProcess(),
+                    TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+                return false;
+            }
+
+            privileges.PrivilegeCount = 1;
+            privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+            auto ok = ::LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME,
+                &privileges.Privileges[0].Luid);
+            ok = ok && ::AdjustTokenPrivileges(token, FALSE, &privileges, 0,
+                nullptr, nullptr);
+            // AdjustTokenPrivileges succeeds if the privilege is not held.
+            ok = ok && (::GetLastError() == ERROR_SUCCESS);
+
+            ::CloseHandle(token);
+            return (ok != FALSE);
+        }();
+        return retval;
+    }
+
+#else /* defined(_WIN32) */
+    /// <summary>
+    /// Maps anonymous memory using the given additional flags.
+    /// </summary>
+    inline void *map(const std::size_t size, const int flags) {
+        return ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    }
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * trrojan::allocate_pages
+ */
+void *trrojan::allocate_pages(const std::size_t size, const page_size pages,
+        const bool populate) {
+    const auto s = round_to_pages(size, pages);
+
+#if defined(_WIN32)
+    const auto flags = MEM_RESERVE | MEM_COMMIT;
+    void *retval = nullptr;
+
+    switch (pages) {
+        case page_size::huge_1g:
+            log::instance().write(log_level::warning, "1 GiB pages are not "
+                "supported on Windows. The minimum large page size will be "
+                "used.\n");
+            /* falls through. */
+
+        case page_size::huge_2m:
+            if (enable_lock_memory_privilege()) {
+                retval = ::VirtualAlloc(nullptr, s, flags | MEM_LARGE_PAGES,
+                    PAGE_READWRITE);
+            }
+            if (retval == nullptr) {
+                log::instance().write(log_level::warning, "Allocating large "
+                    "pages failed (error {}). Make sure that the user has the "
+                    "privilege to lock pages in memory. Regular pages will be "
+                    "used.\n", ::GetLastError());
+            }
+            break;
+
+        case page_size::transparent:
+            log::instance().write(log_level::warning, "Transparent huge pages "
+                "are not supported on Windows. Regular pages will be used.\n");
+            break;
+
+        default:
+            break;
+    }
+
+    if (retval == nullptr) {
+        retval = ::VirtualAlloc(nullptr, s, flags, PAGE_READWRITE);
+        if (retval == nullptr) {
+            std::error_code ec(::GetLastError(), std::system_category());
+            throw std::system_error(ec, "Failed to allocate pages.");
+        }
+
+        // Large pages are always resident, but committed regular pages are
+        // only backed by physical memory once they are touched.
+        if (populate) {
+            touch(retval, s);
+        }
+    }
+
+    return retval;
+
+#else /* defined(_WIN32) */
+    void *retval = MAP_FAILED;
+#if defined(MAP_POPULATE)
+    const int populateFlag = populate ? MAP_POPULATE : 0;
+#else /* defined(MAP_POPULATE) */
+    const int populateFlag = 0;
+#endif /* defined(MAP_POPULATE) */
+
+#if defined(MAP_HUGETLB)
+#if !defined(MAP_HUGE_SHIFT)
+#define MAP_HUGE_SHIFT (26)
+#endif /* !defined(MAP_HUGE_SHIFT) */
+    switch (pages) {
+        case page_size::huge_1g:
+            retval = map(s, MAP_HUGETLB | (30 << MAP_HUGE_SHIFT)
+                | populateFlag);
+            if (retval != MAP_FAILED) {
+                break;
+            } else {
+                auto error = errno;
+                log::instance().write(log_level::warning, "Mapping 1 GiB "
+                    "pages failed (error {}). 2 MiB pages will be tried "
+                    "instead.\n", error);
+            }
+            /* falls through. */
+
+        case page_size::huge_2m:
+            retval = map(s, MAP_HUGETLB | (21 << MAP_HUGE_SHIFT)
+                | populateFlag);
+            if (retval == MAP_FAILED) {
+                auto error = errno;
+                log::instance().write(log_level::warning, "Mapping 2 MiB "
+                    "pages failed (error {}). Make sure that huge pages have "
+                    "been reserved via /proc/sys/vm/nr_hugepages. Transparent "
+                    "huge pages will be requested instead.\n", error);
+            }
+            break;
+
+        default:
+            break;
+    }
+#endif /* defined(MAP_HUGETLB) */
+
+    if (retval == MAP_FAILED) {
+        // Transparent huge pages must be requested before the range is
+        // populated, so the flag is only used for regular pages here.
+        const auto isRegular = (pages == page_size::regular);
+        retval = map(s, isRegular ? populateFlag : 0);
+        if (retval == MAP_FAILED) {
+            std::error_code ec(errno, std::system_category());
+            throw std::system_error(ec, "Failed to map pages.");
+        }
+
+        if (pages != page_size::regular) {
+#if defined(MADV_HUGEPAGE)
+            if (::madvise(retval, s, MADV_HUGEPAGE) != 0) {
+                auto error = errno;
+                log::instance().write(log_level::warning, "Requesting "
+                    "transparent huge pages failed (error {}). Regular pages "
+                    "will be used.\n", error);
+            }
+#else /* defined(MADV_HUGEPAGE) */
+            log::instance().write(log_level::warning, "Transparent huge "
+                "pages are not supported on this platform. Regular pages will "
+                "be used.\n");
+#endif /* defined(MADV_HUGEPAGE) */
+        }
+
+        if (populate && (!isRegular || (populateFlag == 0))) {
+#if defined(MADV_POPULATE_WRITE)
+            if (::madvise(retval, s, MADV_POPULATE_WRITE) != 0) {
+                touch(retval, s);
+            }
+#else /* defined(MADV_POPULATE_WRITE) */
+            touch(retval, s);
+#endif /* defined(MADV_POPULATE_WRITE) */
+        }
+    }
+
+    return retval;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * trrojan::free_pages
+ */
+void trrojan::free_pages(void *data, const std::size_t size,
+        const page_size pages) noexcept {
+    if (data != nullptr) {
+#if defined(_WIN32)
+        ::VirtualFree(data, 0, MEM_RELEASE);
+#else /* defined(_WIN32) */
+        // Note: If the allocation fell back to smaller pages, the size is
+        // still a multiple of the smaller pages, so this is always valid.
+        ::munmap(data, round_to_pages(size, pages));
+#endif /* defined(_WIN32) */
+    }
+}
+
+
+/*
+ * trrojan::get_page_size
+ */
+std::size_t trrojan::get_page_size(const page_size pages) {
+#if defined(_WIN32)
+    switch (pages) {
+        case page_size::huge_2m:
+        case page_size::huge_1g: {
+            auto retval = ::GetLargePageMinimum();
+            return (retval > 0) ? retval : size_2m;
+            }
+
+        default: {
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+            return info.dwPageSize;
+            }
+    }
+
+#else /* defined(_WIN32) */
+    switch (pages) {
+        case page_size::transparent:
+        case page_size::huge_2m:
+            return size_2m;
+
+        case page_size::huge_1g:
+            return size_1g;
+
+        default:
+            return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    }
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * trrojan::round_to_pages
+ */
+std::size_t trrojan::round_to_pages(const std::size_t size,
+        const page_size pages) {
+    const auto p = get_page_size(pages);
+    return ((size + p - 1) / p) * p;
+}
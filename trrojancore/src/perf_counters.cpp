@@ -0,0 +1,455 @@
+﻿// <copyright file="perf_counters.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "trrojan/perf_counters.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif /* defined(__linux__) */
+
+#include "trrojan/log.h"
+
+
+namespace {
+
+#if defined(__linux__)
+    /// <summary>
+    /// The directory where the kernel publishes the available PMUs.
+    /// </summary>
+    const std::string pmu_directory("/sys/bus/event_source/devices/");
+
+    /// <summary>
+    /// The names of the memory controller events for reads and writes on
+    /// server (CAS counts) and client (data requests) processors.
+    /// </summary>
+    const char *imc_events[] = { "cas_count_read", "cas_count_write",
+        "data_reads", "data_writes" };
+
+    /// <summary>
+    /// Wraps the <c>perf_event_open</c> system call, which has no wrapper in
+    /// the C library.
+    /// </summary>
+    inline int perf_event_open(perf_event_attr& attr, const pid_t pid,
+            const int cpu, const int group, const unsigned long flags) {
+        return static_cast<int>(::syscall(SYS_perf_event_open, &attr, pid,
+            cpu, group, flags));
+    }
+
+    /// <summary>
+    /// Reads the first line of the given file or returns an empty string.
+    /// </summary>
+    std::string read_line(const std::string& path) {
+        std::ifstream file(path);
+        std::string retval;
+        std::getline(file, retval);
+        return retval;
+    }
+
+    /// <summary>
+    /// Parses a list of CPUs like &quot;0,18-19&quot; from a
+    /// <c>cpumask</c> file.
+    /// </summary>
+    std::vector<int> parse_cpu_list(const std::string& list) {
+        std::vector<int> retval;
+        std::stringstream stream(list);
+        std::string range;
+
+        while (std::getline(stream, range, ',')) {
+            auto dash = range.find('-');
+            try {
+                auto begin = std::stoi(range.substr(0, dash));
+                auto end = (dash == std::string::npos)
+                    ? begin
+                    : std::stoi(range.substr(dash + 1));
+                for (auto c = begin; c <= end; ++c) {
+                    retval.push_back(c);
+                }
+            } catch (...) {
+                /* Ignore malformed ranges. */
+            }
+        }
+
+        return retval;
+    }
+
+    /// <summary>
+    /// Translates a PMU event description like
+    /// &quot;event=0x04,umask=0x03&quot; into the <c>config</c> of the
+    /// event using the format descriptions of the PMU.
+    /// </summary>
+    /// <returns><c>true</c> if all terms could be translated.</returns>
+    bool parse_event(std::uint64_t& config, const std::string& pmu,
+            const std::string& event) {
+        std::stringstream stream(event);
+        std::string term;
+        config = 0;
+
+        while (std::getline(stream, term, ',')) {
+            auto eq = term.find('=');
+            auto name = term.substr(0, eq);
+            std::uint64_t value = 1;
+            if (eq != std::string::npos) {
+                value = std::stoull(term.substr(eq + 1), nullptr, 0);
+            }
+
+            // The format looks like "config:8-15" or "config:21".
+            auto format = read_line(pmu + "/format/" + name);
+            auto colon = format.find(':');
+            if ((colon == std::string::npos)
+                    || (format.substr(0, colon) != "config")) {
+                return false;
+            }
+
+            auto bits = format.substr(colon + 1);
+            auto dash = bits.find('-');
+            auto lo = std::stoi(bits.substr(0, dash));
+            auto hi = (dash == std::string::npos)
+                ? lo
+                : std::stoi(bits.substr(dash + 1));
+            auto mask = (hi - lo >= 63)
+                ? (std::numeric_limits<std::uint64_t>::max)()
+                : ((static_cast<std::uint64_t>(1) << (hi - lo + 1)) - 1);
+            config |= (value & mask) << lo;
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Answer the number of bytes represented by one count of the given
+    /// memory controller event.
+    /// </summary>
+    double parse_bytes_per_event(const std::string& event) {
+        auto scale = read_line(event + ".scale");
+        auto unit = read_line(event + ".unit");
+        auto retval = 64.0;
+
+        if (!scale.empty()) {
+            retval = std::stod(scale);
+            if (unit == "MiB") {
+                retval *= 1024.0 * 1024.0;
+            } else if (unit == "KiB") {
+                retval *= 1024.0;
+            }
+        }
+
+        return retval;
+    }
+#endif /* defined(__linux__) */
+
+}
+
+
+/*
+ * trrojan::perf_counter_group::append_result_names
+ */
+void trrojan::perf_counter_group::append_result_names(
+        basic_result::result_names_type& names, const values_type& values) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (values[i] != invalid_value) {
+            names.push_back(result_name(static_cast<perf_counter>(i)));
+        }
+    }
+}
+
+
+/*
+ * trrojan::perf_counter_group::append_results
+ */
+void trrojan::perf_counter_group::append_results(
+        basic_result::result_type& results, const values_type& values) {
+    append_results(results, values, values);
+}
+
+
+/*
+ * trrojan::perf_counter_group::append_results
+ */
+void trrojan::perf_counter_group::append_results(
+        basic_result::result_type& results, const values_type& values,
+        const values_type& columns) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (columns[i] != invalid_value) {
+            if (values[i] != invalid_value) {
+                results.emplace_back(values[i]);
+            } else {
+                results.emplace_back();
+            }
+        }
+    }
+}
+
+
+/*
+ * trrojan::perf_counter_group::accumulate
+ */
+void trrojan::perf_counter_group::accumulate(values_type& lhs,
+        const values_type& rhs) {
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (rhs[i] != invalid_value) {
+            lhs[i] = (lhs[i] == invalid_value) ? rhs[i] : lhs[i] + rhs[i];
+        }
+    }
+}
+
+
+/*
+ * trrojan::perf_counter_group::invalid_values
+ */
+trrojan::perf_counter_group::values_type
+trrojan::perf_counter_group::invalid_values(void) {
+    values_type retval;
+    retval.fill(invalid_value);
+    return retval;
+}
+
+
+/*
+ * trrojan::perf_counter_group::result_name
+ */
+const std::string& trrojan::perf_counter_group::result_name(
+        const perf_counter counter) {
+    static const std::array<std::string,
+        static_cast<std::size_t>(perf_counter::count)> names = {
+        "perf_cycles", "perf_instructions", "perf_llc_misses",
+        "perf_dtlb_misses", "perf_imc_bytes"
+    };
+    return names.at(static_cast<std::size_t>(counter));
+}
+
+
+/*
+ * trrojan::perf_counter_group::perf_counter_group
+ */
+trrojan::perf_counter_group::perf_counter_group(const bool uncore)
+        : _leader(-1) {
+#if defined(__linux__)
+    struct event_desc {
+        perf_counter counter;
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    static const event_desc core_events[] = {
+        { perf_counter::cycles, PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_CPU_CYCLES },
+        { perf_counter::instructions, PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_INSTRUCTIONS },
+        { perf_counter::llc_misses, PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_CACHE_MISSES },
+        { perf_counter::dtlb_misses, PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_DTLB
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) }
+    };
+
+    std::string missing;
+    int error = 0;
+
+    // Open the core events for the calling thread as one group, which is
+    // enabled and disabled via the leader.
+    for (auto& e : core_events) {
+        perf_event_attr attr;
+        ::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = e.type;
+        attr.config = e.config;
+        attr.disabled = (this->_leader < 0) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP
+            | PERF_FORMAT_TOTAL_TIME_ENABLED
+            | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        auto handle = perf_event_open(attr, 0, -1, this->_leader, 0);
+        if (handle < 0) {
+            error = errno;
+            missing += missing.empty() ? "" : ", ";
+            missing += result_name(e.counter);
+            continue;
+        }
+
+        if (this->_leader < 0) {
+            this->_leader = handle;
+        }
+        this->_handles.push_back(handle);
+        this->_members.push_back(e.counter);
+    }
+
+    if (!missing.empty()) {
+        log::instance().write(log_level::warning, "The performance counters "
+            "{} could not be opened (error {}). Check "
+            "/proc/sys/kernel/perf_event_paranoid if the counters should be "
+            "available.\n", missing, error);
+    }
+
+    // Open the memory controller events of all uncore PMUs. These count for
+    // a whole socket and must therefore be opened on one CPU of each socket
+    // as published in the cpumask of the PMU.
+    if (uncore) {
+        auto dir = ::opendir(pmu_directory.c_str());
+        if (dir != nullptr) {
+            for (auto e = ::readdir(dir); e != nullptr; e = ::readdir(dir)) {
+                std::string name(e->d_name);
+                if (name.compare(0, 10, "uncore_imc") != 0) {
+                    continue;
+                }
+
+                auto pmu = pmu_directory + name;
+                auto type = read_line(pmu + "/type");
+                auto cpus = parse_cpu_list(read_line(pmu + "/cpumask"));
+                if (type.empty()) {
+                    continue;
+                }
+                if (cpus.empty()) {
+                    cpus.push_back(0);
+                }
+
+                for (auto n : imc_events) {
+                    auto event = pmu + "/events/" + n;
+                    auto desc = read_line(event);
+                    std::uint64_t config = 0;
+                    perf_event_attr attr;
+                    ::memset(&attr, 0, sizeof(attr));
+                    attr.size = sizeof(attr);
+                    attr.type = static_cast<std::uint32_t>(std::stoul(type));
+                    attr.disabled = 1;
+
+                    if (desc.empty() || !parse_event(config, pmu, desc)) {
+                        continue;
+                    }
+                    attr.config = config;
+
+                    for (auto c : cpus) {
+                        auto handle = perf_event_open(attr, -1, c, -1, 0);
+                        if (handle >= 0) {
+                            this->_uncore.push_back(handle);
+                            this->_uncore_scales.push_back(
+                                parse_bytes_per_event(event));
+                        }
+                    }
+                }
+            }
+
+            ::closedir(dir);
+        }
+
+        if (this->_uncore.empty()) {
+            log::instance().write(log_level::warning, "The memory controller "
+                "counters are not available. This requires an Intel uncore "
+                "PMU and usually a perf_event_paranoid setting of at most "
+                "zero.\n");
+        }
+    }
+
+#else /* defined(__linux__) */
+    log::instance().write(log_level::warning, "Hardware performance "
+        "counters are only supported on Linux.\n");
+#endif /* defined(__linux__) */
+}
+
+
+/*
+ * trrojan::perf_counter_group::~perf_counter_group
+ */
+trrojan::perf_counter_group::~perf_counter_group(void) {
+#if defined(__linux__)
+    // Close the leader last, because it owns the group.
+    for (auto it = this->_handles.rbegin(); it != this->_handles.rend(); ++it) {
+        ::close(*it);
+    }
+    for (auto h : this->_uncore) {
+        ::close(h);
+    }
+#endif /* defined(__linux__) */
+}
+
+
+/*
+ * trrojan::perf_counter_group::available
+ */
+bool trrojan::perf_counter_group::available(void) const {
+    return (!this->_handles.empty() || !this->_uncore.empty());
+}
+
+
+/*
+ * trrojan::perf_counter_group::start
+ */
+void trrojan::perf_counter_group::start(void) {
+#if defined(__linux__)
+    for (auto h : this->_uncore) {
+        ::ioctl(h, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(h, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    if (this->_leader >= 0) {
+        ::ioctl(this->_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ::ioctl(this->_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif /* defined(__linux__) */
+}
+
+
+/*
+ * trrojan::perf_counter_group::stop
+ */
+trrojan::perf_counter_group::values_type trrojan::perf_counter_group::stop(
+        void) {
+    auto retval = invalid_values();
+
+#if defined(__linux__)
+    if (this->_leader >= 0) {
+        ::ioctl(this->_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+    for (auto h : this->_uncore) {
+        ::ioctl(h, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    if (this->_leader >= 0) {
+        // The group is read as { nr, time_enabled, time_running, values }.
+        std::vector<std::uint64_t> data(3 + this->_members.size());
+        auto size = data.size() * sizeof(std::uint64_t);
+        if (::read(this->_leader, data.data(), size)
+                == static_cast<ssize_t>(size)) {
+            auto enabled = data[1];
+            auto running = data[2];
+            // If the counters have been multiplexed, extrapolate to the time
+            // they have been enabled.
+            auto scale = ((running > 0) && (running < enabled))
+                ? static_cast<double>(enabled) / running
+                : 1.0;
+            for (std::size_t i = 0; i < this->_members.size(); ++i) {
+                auto c = static_cast<std::size_t>(this->_members[i]);
+                retval[c] = static_cast<value_type>(data[3 + i] * scale);
+            }
+        }
+    }
+
+    if (!this->_uncore.empty()) {
+        auto bytes = 0.0;
+        for (std::size_t i = 0; i < this->_uncore.size(); ++i) {
+            std::uint64_t value = 0;
+            if (::read(this->_uncore[i], &value, sizeof(value))
+                    == sizeof(value)) {
+                bytes += value * this->_uncore_scales[i];
+            }
+        }
+        retval[static_cast<std::size_t>(perf_counter::imc_bytes)]
+            = static_cast<value_type>(bytes);
+    }
+#endif /* defined(__linux__) */
+
+    return retval;
+}
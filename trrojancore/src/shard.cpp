@@ -0,0 +1,216 @@
+﻿// <copyright file="shard.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "trrojan/shard.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "trrojan/log.h"
+
+
+namespace {
+
+    /// <summary>
+    /// Splits a line of a CSV file at all separators that are not within
+    /// quotes.
+    /// </summary>
+    std::vector<std::string> split_csv(const std::string& line,
+            const std::string& separator) {
+        std::vector<std::string> retval;
+        auto isQuoted = false;
+        std::string::size_type start = 0;
+
+        for (std::string::size_type i = 0; i < line.size();) {
+            if (line[i] == '"') {
+                isQuoted = !isQuoted;
+                ++i;
+            } else if (!isQuoted && !separator.empty()
+                    && (line.compare(i, separator.size(), separator) == 0)) {
+                retval.push_back(line.substr(start, i - start));
+                i += separator.size();
+                start = i;
+            } else {
+                ++i;
+            }
+        }
+
+        retval.push_back(line.substr(start));
+        return retval;
+    }
+
+    /// <summary>
+    /// Removes the line break from a line and the quotes from a field.
+    /// </summary>
+    std::string trim_csv(std::string str) {
+        while (!str.empty() && ((str.back() == '\r') || (str.back() == '\n'))) {
+            str.pop_back();
+        }
+
+        if ((str.size() >= 2) && (str.front() == '"') && (str.back() == '"')) {
+            str = str.substr(1, str.size() - 2);
+        }
+
+        return str;
+    }
+
+    /// <summary>
+    /// Answer the position of the column <paramref name="name" /> in the
+    /// header of the shard <paramref name="path" />.
+    /// </summary>
+    std::size_t find_column(const std::vector<std::string>& columns,
+            const std::string& name, const std::string& path) {
+        auto it = std::find_if(columns.begin(), columns.end(),
+            [&name](const std::string& c) { return (trim_csv(c) == name); });
+        if (it == columns.end()) {
+            std::stringstream msg;
+            msg << "The shard \"" << path << "\" lacks the column \"" << name
+                << "\"." << std::ends;
+            throw std::invalid_argument(msg.str());
+        }
+
+        return static_cast<std::size_t>(std::distance(columns.begin(), it));
+    }
+}
+
+
+/*
+ * trrojan::shard::default_affinity
+ */
+const std::vector<std::string> trrojan::shard::default_affinity {
+    "data_set", "staging_directory"
+};
+
+
+/*
+ * trrojan::shard::entry_factor_name
+ */
+const std::string trrojan::shard::entry_factor_name("configuration_entry");
+
+
+/*
+ * trrojan::shard::factor_name
+ */
+const std::string trrojan::shard::factor_name("configuration_index");
+
+
+/*
+ * trrojan::shard::parse
+ */
+trrojan::shard trrojan::shard::parse(const std::string& str) {
+    shard retval;
+
+    std::istringstream stream(str);
+    char slash = 0;
+    if (!(stream >> retval.index >> slash >> retval.count) || (slash != '/')
+            || !stream.eof()) {
+        throw std::invalid_argument("A shard must be specified as \"i/n\".");
+    }
+
+    if (retval.index >= retval.count) {
+        throw std::invalid_argument("The index of a shard must be less than "
+            "the number of shards.");
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::merge_shards
+ */
+std::size_t trrojan::merge_shards(const std::string& output,
+        const std::vector<std::string>& inputs,
+        const std::string& separator) {
+    typedef std::pair<std::size_t, std::size_t> key_type;
+    typedef std::pair<key_type, std::string> row_type;
+    std::string header;
+    std::vector<row_type> rows;
+
+    for (auto& i : inputs) {
+        std::ifstream file(i, std::ios::binary);
+        if (!file) {
+            std::stringstream msg;
+            msg << "Failed to open shard \"" << i << "\"" << std::ends;
+            throw std::runtime_error(msg.str());
+        }
+
+        std::string line;
+        if (!std::getline(file, line)) {
+            // An empty file is produced by a shard that was not assigned any
+            // configuration.
+            log::instance().write_line(log_level::warning, "The shard \"{}\" "
+                "is empty.", i);
+            continue;
+        }
+
+        if (header.empty()) {
+            header = line;
+        } else if (trim_csv(header) != trim_csv(line)) {
+            std::stringstream msg;
+            msg << "The header of shard \"" << i << "\" does not match the "
+                "header of the previous ones." << std::ends;
+            throw std::invalid_argument(msg.str());
+        }
+
+        auto columns = split_csv(header, separator);
+        auto entryColumn = find_column(columns, shard::entry_factor_name, i);
+        auto indexColumn = find_column(columns, shard::factor_name, i);
+
+        while (std::getline(file, line)) {
+            if (trim_csv(line).empty()) {
+                continue;
+            }
+
+            auto fields = split_csv(line, separator);
+            if ((std::max)(entryColumn, indexColumn) >= fields.size()) {
+                std::stringstream msg;
+                msg << "A row in shard \"" << i << "\" has too few columns."
+                    << std::ends;
+                throw std::invalid_argument(msg.str());
+            }
+
+            auto entry = std::stoull(trim_csv(fields[entryColumn]));
+            auto index = std::stoull(trim_csv(fields[indexColumn]));
+            rows.emplace_back(key_type(static_cast<std::size_t>(entry),
+                static_cast<std::size_t>(index)), line);
+        }
+    }
+
+    // The index restarts for every entry of the TRROLL script, so the rows
+    // must be ordered by the entry first. Rows of the same configuration are
+    // contiguous within their shard, so a stable sort restores the order of
+    // a single process.
+    std::stable_sort(rows.begin(), rows.end(),
+        [](const row_type& l, const row_type& r) { return l.first < r.first; });
+
+    std::ofstream file(output, std::ios::trunc | std::ios::binary);
+    if (!file) {
+        std::stringstream msg;
+        msg << "Failed to open output file \"" << output << "\"" << std::ends;
+        throw std::runtime_error(msg.str());
+    }
+
+    if (!header.empty()) {
+        file << header << "\n";
+    }
+    for (auto& r : rows) {
+        file << r.second << "\n";
+    }
+
+    if (!file) {
+        std::stringstream msg;
+        msg << "Failed to write output file \"" << output << "\"" << std::ends;
+        throw std::runtime_error(msg.str());
+    }
+
+    log::instance().write_line(log_level::information, "Merged {} row(s) from "
+        "{} shard(s) into \"{}\".", rows.size(), inputs.size(), output);
+    return rows.size();
+}
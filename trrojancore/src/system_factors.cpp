@@ -79,9 +79,11 @@ static_cast<GAMING_DEVICE_DEVICE_ID>(0xDE8A5661)
 #include <sys/types.h>
 #endif /* defined(_WIN32) */
 
+#include "trrojan/cpu_topology.h"
 #include "trrojan/io.h"
 #include "trrojan/log.h"
 #include "trrojan/text.h"
+#include "trrojan/timer.h"
 
 
 /// <summary>
@@ -95,12 +97,26 @@ static std::unordered_map<std::string, trrojan::system_factors::retriever_type>
 retrievers;
 
 
+/// <summary>
+/// Classifies the system factors by whether they might change while the
+/// programme is running.
+/// </summary>
+/// <remarks>
+/// This must be a static in the .cpp for the same reason as
+/// <see cref="retrievers" />.
+/// </remarks>
+static std::unordered_map<std::string, trrojan::system_factors::volatility>
+volatilities;
+
+
 /// <summary>
 /// Registers a system factor for retrieval by name.
 /// </summary>
 static const std::string& register_retriever(const std::string& name,
-        trrojan::system_factors::retriever_type retriever) {
+        trrojan::system_factors::retriever_type retriever,
+        const trrojan::system_factors::volatility volatility) {
     ::retrievers[name] = retriever;
+    ::volatilities[name] = volatility;
     return name;
 }
 
@@ -120,27 +136,30 @@ bool trrojan::system_factors::is_system_factor(const std::string& factor) {
 }
 
 
-#define __TRROJAN_DEFINE_FACTOR(n)\
+#define __TRROJAN_DEFINE_FACTOR(n, v)\
 const std::string trrojan::system_factors::factor_##n                          \
-= ::register_retriever(#n, &system_factors::n)
-
-__TRROJAN_DEFINE_FACTOR(bios);
-__TRROJAN_DEFINE_FACTOR(computer_name);
-__TRROJAN_DEFINE_FACTOR(cpu);
-__TRROJAN_DEFINE_FACTOR(debug_build);
-__TRROJAN_DEFINE_FACTOR(gaming_device);
-__TRROJAN_DEFINE_FACTOR(installed_memory);
-__TRROJAN_DEFINE_FACTOR(logical_cores);
-__TRROJAN_DEFINE_FACTOR(mainboard);
-__TRROJAN_DEFINE_FACTOR(os);
-__TRROJAN_DEFINE_FACTOR(os_version);
-__TRROJAN_DEFINE_FACTOR(process_elevated);
-__TRROJAN_DEFINE_FACTOR(ram);
-__TRROJAN_DEFINE_FACTOR(system_desc);
-__TRROJAN_DEFINE_FACTOR(tdr_delay);
-__TRROJAN_DEFINE_FACTOR(tdr_level);
-__TRROJAN_DEFINE_FACTOR(timestamp);
-__TRROJAN_DEFINE_FACTOR(user_name);
+= ::register_retriever(#n, &system_factors::n, system_factors::volatility::v)
+
+__TRROJAN_DEFINE_FACTOR(bios, constant);
+__TRROJAN_DEFINE_FACTOR(computer_name, constant);
+__TRROJAN_DEFINE_FACTOR(cpu, constant);
+__TRROJAN_DEFINE_FACTOR(cpu_caches, constant);
+__TRROJAN_DEFINE_FACTOR(debug_build, constant);
+__TRROJAN_DEFINE_FACTOR(gaming_device, constant);
+__TRROJAN_DEFINE_FACTOR(installed_memory, variable);
+__TRROJAN_DEFINE_FACTOR(logical_cores, constant);
+__TRROJAN_DEFINE_FACTOR(mainboard, constant);
+__TRROJAN_DEFINE_FACTOR(os, constant);
+__TRROJAN_DEFINE_FACTOR(os_version, constant);
+__TRROJAN_DEFINE_FACTOR(process_elevated, constant);
+__TRROJAN_DEFINE_FACTOR(ram, constant);
+__TRROJAN_DEFINE_FACTOR(system_desc, constant);
+__TRROJAN_DEFINE_FACTOR(tdr_delay, constant);
+__TRROJAN_DEFINE_FACTOR(tdr_level, constant);
+__TRROJAN_DEFINE_FACTOR(timer_overhead, constant);
+__TRROJAN_DEFINE_FACTOR(timer_resolution, constant);
+__TRROJAN_DEFINE_FACTOR(timestamp, variable);
+__TRROJAN_DEFINE_FACTOR(user_name, constant);
 
 #undef __TRROJAN_DEFINE_FACTOR
 
@@ -310,6 +329,36 @@ trrojan::variant trrojan::system_factors::cpu(void) const {
 }
 
 
+/*
+ * trrojan::system_factors::cpu_caches
+ */
+trrojan::variant trrojan::system_factors::cpu_caches(void) const {
+    auto& caches = cpu_topology::instance().caches();
+
+    if (caches.empty()) {
+        log::instance().write(log_level::warning, "No information about the "
+            "CPU caches could be retrieved.");
+        return variant();
+
+    } else {
+        bool isFirst = true;
+        std::stringstream value;
+
+        for (auto& c : caches) {
+            if (isFirst) {
+                isFirst = false;
+            } else {
+                value << ", ";
+            }
+            value << "L" << c.level << " = " << (c.size / 1024) << " KiB ("
+                << c.sharing << " logical processor(s))";
+        }
+
+        return variant(value.str());
+    }
+}
+
+
 /*
  * trrojan::system_factors::debug_build
  */
@@ -365,11 +414,36 @@ trrojan::variant trrojan::system_factors::gaming_device(void) const {
  */
 trrojan::variant trrojan::system_factors::get(const std::string& factor) const {
     auto it = ::retrievers.find(factor);
-    if (it != ::retrievers.end()) {
-        return (this->*(it->second))();
-    } else {
+    if (it == ::retrievers.end()) {
         return variant();
     }
+
+    if (system_factors::get_volatility(factor) == volatility::constant) {
+        // Constant factors never change once the snapshot has been made, so
+        // neither the variable factors need to be refreshed nor the snapshot
+        // needs to be copied.
+        std::lock_guard<std::mutex> lock(this->_snapshot_lock);
+        if (this->_snapshot.empty()) {
+            this->take_snapshot();
+        }
+
+        auto i = this->_snapshot_indices.find(factor);
+        if (i != this->_snapshot_indices.end()) {
+            return this->_snapshot[i->second].value();
+        }
+    }
+
+    return (this->*(it->second))();
+}
+
+
+/*
+ * trrojan::system_factors::get_volatility
+ */
+trrojan::system_factors::volatility trrojan::system_factors::get_volatility(
+        const std::string& factor) {
+    auto it = ::volatilities.find(factor);
+    return (it != ::volatilities.end()) ? it->second : volatility::variable;
 }
 
 
@@ -629,6 +703,22 @@ trrojan::variant trrojan::system_factors::system_desc(void) const {
 }
 
 
+/*
+ * trrojan::system_factors::timer_overhead
+ */
+trrojan::variant trrojan::system_factors::timer_overhead(void) const {
+    return timer::calibrate().overhead;
+}
+
+
+/*
+ * trrojan::system_factors::timer_resolution
+ */
+trrojan::variant trrojan::system_factors::timer_resolution(void) const {
+    return timer::calibrate().resolution;
+}
+
+
 /*
  * trrojan::system_factors::timestamp
  */
@@ -789,6 +879,47 @@ trrojan::system_factors::get_retrievers(void) {
 }
 
 
+/*
+ * trrojan::system_factors::snapshot
+ */
+std::vector<trrojan::named_variant> trrojan::system_factors::snapshot(
+        void) const {
+    std::lock_guard<std::mutex> lock(this->_snapshot_lock);
+
+    if (this->_snapshot.empty()) {
+        this->take_snapshot();
+
+    } else {
+        for (auto i : this->_variable_factors) {
+            auto name = this->_snapshot[i].name();
+            auto retriever = ::retrievers[name];
+            this->_snapshot[i] = named_variant(name, (this->*retriever)());
+        }
+    }
+
+    return this->_snapshot;
+}
+
+
+/*
+ * trrojan::system_factors::take_snapshot
+ */
+void trrojan::system_factors::take_snapshot(void) const {
+    // Parsing SMBIOS and querying the OS is too expensive to be done for
+    // every configuration, so everything is retrieved only once and the
+    // variable factors are remembered for being updated later.
+    auto& retrievers = system_factors::get_retrievers();
+    this->_snapshot.reserve(retrievers.size());
+    for (auto& r : retrievers) {
+        if (system_factors::get_volatility(r.first) == volatility::variable) {
+            this->_variable_factors.push_back(this->_snapshot.size());
+        }
+        this->_snapshot_indices[r.first] = this->_snapshot.size();
+        this->_snapshot.emplace_back(r.first, (this->*(r.second))());
+    }
+}
+
+
 /*
  * trrojan::system_factors::system_factors
  */
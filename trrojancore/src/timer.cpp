@@ -6,7 +6,104 @@
 
 #include "trrojan/timer.h"
 
+#include <algorithm>
+#include <limits>
+
+#if (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif /* (defined(_M_X64) || defined(_M_IX86)) */
+
 #include "trrojan/constants.h"
+#include "trrojan/log.h"
+
+
+/*
+ * trrojan::timer::calibrate
+ */
+const trrojan::timer::calibration& trrojan::timer::calibrate(void) {
+    static const calibration retval = [](void) {
+        const std::size_t cntCalls = 1000;
+        const std::size_t cntRounds = 100;
+        calibration c;
+
+        c.invariant_tsc = timer::has_invariant_tsc();
+        c.overhead = (std::numeric_limits<millis_type>::max)();
+        c.resolution = (std::numeric_limits<millis_type>::max)();
+
+        // Use the best of several rounds, because an interrupt or a context
+        // switch can only make the clock appear slower.
+        for (std::size_t r = 0; r < cntRounds; ++r) {
+            auto begin = timer::now();
+            auto end = begin;
+            for (std::size_t i = 0; i < cntCalls; ++i) {
+                end = timer::now();
+            }
+            c.overhead = (std::min)(c.overhead, timer::to_millis(end - begin)
+                / static_cast<millis_type>(cntCalls));
+        }
+
+        for (std::size_t r = 0; r < cntRounds; ++r) {
+            auto begin = timer::now();
+            auto end = timer::now();
+            while (end == begin) {
+                end = timer::now();
+            }
+            c.resolution = (std::min)(c.resolution,
+                timer::to_millis(end - begin));
+        }
+
+        log::instance().write(log_level::verbose, "The timer has an overhead "
+            "of {} ms per call and a resolution of {} ms.\n", c.overhead,
+            c.resolution);
+#if defined(TRROJAN_TSC_CLOCK)
+        if (!c.invariant_tsc) {
+            log::instance().write(log_level::warning, "The timer uses the "
+                "time-stamp counter, but the processor does not report an "
+                "invariant TSC. Measured times might be wrong if the clock "
+                "frequency changes.\n");
+        }
+#endif /* defined(TRROJAN_TSC_CLOCK) */
+
+        return c;
+    }();
+
+    return retval;
+}
+
+
+/*
+ * trrojan::timer::has_invariant_tsc
+ */
+bool trrojan::timer::has_invariant_tsc(void) {
+    // The invariant TSC is reported in bit 8 of EDX of the extended leaf
+    // 0x80000007, which must be checked to exist first.
+    const unsigned int leaf = 0x80000007;
+    const unsigned int bit = 1 << 8;
+#if (defined(_M_X64) || defined(_M_IX86))
+    int regs[4];
+    ::__cpuid(regs, 0x80000000);
+    if (static_cast<unsigned int>(regs[0]) < leaf) {
+        return false;
+    }
+    ::__cpuid(regs, leaf);
+    return ((static_cast<unsigned int>(regs[3]) & bit) != 0);
+
+#elif (defined(__x86_64__) || defined(__i386__))
+    unsigned int eax, ebx, ecx, edx;
+    if (::__get_cpuid_max(0x80000000, nullptr) < leaf) {
+        return false;
+    }
+    if (!::__get_cpuid(leaf, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return ((edx & bit) != 0);
+
+#else /* (defined(_M_X64) || defined(_M_IX86)) */
+    return false;
+#endif /* (defined(_M_X64) || defined(_M_IX86)) */
+}
 
 
 /*
@@ -14,7 +111,8 @@
  */
 trrojan::timer::millis_type trrojan::timer::millis_since_epoch(
         const value_type value) {
-#if (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK))
+#if (defined(TRROJAN_TSC_CLOCK) \
+    || (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK)))
     return timer::to_millis(value);
 #else /* (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK)) */
     return timer::to_millis(value.time_since_epoch());
@@ -27,7 +125,10 @@ trrojan::timer::millis_type trrojan::timer::millis_since_epoch(
  */
 trrojan::timer::millis_type trrojan::timer::to_millis(
         const difference_type value) {
-#if (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK))
+#if defined(TRROJAN_TSC_CLOCK)
+    return static_cast<millis_type>(value) / timer::tsc_frequency();
+
+#elif (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK))
     LARGE_INTEGER frequency;
 
     if (::QueryPerformanceFrequency(&frequency)) {
@@ -47,3 +148,31 @@ trrojan::timer::millis_type trrojan::timer::to_millis(
     return v.count();
 #endif /* (defined(_WIN32) && !defined(TRROJAN_FORCE_STL_CLOCK)) */
 }
+
+
+#if defined(TRROJAN_TSC_CLOCK)
+/*
+ * trrojan::timer::tsc_frequency
+ */
+trrojan::timer::millis_type trrojan::timer::tsc_frequency(void) {
+    static const millis_type retval = [](void) {
+        typedef std::chrono::steady_clock clock_type;
+        typedef std::chrono::duration<millis_type, std::milli> millis;
+        const auto duration = std::chrono::milliseconds(20);
+        unsigned int aux;
+
+        auto begin = clock_type::now();
+        auto beginTicks = __rdtscp(&aux);
+        auto end = begin;
+        while ((end - begin) < duration) {
+            end = clock_type::now();
+        }
+        auto endTicks = __rdtscp(&aux);
+
+        return static_cast<millis_type>(endTicks - beginTicks)
+            / millis(end - begin).count();
+    }();
+
+    return retval;
+}
+#endif /* defined(TRROJAN_TSC_CLOCK) */
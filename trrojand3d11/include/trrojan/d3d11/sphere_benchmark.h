@@ -70,8 +70,6 @@ namespace d3d11 {
         /// </summary>
         virtual ~sphere_benchmark(void);
 
-        virtual void optimise_order(configuration_set& inOutConfs);
-
         /// <inheritdoc />
         virtual std::vector<std::string> required_factors(void) const;
 
@@ -109,9 +109,6 @@ namespace d3d11 {
             const configuration& config,
             const std::vector<std::string>& changed);
 
-        /// <inheritdoc />
-        void optimise_order(configuration_set& inOutConfs) override;
-
         trrojan::perspective_camera camera;
         winrt::com_ptr<ID3D11ShaderResourceView> data_view;
         winrt::com_ptr<ID3D11SamplerState> linear_sampler;
@@ -69,6 +69,12 @@ _DEFINE_SPHERE_TECHNIQUE_LUT(SPHERE_METHODS);
  */
 trrojan::d3d11::sphere_benchmark::sphere_benchmark(void)
         : benchmark_base("sphere-renderer") {
+    // Declare the factors which make us reload the data or rebuild the
+    // pipeline. The costs are rough estimates in milliseconds.
+    this->_switch_costs[factor_data_set] = 10000.0;
+    this->_switch_costs[factor_frame] = 1000.0;
+    this->_switch_costs[factor_device] = 500.0;
+
     // Declare the configuration data we need to have.
     this->_default_configs.add_factor(factor::from_manifestations(
         factor_adapt_tess_maximum, static_cast<unsigned int>(8)));
@@ -124,15 +130,6 @@ trrojan::d3d11::sphere_benchmark::sphere_benchmark(void)
 trrojan::d3d11::sphere_benchmark::~sphere_benchmark(void) { }
 
 
-/*
- * trrojan::d3d11::sphere_benchmark::optimise_order
- */
-void trrojan::d3d11::sphere_benchmark::optimise_order(
-        configuration_set& inOutConfs) {
-    inOutConfs.optimise_order({ factor_data_set, factor_frame, factor_device });
-}
-
-
 /*
  * trrojan::d3d11::sphere_benchmark::required_factors
  */
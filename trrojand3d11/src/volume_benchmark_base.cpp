@@ -319,6 +319,12 @@ void trrojan::d3d11::volume_benchmark_base::load_xfer_func(
  */
 trrojan::d3d11::volume_benchmark_base::volume_benchmark_base(
         const std::string& name) : benchmark_base(name) {
+    // Declare the factors which make us reload the volume or the transfer
+    // function. The costs are rough estimates in milliseconds.
+    this->_switch_costs[factor_data_set] = 10000.0;
+    this->_switch_costs[factor_xfer_func] = 100.0;
+    this->_switch_costs[factor_device] = 500.0;
+
     this->_default_configs.add_factor(factor::from_manifestations(
         factor_ert_threshold, 0.0f));
     this->_default_configs.add_factor(factor::from_manifestations(
@@ -391,16 +397,3 @@ trrojan::result trrojan::d3d11::volume_benchmark_base::on_run(
 
     return trrojan::result();
 }
-
-
-/*
- * trrojan::d3d11::volume_benchmark_base::optimise_order
- */
-void trrojan::d3d11::volume_benchmark_base::optimise_order(
-        configuration_set& inOutConfs) {
-    inOutConfs.optimise_order({
-        factor_data_set,
-        factor_xfer_func,
-        factor_device
-    });
-}
@@ -34,9 +34,6 @@ namespace d3d12 {
         /// </summary>
         virtual ~sphere_benchmark_base(void) = default;
 
-        /// <inheritdoc />
-        virtual void optimise_order(configuration_set& inOutConfs) override;
-
         /// <inheritdoc />
         virtual std::vector<std::string> required_factors(void) const;
 
@@ -51,22 +51,17 @@ trrojan::d3d12::dstorage_sphere_benchmark::dstorage_sphere_benchmark(
         factor_batch_splits, { 2u }));
     this->_default_configs.add_factor(factor::from_manifestations(
         factor_implementation, { implementation_batches }));
-}
 
+    // Changing the staging directory requires the data to be copied, and the
+    // batches require the GPU stream to be rebuilt.
+    this->_switch_costs[dstorage_configuration::factor_staging_directory]
+        = 5000.0;
+    this->_switch_costs[sphere_streaming_context::factor_batch_count] = 100.0;
+    this->_switch_costs[sphere_streaming_context::factor_batch_size] = 100.0;
+    this->_switch_costs[sphere_streaming_context::factor_repeat_frame] = 100.0;
 
-/*
- * trrojan::d3d12::dstorage_sphere_benchmark::optimise_order
- */
-void trrojan::d3d12::dstorage_sphere_benchmark::optimise_order(
-        configuration_set& configs) {
-    configs.optimise_order({
-        sphere_rendering_configuration::factor_data_set,
-        dstorage_configuration::factor_staging_directory,
-        sphere_rendering_configuration::factor_frame,
-        sphere_streaming_context::factor_batch_count,
-        sphere_streaming_context::factor_batch_size,
-        factor_device,
-    });
+    // Compare the devices on the same batches, ie change the device fastest.
+    this->_switch_costs[benchmark_base::factor_device] = 50.0;
 }
 
 
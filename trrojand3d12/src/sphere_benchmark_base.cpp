@@ -33,18 +33,6 @@
 
 
 
-/*
- * trrojan::d3d12::sphere_benchmark_base::optimise_order
- */
-void trrojan::d3d12::sphere_benchmark_base::optimise_order(
-        configuration_set& inOutConfs) {
-    inOutConfs.optimise_order({ 
-        sphere_rendering_configuration::factor_data_set,
-        sphere_rendering_configuration::factor_frame,
-        benchmark_base::factor_device });
-}
-
-
 /*
  * trrojan::d3d12::sphere_benchmark_base::required_factors
  */
@@ -176,6 +164,14 @@ trrojan::d3d12::sphere_benchmark_base::sphere_benchmark_base(
     : benchmark_base(name), _cnt_descriptor_tables(0),
         _sphere_constants(nullptr), _tessellation_constants(nullptr),
         _view_constants(nullptr) {
+    // Declare the factors which make us reload the data or rebuild the
+    // pipeline. The costs are rough estimates in milliseconds.
+    this->_switch_costs[sphere_rendering_configuration::factor_data_set]
+        = 10000.0;
+    this->_switch_costs[sphere_rendering_configuration::factor_frame]
+        = 1000.0;
+    this->_switch_costs[benchmark_base::factor_device] = 500.0;
+
     // Declare the configuration data we need to have.
     this->_default_configs.add_factor(factor::from_manifestations(
         sphere_rendering_configuration::factor_adapt_tess_maximum,
@@ -63,6 +63,14 @@ trrojan::d3d12::sphere_streaming_benchmark::sphere_streaming_benchmark(
             streaming_method_dstorage_memcpy
         }));
 
+    // Changing the staging directory requires the data to be copied, and the
+    // batches require the GPU stream to be rebuilt.
+    this->_switch_costs[dstorage_configuration::factor_staging_directory]
+        = 5000.0;
+    this->_switch_costs[sphere_streaming_context::factor_batch_count] = 100.0;
+    this->_switch_costs[sphere_streaming_context::factor_batch_size] = 100.0;
+    this->_switch_costs[sphere_streaming_context::factor_repeat_frame] = 100.0;
+
     // Determine the allocation granularity that we need to map the file.
     {
         SYSTEM_INFO si;
@@ -33,22 +33,49 @@ namespace stream {
         /// interleaved manner, ie all threads read in a spatially close range
         /// at approximately the same time.
         /// </summary>
-        interleaved
+        interleaved,
+
+        /// <summary>
+        /// This access pattern instructs each thread to process only every
+        /// k-th item of its contiguous range, which resembles reading a single
+        /// attribute from an array of structures.
+        /// </summary>
+        strided,
+
+        /// <summary>
+        /// This access pattern instructs each thread to gather the inputs from
+        /// its contiguous range through an index buffer holding a random
+        /// permutation, which resembles indexed reads of particle data.
+        /// </summary>
+        random,
+
+        /// <summary>
+        /// This access pattern instructs the threads to process blocks of
+        /// consecutive items in a round-robin manner, which is in between
+        /// <see cref="contiguous" /> and <see cref="interleaved" />.
+        /// </summary>
+        blocked
     };
 
 
     /// <summary>
-    /// A traits class for inferring the offset between two threads and the
-    /// offset between two steps from the
-    /// <see cref="trrojan::stream::access_pattern" /> and the problem size
-    /// <tparamref name="P" />.
+    /// A traits class for inferring the offset of a thread and the offset
+    /// between two steps from the
+    /// <see cref="trrojan::stream::access_pattern" /> and the begin of the
+    /// slice of the thread, which is given by
+    /// <see cref="trrojan::stream::problem::offset" />.
     /// </summary>
-    template<access_pattern A, size_t P> struct access_pattern_traits { };
-
-    template<size_t P>
-    struct access_pattern_traits<access_pattern::contiguous, P> {
-        static inline size_t offset(const size_t rank) {
-            return (rank * P);
+    /// <remarks>
+    /// The offset and the step of <see cref="access_pattern::strided" /> are
+    /// measured in strides and the ones of
+    /// <see cref="access_pattern::blocked" /> are measured in blocks.
+    /// </remarks>
+    template<access_pattern A> struct access_pattern_traits { };
+
+    template<>
+    struct access_pattern_traits<access_pattern::contiguous> {
+        static inline size_t offset(const size_t rank, const size_t slice) {
+            return slice;
         }
         static inline size_t step(const size_t parallelism) {
             return 1;
@@ -59,9 +86,9 @@ namespace stream {
         }
     };
 
-    template<size_t P>
-    struct access_pattern_traits<access_pattern::interleaved, P> {
-        static inline size_t offset(const size_t rank) {
+    template<>
+    struct access_pattern_traits<access_pattern::interleaved> {
+        static inline size_t offset(const size_t rank, const size_t slice) {
             return rank;
         }
         static inline size_t step(const size_t parallelism) {
@@ -74,10 +101,54 @@ namespace stream {
     };
 
 
+    template<>
+    struct access_pattern_traits<access_pattern::strided> {
+        static inline size_t offset(const size_t rank, const size_t slice) {
+            return slice;
+        }
+        static inline size_t step(const size_t parallelism) {
+            return 1;
+        }
+        static inline const std::string& name(void) {
+            static const std::string name("strided");
+            return name;
+        }
+    };
+
+    template<>
+    struct access_pattern_traits<access_pattern::random> {
+        static inline size_t offset(const size_t rank, const size_t slice) {
+            return slice;
+        }
+        static inline size_t step(const size_t parallelism) {
+            return 1;
+        }
+        static inline const std::string& name(void) {
+            static const std::string name("random");
+            return name;
+        }
+    };
+
+    template<>
+    struct access_pattern_traits<access_pattern::blocked> {
+        static inline size_t offset(const size_t rank, const size_t slice) {
+            return rank;
+        }
+        static inline size_t step(const size_t parallelism) {
+            return parallelism;
+        }
+        static inline const std::string& name(void) {
+            static const std::string name("blocked");
+            return name;
+        }
+    };
+
+
     template<access_pattern... V>
     using access_pattern_list_t = enum_dispatch_list<access_pattern, V...>;
 
     typedef access_pattern_list_t<access_pattern::contiguous,
-        access_pattern::interleaved> access_pattern_list;
+        access_pattern::interleaved, access_pattern::strided,
+        access_pattern::random, access_pattern::blocked> access_pattern_list;
 }
 }
@@ -0,0 +1,158 @@
+/// <copyright file="allocation_benchmark.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include "trrojan/benchmark.h"
+
+#include <cstddef>
+
+#include "trrojan/enum_parse_helper.h"
+#include "trrojan/page_size.h"
+
+#include "trrojan/stream/allocation_method.h"
+#include "trrojan/stream/export.h"
+#include "trrojan/stream/thread_placement.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// Measures the cost of mapping fresh memory, faulting it in and
+    /// unmapping it again.
+    /// </summary>
+    /// <remarks>
+    /// <para>The requested size is split into page-aligned chunks, one per
+    /// thread. In each iteration, all threads wait at a barrier, map their
+    /// chunk, make the operating system back it with physical memory using
+    /// the selected <see cref="allocation_method" />, write to every page
+    /// once and unmap the chunk. Faults are therefore taken by all threads at
+    /// the same time, which exposes the contention in the memory management
+    /// of the kernel.</para>
+    /// <para>Each iteration yields one row. The times of the phases are
+    /// those of the slowest thread in milliseconds. The fault latency is the
+    /// time for mapping and touching a chunk divided by its number of pages
+    /// in nanoseconds, averaged over the threads. The zeroing rate is the
+    /// size of all chunks divided by the time between the first thread
+    /// starting to map and the last thread having touched its chunk, which is
+    /// the bandwidth at which the operating system provides zeroed memory.
+    /// The unmap rate is computed accordingly for the unmapping phase. Both
+    /// rates are in MB/s.</para>
+    /// <para>The benchmark supports the following
+    /// <see cref="trrojan::factor" />s, which all have reasonable default
+    /// values:</para>
+    /// <list type="bullet">
+    /// <item>
+    /// <term>iterations</term>
+    /// <description>The number of measurements for each configuration. One
+    /// additional iteration warms up the allocator of the operating system
+    /// and is not reported.</description>
+    /// </item>
+    /// <item>
+    /// <term>method</term>
+    /// <description>The way the memory is backed with physical pages. The
+    /// string representation of <see cref="allocation_method" /> must be used
+    /// for this factor. By default, all methods supported on the platform
+    /// are compared.</description>
+    /// </item>
+    /// <item>
+    /// <term>page_size</term>
+    /// <description>The kind of pages being faulted in. The string
+    /// representation of <see cref="trrojan::page_size" /> must be used for
+    /// this factor. Explicit huge pages must have been reserved before. If
+    /// they are not available, a warning is issued and smaller pages are
+    /// measured instead.</description>
+    /// </item>
+    /// <item>
+    /// <term>placement</term>
+    /// <description>The policy for pinning the threads to logical
+    /// processors. The string representation of
+    /// <see cref="thread_placement" /> must be used for this factor.
+    /// </description>
+    /// </item>
+    /// <item>
+    /// <term>size</term>
+    /// <description>The total number of bytes mapped by all threads. By
+    /// default, the size is quadrupled from 1 MiB to 1 GiB.</description>
+    /// </item>
+    /// <item>
+    /// <term>threads</term>
+    /// <description>The number of threads mapping chunks. At most one thread
+    /// per page is used. By default, one thread and one thread per logical
+    /// processor are compared.</description>
+    /// </item>
+    /// </list>
+    /// </remarks>
+    class TRROJANSTREAM_API allocation_benchmark
+            : public trrojan::benchmark_base {
+
+    public:
+
+        typedef benchmark_base::on_result_callback on_result_callback;
+
+        static const std::string factor_iterations;
+        static const std::string factor_method;
+        static const std::string factor_page_size;
+        static const std::string factor_placement;
+        static const std::string factor_size;
+        static const std::string factor_threads;
+
+        static const std::string result_name_fault_latency;
+        static const std::string result_name_pages;
+        static const std::string result_name_rate_unmap;
+        static const std::string result_name_rate_zeroing;
+        static const std::string result_name_time_map;
+        static const std::string result_name_time_touch;
+        static const std::string result_name_time_unmap;
+
+        /// <summary>
+        /// Answer whether the given method can be used on this platform.
+        /// </summary>
+        static bool is_supported(const allocation_method method);
+
+        allocation_benchmark(void);
+
+        virtual ~allocation_benchmark(void);
+
+        virtual trrojan::result run(const configuration& config);
+
+    private:
+
+        static inline allocation_method parse_method(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<allocation_method,
+                allocation_method_traits, allocation_method_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(allocation_method_list(), value);
+        }
+
+        static inline trrojan::page_size parse_page_size(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<trrojan::page_size, page_size_traits,
+                page_size_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(page_size_list(), value);
+        }
+
+        static inline thread_placement parse_placement(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<thread_placement,
+                thread_placement_traits, thread_placement_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(thread_placement_list(), value);
+        }
+
+        /// <summary>
+        /// Maps <paramref name="size" /> bytes of the given pages and makes
+        /// the operating system back them using <paramref name="method" />.
+        /// </summary>
+        static void *map(const std::size_t size, const trrojan::page_size pages,
+            const allocation_method method);
+    };
+
+}
+}
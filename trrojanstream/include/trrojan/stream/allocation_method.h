@@ -0,0 +1,73 @@
+/// <copyright file="allocation_method.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <string>
+
+#include "trrojan/enum_dispatch_list.h"
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// The ways the allocation benchmark makes the operating system back a
+    /// new mapping with physical memory.
+    /// </summary>
+    enum class TRROJANSTREAM_API allocation_method {
+
+        /// <summary>
+        /// The mapping is created without any hints and each page is faulted
+        /// in when it is written for the first time.
+        /// </summary>
+        first_touch,
+
+        /// <summary>
+        /// The mapping is populated by the operating system while it is
+        /// created, eg using <c>MAP_POPULATE</c>.
+        /// </summary>
+        populate,
+
+        /// <summary>
+        /// The operating system is advised via <c>MADV_WILLNEED</c> that the
+        /// whole mapping will be accessed before it is first touched.
+        /// </summary>
+        will_need
+    };
+
+
+    /// <summary>
+    /// A traits class for parsing allocation methods.
+    /// </summary>
+    template<allocation_method M> struct allocation_method_traits { };
+
+#define __TRROJANSTREAM_DECL_ALLOCATION_METHOD_TRAITS(m)                       \
+    template<> struct allocation_method_traits<allocation_method::m> {         \
+        static inline const std::string& name(void) {                          \
+            static const std::string retval(#m);                               \
+            return retval;                                                     \
+        }                                                                      \
+    }
+
+    __TRROJANSTREAM_DECL_ALLOCATION_METHOD_TRAITS(first_touch);
+    __TRROJANSTREAM_DECL_ALLOCATION_METHOD_TRAITS(populate);
+    __TRROJANSTREAM_DECL_ALLOCATION_METHOD_TRAITS(will_need);
+
+#undef __TRROJANSTREAM_DECL_ALLOCATION_METHOD_TRAITS
+
+
+    template<allocation_method... V>
+    using allocation_method_list_t = enum_dispatch_list<allocation_method,
+        V...>;
+
+    typedef allocation_method_list_t<allocation_method::first_touch,
+        allocation_method::populate, allocation_method::will_need>
+        allocation_method_list;
+}
+}
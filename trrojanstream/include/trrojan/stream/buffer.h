@@ -0,0 +1,155 @@
+/// <copyright file="buffer.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <vector>
+
+#include "trrojan/page_size.h"
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// A page-aligned block of virtual memory, which is not touched on
+    /// allocation such that the physical pages can be placed on the NUMA node
+    /// of the thread that first accesses them.
+    /// </summary>
+    /// <remarks>
+    /// On Windows, <see cref="allocate" /> only reserves the address space of
+    /// buffers using regular pages. Every range must be committed via
+    /// <see cref="bind" /> before it is accessed. On all other platforms and
+    /// for huge pages, the address space is usable right away and
+    /// <see cref="bind" /> only changes the memory policy.
+    /// </remarks>
+    class TRROJANSTREAM_API buffer {
+
+    public:
+
+        /// <summary>
+        /// The type of a list of NUMA nodes.
+        /// </summary>
+        typedef std::vector<std::uint32_t> node_list;
+
+        /// <summary>
+        /// Answer the size of a virtual memory page.
+        /// </summary>
+        static std::size_t page_size(void);
+
+        /// <summary>
+        /// Initialises an empty buffer.
+        /// </summary>
+        inline buffer(void) noexcept : _data(nullptr),
+            _pages(trrojan::page_size::regular), _size(0) { }
+
+        buffer(const buffer&) = delete;
+
+        /// <summary>
+        /// Move <paramref name="rhs" />.
+        /// </summary>
+        buffer(buffer&& rhs) noexcept;
+
+        /// <summary>
+        /// Finalises the instance.
+        /// </summary>
+        ~buffer(void);
+
+        /// <summary>
+        /// Releases any previous memory and allocates <paramref name="size" />
+        /// bytes of virtual memory without touching it.
+        /// </summary>
+        /// <remarks>
+        /// If the requested pages are not available, a warning is issued and
+        /// smaller pages are used.
+        /// </remarks>
+        /// <param name="size">The size of the buffer in bytes.</param>
+        /// <param name="pages">The kind of pages backing the buffer.</param>
+        void allocate(const std::size_t size,
+            const trrojan::page_size pages = trrojan::page_size::regular);
+
+        /// <summary>
+        /// Determines where the physical pages of the given range will be
+        /// placed once they are touched.
+        /// </summary>
+        /// <remarks>
+        /// The range will be extended to full pages. If the memory policy
+        /// cannot be applied, a warning is issued and the range uses the
+        /// default policy.
+        /// </remarks>
+        /// <param name="offset">The offset of the range in bytes.</param>
+        /// <param name="size">The size of the range in bytes.</param>
+        /// <param name="nodes">The NUMA nodes the range should be placed on.
+        /// If this list is empty, the pages will be placed on the node of the
+        /// thread that first touches them. If it contains more than one node,
+        /// the pages will be interleaved between the nodes.</param>
+        void bind(const std::size_t offset, const std::size_t size,
+            const node_list& nodes);
+
+        /// <summary>
+        /// Gets a pointer to the begin of the buffer.
+        /// </summary>
+        template<class T> inline T *data(void) {
+            return static_cast<T *>(this->_data);
+        }
+
+        /// <summary>
+        /// Gets a pointer to the begin of the buffer.
+        /// </summary>
+        template<class T> inline const T *data(void) const {
+            return static_cast<const T *>(this->_data);
+        }
+
+        /// <summary>
+        /// Answer the kind of pages that has been requested for the buffer.
+        /// </summary>
+        inline trrojan::page_size pages(void) const {
+            return this->_pages;
+        }
+
+        /// <summary>
+        /// Frees the memory.
+        /// </summary>
+        void release(void) noexcept;
+
+        /// <summary>
+        /// Answer the size of the buffer in bytes.
+        /// </summary>
+        inline std::size_t size(void) const {
+            return this->_size;
+        }
+
+        buffer& operator =(const buffer&) = delete;
+
+        /// <summary>
+        /// Move assignment.
+        /// </summary>
+        buffer& operator =(buffer&& rhs) noexcept;
+
+    private:
+
+        /// <summary>
+        /// The begin of the allocation.
+        /// </summary>
+        void *_data;
+
+        /// <summary>
+        /// The kind of pages requested for the allocation.
+        /// </summary>
+        trrojan::page_size _pages;
+
+        /// <summary>
+        /// The requested size of the allocation in bytes.
+        /// </summary>
+        std::size_t _size;
+    };
+
+}
+}
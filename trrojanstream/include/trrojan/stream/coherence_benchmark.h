@@ -0,0 +1,161 @@
+/// <copyright file="coherence_benchmark.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include "trrojan/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "trrojan/cpu_topology.h"
+#include "trrojan/enum_parse_helper.h"
+
+#include "trrojan/stream/coherence_test.h"
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// Measures the cost of moving a cache line between two logical
+    /// processors through the cache-coherence protocol.
+    /// </summary>
+    /// <remarks>
+    /// <para>The benchmark pins a pair of threads to the logical processors
+    /// given by the <c>first_processor</c> and <c>second_processor</c>
+    /// factors and lets them access the same cache line according to the
+    /// selected <see cref="coherence_test" />. Both threads perform the
+    /// configured number of operations each. The latency is the time per
+    /// operation over both threads and the throughput is the number of
+    /// operations of both threads per second. For a ping-pong, an operation
+    /// is one hand-over of the line, ie the latency is half the round-trip
+    /// time.</para>
+    /// <para>By default, every ordered pair of distinct logical processors
+    /// is measured. Once all configurations have run, the average latency
+    /// of each test is written to the log as a core-to-core matrix, with
+    /// the rows being the first and the columns being the second processor.
+    /// Pairs of identical processors are skipped, because the two threads
+    /// would only take turns on the same hardware thread.</para>
+    /// <para>The benchmark supports the following
+    /// <see cref="trrojan::factor" />s, which all have reasonable default
+    /// values:</para>
+    /// <list type="bullet">
+    /// <item>
+    /// <term>first_processor</term>
+    /// <description>The ID of the logical processor the first thread is
+    /// pinned to. The first thread initiates the ping-pong and measures the
+    /// time. By default, all logical processors are used.</description>
+    /// </item>
+    /// <item>
+    /// <term>iterations</term>
+    /// <description>The number of measurements for each configuration. One
+    /// additional measurement warms up the threads and is not reported.
+    /// </description>
+    /// </item>
+    /// <item>
+    /// <term>operations</term>
+    /// <description>The number of operations each of the threads performs
+    /// per iteration.</description>
+    /// </item>
+    /// <item>
+    /// <term>second_processor</term>
+    /// <description>The ID of the logical processor the second thread is
+    /// pinned to. By default, all logical processors are used.
+    /// </description>
+    /// </item>
+    /// <item>
+    /// <term>test</term>
+    /// <description>The access pattern on the shared cache line. The string
+    /// representation of <see cref="coherence_test" /> must be used for this
+    /// factor. By default, all tests are run.</description>
+    /// </item>
+    /// </list>
+    /// </remarks>
+    class TRROJANSTREAM_API coherence_benchmark
+            : public trrojan::benchmark_base {
+
+    public:
+
+        typedef benchmark_base::on_result_callback on_result_callback;
+
+        static const std::string factor_first_processor;
+        static const std::string factor_iterations;
+        static const std::string factor_operations;
+        static const std::string factor_second_processor;
+        static const std::string factor_test;
+
+        static const std::string result_name_latency_average;
+        static const std::string result_name_latency_maximum;
+        static const std::string result_name_latency_minimum;
+        static const std::string result_name_operations;
+        static const std::string result_name_throughput_average;
+        static const std::string result_name_throughput_maximum;
+        static const std::string result_name_throughput_minimum;
+        static const std::string result_name_time_average;
+        static const std::string result_name_time_maximum;
+        static const std::string result_name_time_minimum;
+
+        coherence_benchmark(void);
+
+        virtual ~coherence_benchmark(void);
+
+        virtual size_t run(const configuration_set& configs,
+            const on_result_callback& callback,
+            const cool_down& coolDown,
+            const std::size_t continue_at);
+
+        virtual trrojan::result run(const configuration& config);
+
+    protected:
+
+        virtual std::vector<configuration> expand_configuration(
+            const configuration& c);
+
+    private:
+
+        /// <summary>
+        /// The average latencies of a test indexed by the IDs of the first
+        /// and the second processor.
+        /// </summary>
+        typedef std::map<std::pair<std::uint32_t, std::uint32_t>, double>
+            matrix_type;
+
+        static inline coherence_test parse_test(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<coherence_test, coherence_test_traits,
+                coherence_test_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(coherence_test_list(), value);
+        }
+
+        /// <summary>
+        /// Answer the logical processor with the given ID.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">If no such processor
+        /// exists.</exception>
+        static const cpu_topology::logical_processor& find_processor(
+            const std::uint32_t id);
+
+        /// <summary>
+        /// Writes the core-to-core matrix of the given test to the log.
+        /// </summary>
+        static void log_matrix(const std::string& test,
+            const matrix_type& matrix);
+
+        /// <summary>
+        /// The core-to-core matrices of the current configuration set indexed
+        /// by the name of the test.
+        /// </summary>
+        std::map<std::string, matrix_type> _matrices;
+    };
+
+}
+}
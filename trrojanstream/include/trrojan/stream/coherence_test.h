@@ -0,0 +1,74 @@
+/// <copyright file="coherence_test.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <string>
+
+#include "trrojan/enum_dispatch_list.h"
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// The access patterns the coherence benchmark uses to move a cache line
+    /// between two logical processors.
+    /// </summary>
+    enum class TRROJANSTREAM_API coherence_test {
+
+        /// <summary>
+        /// Both threads atomically increment the same counter, ie the cache
+        /// line migrates between the cores on every locked read-modify-write.
+        /// </summary>
+        atomic_increment,
+
+        /// <summary>
+        /// Both threads increment their own counter, but the counters reside
+        /// in the same cache line, such that the line is invalidated in the
+        /// other core although no data are shared.
+        /// </summary>
+        false_sharing,
+
+        /// <summary>
+        /// The threads take turns in writing a flag the other one is waiting
+        /// for, which is the round trip of a cache line through the coherence
+        /// protocol.
+        /// </summary>
+        ping_pong
+    };
+
+
+    /// <summary>
+    /// A traits class for parsing coherence tests.
+    /// </summary>
+    template<coherence_test T> struct coherence_test_traits { };
+
+#define __TRROJANSTREAM_DECL_COHERENCE_TEST_TRAITS(t)                          \
+    template<> struct coherence_test_traits<coherence_test::t> {               \
+        static inline const std::string& name(void) {                          \
+            static const std::string retval(#t);                               \
+            return retval;                                                     \
+        }                                                                      \
+    }
+
+    __TRROJANSTREAM_DECL_COHERENCE_TEST_TRAITS(atomic_increment);
+    __TRROJANSTREAM_DECL_COHERENCE_TEST_TRAITS(false_sharing);
+    __TRROJANSTREAM_DECL_COHERENCE_TEST_TRAITS(ping_pong);
+
+#undef __TRROJANSTREAM_DECL_COHERENCE_TEST_TRAITS
+
+
+    template<coherence_test... V>
+    using coherence_test_list_t = enum_dispatch_list<coherence_test, V...>;
+
+    typedef coherence_test_list_t<coherence_test::atomic_increment,
+        coherence_test::false_sharing, coherence_test::ping_pong>
+        coherence_test_list;
+}
+}
@@ -0,0 +1,103 @@
+/// <copyright file="copy_engine.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <string>
+
+#include "trrojan/enum_dispatch_list.h"
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// The primitives the memcpy benchmark can copy memory with.
+    /// </summary>
+    enum class TRROJANSTREAM_API copy_engine {
+
+        /// <summary>
+        /// The <c>memcpy</c> of the C runtime.
+        /// </summary>
+        libc,
+
+        /// <summary>
+        /// A single <c>rep movsb</c> instruction, which is executed by the
+        /// microcode of processors with enhanced or fast short string moves.
+        /// </summary>
+        rep_movsb,
+
+        /// <summary>
+        /// The SSE2 copy kernel of the stream benchmark.
+        /// </summary>
+        sse2,
+
+        /// <summary>
+        /// The SSE2 copy kernel of the stream benchmark using non-temporal
+        /// stores.
+        /// </summary>
+        sse2_non_temporal,
+
+        /// <summary>
+        /// The AVX2 copy kernel of the stream benchmark.
+        /// </summary>
+        avx2,
+
+        /// <summary>
+        /// The AVX2 copy kernel of the stream benchmark using non-temporal
+        /// stores.
+        /// </summary>
+        avx2_non_temporal,
+
+        /// <summary>
+        /// The AVX-512 copy kernel of the stream benchmark.
+        /// </summary>
+        avx512,
+
+        /// <summary>
+        /// The AVX-512 copy kernel of the stream benchmark using
+        /// non-temporal stores.
+        /// </summary>
+        avx512_non_temporal
+    };
+
+
+    /// <summary>
+    /// A traits class for parsing copy engines.
+    /// </summary>
+    template<copy_engine E> struct copy_engine_traits { };
+
+#define __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS(e)                             \
+    template<> struct copy_engine_traits<copy_engine::e> {                     \
+        static inline const std::string& name(void) {                          \
+            static const std::string retval(#e);                               \
+            return retval;                                                     \
+        }                                                                      \
+    }
+
+    __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS(libc);
+    __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS(rep_movsb);
+    __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS(sse2);
+    __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS(sse2_non_temporal);
+    __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS(avx2);
+    __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS(avx2_non_temporal);
+    __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS(avx512);
+    __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS(avx512_non_temporal);
+
+#undef __TRROJANSTREAM_DECL_COPY_ENGINE_TRAITS
+
+
+    template<copy_engine... V>
+    using copy_engine_list_t = enum_dispatch_list<copy_engine, V...>;
+
+    typedef copy_engine_list_t<copy_engine::libc, copy_engine::rep_movsb,
+        copy_engine::sse2, copy_engine::sse2_non_temporal, copy_engine::avx2,
+        copy_engine::avx2_non_temporal, copy_engine::avx512,
+        copy_engine::avx512_non_temporal> copy_engine_list;
+}
+}
@@ -0,0 +1,94 @@
+/// <copyright file="instruction_set.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <string>
+
+#include "trrojan/enum_dispatch_list.h"
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// The instruction sets for which hand-written stream kernels exist.
+    /// </summary>
+    enum class TRROJANSTREAM_API instruction_set {
+
+        /// <summary>
+        /// Plain C++ loops, which work on any platform and are also used for
+        /// non-contiguous accesses.
+        /// </summary>
+        scalar,
+
+        /// <summary>
+        /// 128-bit SSE2 kernels.
+        /// </summary>
+        sse2,
+
+        /// <summary>
+        /// 256-bit AVX2 kernels.
+        /// </summary>
+        avx2,
+
+        /// <summary>
+        /// 512-bit AVX-512 (F and DQ) kernels.
+        /// </summary>
+        avx512
+    };
+
+
+    /// <summary>
+    /// A traits class for parsing instruction sets.
+    /// </summary>
+    template<instruction_set I> struct instruction_set_traits { };
+
+#define __TRROJANSTREAM_DECL_INSTRUCTION_SET_TRAITS(i)                         \
+    template<> struct instruction_set_traits<instruction_set::i> {             \
+        static inline const std::string& name(void) {                          \
+            static const std::string retval(#i);                               \
+            return retval;                                                     \
+        }                                                                      \
+    }
+
+    __TRROJANSTREAM_DECL_INSTRUCTION_SET_TRAITS(scalar);
+    __TRROJANSTREAM_DECL_INSTRUCTION_SET_TRAITS(sse2);
+    __TRROJANSTREAM_DECL_INSTRUCTION_SET_TRAITS(avx2);
+    __TRROJANSTREAM_DECL_INSTRUCTION_SET_TRAITS(avx512);
+
+#undef __TRROJANSTREAM_DECL_INSTRUCTION_SET_TRAITS
+
+
+    template<instruction_set... V>
+    using instruction_set_list_t = enum_dispatch_list<instruction_set, V...>;
+
+    typedef instruction_set_list_t<instruction_set::scalar,
+        instruction_set::sse2, instruction_set::avx2, instruction_set::avx512>
+        instruction_set_list;
+
+
+    /// <summary>
+    /// Answer the most capable instruction set that is supported by the CPU
+    /// and for which kernels have been compiled.
+    /// </summary>
+    TRROJANSTREAM_API instruction_set best_instruction_set(void);
+
+    /// <summary>
+    /// Answer whether the CPU and the operating system support the given
+    /// instruction set and kernels for it have been compiled.
+    /// </summary>
+    TRROJANSTREAM_API bool is_supported(const instruction_set isa);
+
+    /// <summary>
+    /// Answer the name of the given instruction set, which can be parsed
+    /// using <see cref="trrojan::stream::instruction_set_traits" />.
+    /// </summary>
+    TRROJANSTREAM_API const std::string& to_string(const instruction_set isa);
+}
+}
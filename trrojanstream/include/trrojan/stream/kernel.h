@@ -0,0 +1,129 @@
+/// <copyright file="kernel.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "trrojan/stream/export.h"
+#include "trrojan/stream/instruction_set.h"
+#include "trrojan/stream/store_mode.h"
+#include "trrojan/stream/task_type.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// The maximum number of read or write streams of
+    /// <see cref="trrojan::stream::task_type::multi_stream" />.
+    /// </summary>
+    constexpr std::size_t max_streams = 8;
+
+    /// <summary>
+    /// A function performing a streaming task on <paramref name="cnt" />
+    /// items, which are <paramref name="step" /> elements apart.
+    /// </summary>
+    /// <remarks>
+    /// The kernel computes <c>c[i * step]</c> from <c>a[i * step]</c>,
+    /// <c>b[i * step]</c> and <c>s</c> for all <c>i</c> in
+    /// <c>[0, cnt)</c>. <paramref name="chain" /> is the number of
+    /// additional multiply-adds of
+    /// <see cref="trrojan::stream::task_type::fma_chain" />, which is ignored
+    /// by all other tasks.
+    /// </remarks>
+    template<class S> using kernel_type = void (*)(const S *a, const S *b,
+        S *c, const S s, const std::size_t cnt, const std::size_t step,
+        const std::size_t chain);
+
+    /// <summary>
+    /// A function performing a streaming task on <paramref name="cnt" />
+    /// items, whose inputs are gathered via an index buffer.
+    /// </summary>
+    /// <remarks>
+    /// The kernel computes <c>c[i]</c> from <c>a[indices[i]]</c>,
+    /// <c>b[indices[i]]</c> and <c>s</c> for all <c>i</c> in
+    /// <c>[0, cnt)</c>. <paramref name="chain" /> has the same meaning as for
+    /// <see cref="kernel_type" />.
+    /// </remarks>
+    template<class S> using gather_kernel_type = void (*)(const S *a,
+        const S *b, S *c, const S s, const std::uint32_t *indices,
+        const std::size_t cnt, const std::size_t chain);
+
+    /// <summary>
+    /// A function performing
+    /// <see cref="trrojan::stream::task_type::multi_stream" /> on
+    /// <paramref name="cnt" /> items, which are <paramref name="step" />
+    /// elements apart.
+    /// </summary>
+    /// <remarks>
+    /// The kernel computes the sum of <c>reads[r][i * step]</c> over all read
+    /// streams and stores it to <c>writes[w][i * step]</c> of all write
+    /// streams for all <c>i</c> in <c>[0, cnt)</c>. The number of streams is
+    /// fixed by the kernel returned from
+    /// <see cref="trrojan::stream::get_multi_stream_kernel" />.
+    /// </remarks>
+    template<class S> using multi_stream_kernel_type = void (*)(
+        const S *const *reads, S *const *writes, const std::size_t cnt,
+        const std::size_t step);
+
+    /// <summary>
+    /// Gets the kernel for the given task.
+    /// </summary>
+    /// <remarks>
+    /// Vectorised kernels are only used for contiguous accesses, ie if
+    /// <paramref name="step" /> is one. For all other accesses and for
+    /// combinations of scalar type and task that the instruction set cannot
+    /// vectorise, the scalar kernel is returned. The scalar kernel always
+    /// uses regular stores.
+    /// </remarks>
+    /// <param name="isa">The instruction set to use, which must be
+    /// supported.</param>
+    /// <param name="task">The task to be performed.</param>
+    /// <param name="step">The distance between two items.</param>
+    /// <param name="mode">The way the output array is written.</param>
+    /// <returns>The kernel to run.</returns>
+    /// <tparam name="S">The type of a scalar.</tparam>
+    template<class S>
+    kernel_type<S> get_kernel(const instruction_set isa,
+        const task_type task, const std::size_t step,
+        const store_mode mode = store_mode::regular);
+
+    /// <summary>
+    /// Gets the gathering kernel for the given task.
+    /// </summary>
+    /// <param name="task">The task to be performed.</param>
+    /// <returns>The kernel to run.</returns>
+    /// <tparam name="S">The type of a scalar.</tparam>
+    template<class S>
+    gather_kernel_type<S> get_gather_kernel(const task_type task);
+
+    /// <summary>
+    /// Gets the kernel for
+    /// <see cref="trrojan::stream::task_type::multi_stream" />.
+    /// </summary>
+    /// <remarks>
+    /// The same restrictions as for <see cref="get_kernel" /> apply to the
+    /// vectorised kernels.
+    /// </remarks>
+    /// <param name="isa">The instruction set to use, which must be
+    /// supported.</param>
+    /// <param name="reads">The number of input arrays, which must be
+    /// within [1, <see cref="max_streams" />].</param>
+    /// <param name="writes">The number of output arrays, which must be
+    /// within [1, <see cref="max_streams" />].</param>
+    /// <param name="step">The distance between two items.</param>
+    /// <param name="mode">The way the output arrays are written.</param>
+    /// <returns>The kernel to run.</returns>
+    /// <tparam name="S">The type of a scalar.</tparam>
+    template<class S>
+    multi_stream_kernel_type<S> get_multi_stream_kernel(
+        const instruction_set isa, const std::size_t reads,
+        const std::size_t writes, const std::size_t step,
+        const store_mode mode = store_mode::regular);
+}
+}
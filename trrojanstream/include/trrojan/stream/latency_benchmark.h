@@ -0,0 +1,130 @@
+/// <copyright file="latency_benchmark.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include "trrojan/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "trrojan/enum_parse_helper.h"
+#include "trrojan/page_size.h"
+
+#include "trrojan/stream/buffer.h"
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// Measures the load-to-use latency of the memory hierarchy by chasing
+    /// pointers through a randomised ring.
+    /// </summary>
+    /// <remarks>
+    /// <para>The benchmark divides a buffer of the requested working set size
+    /// into slots of <c>stride</c> bytes and links the slots into a single
+    /// cycle in random order. Each load therefore depends on the previous
+    /// one and the hardware prefetchers cannot predict the next address,
+    /// such that the time per access approximates the latency of the level
+    /// of the memory hierarchy the working set fits in.</para>
+    /// <para>The benchmark supports the following
+    /// <see cref="trrojan::factor" />s, which all have reasonable default
+    /// values:</para>
+    /// <list type="bullet">
+    /// <item>
+    /// <term>accesses</term>
+    /// <description>The minimum number of dependent loads per iteration. The
+    /// number is rounded up to full laps through the ring.</description>
+    /// </item>
+    /// <item>
+    /// <term>iterations</term>
+    /// <description>The number of measurements for each configuration. One
+    /// additional lap through the ring warms up the caches and the TLB and
+    /// is not reported.</description>
+    /// </item>
+    /// <item>
+    /// <term>page_size</term>
+    /// <description>The kind of pages backing the buffer. The string
+    /// representation of <see cref="trrojan::page_size" /> must be used for
+    /// this factor. Huge pages remove most TLB misses from the measurement.
+    /// </description>
+    /// </item>
+    /// <item>
+    /// <term>perf_counters</term>
+    /// <description>If <c>true</c>, the hardware performance counters of
+    /// <see cref="trrojan::perf_counter_group" /> are captured around each
+    /// iteration and their average over all iterations is reported.
+    /// </description>
+    /// </item>
+    /// <item>
+    /// <term>stride</term>
+    /// <description>The distance between two slots in bytes, which must be
+    /// at least the size of a pointer.</description>
+    /// </item>
+    /// <item>
+    /// <term>working_set</term>
+    /// <description>The size of the buffer in bytes.</description>
+    /// </item>
+    /// </list>
+    /// </remarks>
+    class TRROJANSTREAM_API latency_benchmark
+            : public trrojan::benchmark_base {
+
+    public:
+
+        typedef benchmark_base::on_result_callback on_result_callback;
+
+        static const std::string factor_accesses;
+        static const std::string factor_iterations;
+        static const std::string factor_page_size;
+        static const std::string factor_perf_counters;
+        static const std::string factor_stride;
+        static const std::string factor_working_set;
+
+        static const std::string result_name_accesses;
+        static const std::string result_name_latency_average;
+        static const std::string result_name_latency_maximum;
+        static const std::string result_name_latency_minimum;
+        static const std::string result_name_time_average;
+        static const std::string result_name_time_maximum;
+        static const std::string result_name_time_minimum;
+
+        latency_benchmark(void);
+
+        virtual ~latency_benchmark(void);
+
+        virtual trrojan::result run(const configuration& config);
+
+    private:
+
+        static inline trrojan::page_size parse_page_size(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<trrojan::page_size, page_size_traits,
+                page_size_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(page_size_list(), value);
+        }
+
+        /// <summary>
+        /// Follows <paramref name="cnt" /> pointers starting at
+        /// <paramref name="start" />.
+        /// </summary>
+        /// <returns>The last slot reached, which must be consumed by the
+        /// caller to prevent the compiler from removing the loop.</returns>
+        static void *chase(void *start, const std::size_t cnt);
+
+        /// <summary>
+        /// Links the slots of <paramref name="buffer" /> into a random cycle.
+        /// </summary>
+        /// <returns>The number of slots in the cycle.</returns>
+        static std::size_t link(trrojan::stream::buffer& buffer,
+            const std::size_t stride);
+    };
+
+}
+}
@@ -0,0 +1,142 @@
+/// <copyright file="memcpy_benchmark.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include "trrojan/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "trrojan/enum_parse_helper.h"
+#include "trrojan/page_size.h"
+
+#include "trrojan/stream/copy_engine.h"
+#include "trrojan/stream/export.h"
+#include "trrojan/stream/thread_placement.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// Compares the throughput of different primitives for copying a block
+    /// of memory.
+    /// </summary>
+    /// <remarks>
+    /// <para>The benchmark copies a source buffer of the requested size into
+    /// a destination buffer. If more than one thread is used, the buffers
+    /// are split into contiguous chunks, which are aligned to cache lines
+    /// and copied simultaneously by the threads. Each thread initialises its
+    /// chunks before the measurement such that the pages are first touched
+    /// on the NUMA node it runs on.</para>
+    /// <para>The results use the names of the aggregated results of the
+    /// <see cref="stream_benchmark" />, one row per iteration. The rates
+    /// count the bytes read and written like the copy task of the stream
+    /// benchmark, ie twice the size of the copy.</para>
+    /// <para>The benchmark supports the following
+    /// <see cref="trrojan::factor" />s, which all have reasonable default
+    /// values:</para>
+    /// <list type="bullet">
+    /// <item>
+    /// <term>engine</term>
+    /// <description>The copy primitive. The string representation of
+    /// <see cref="copy_engine" /> must be used for this factor. By default,
+    /// all engines supported by the machine are compared.</description>
+    /// </item>
+    /// <item>
+    /// <term>iterations</term>
+    /// <description>The number of measurements for each configuration. One
+    /// additional copy warms up the caches and the TLB and is not reported.
+    /// </description>
+    /// </item>
+    /// <item>
+    /// <term>page_size</term>
+    /// <description>The kind of pages backing the buffers. The string
+    /// representation of <see cref="trrojan::page_size" /> must be used for
+    /// this factor.</description>
+    /// </item>
+    /// <item>
+    /// <term>placement</term>
+    /// <description>The policy for pinning the threads to logical
+    /// processors. The string representation of
+    /// <see cref="thread_placement" /> must be used for this factor.
+    /// </description>
+    /// </item>
+    /// <item>
+    /// <term>size</term>
+    /// <description>The number of bytes to copy. Note that twice the
+    /// memory must be available for the source and the destination. By
+    /// default, the size is quadrupled from 4 KiB to 4 GiB.</description>
+    /// </item>
+    /// <item>
+    /// <term>threads</term>
+    /// <description>The number of threads copying the chunks. At most one
+    /// thread per cache line of the buffer is used. By default, one thread
+    /// and one thread per logical processor are compared.</description>
+    /// </item>
+    /// </list>
+    /// </remarks>
+    class TRROJANSTREAM_API memcpy_benchmark
+            : public trrojan::benchmark_base {
+
+    public:
+
+        typedef benchmark_base::on_result_callback on_result_callback;
+
+        static const std::string factor_engine;
+        static const std::string factor_iterations;
+        static const std::string factor_page_size;
+        static const std::string factor_placement;
+        static const std::string factor_size;
+        static const std::string factor_threads;
+
+        /// <summary>
+        /// Answer whether the given engine can be used on this machine.
+        /// </summary>
+        static bool is_supported(const copy_engine engine);
+
+        memcpy_benchmark(void);
+
+        virtual ~memcpy_benchmark(void);
+
+        virtual trrojan::result run(const configuration& config);
+
+    private:
+
+        static inline copy_engine parse_engine(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<copy_engine, copy_engine_traits,
+                copy_engine_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(copy_engine_list(), value);
+        }
+
+        static inline trrojan::page_size parse_page_size(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<trrojan::page_size, page_size_traits,
+                page_size_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(page_size_list(), value);
+        }
+
+        static inline thread_placement parse_placement(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<thread_placement,
+                thread_placement_traits, thread_placement_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(thread_placement_list(), value);
+        }
+
+        /// <summary>
+        /// Copies <paramref name="cnt" /> bytes using <c>rep movsb</c>.
+        /// </summary>
+        static void rep_movsb(void *dst, const void *src,
+            const std::size_t cnt);
+    };
+
+}
+}
@@ -0,0 +1,72 @@
+/// <copyright file="numa_policy.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <string>
+
+#include "trrojan/enum_dispatch_list.h"
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// Possible policies for placing the memory of a rank's slice of the
+    /// problem on NUMA nodes.
+    /// </summary>
+    enum class TRROJANSTREAM_API numa_policy {
+
+        /// <summary>
+        /// Each rank first-touches its own slice, which places the memory on
+        /// the NUMA node of the processor the rank is pinned to.
+        /// </summary>
+        local,
+
+        /// <summary>
+        /// The pages of each slice are distributed round-robin over all NUMA
+        /// nodes of the machine.
+        /// </summary>
+        interleave,
+
+        /// <summary>
+        /// Each slice is placed on a NUMA node other than the one of the
+        /// processor the rank is pinned to, which allows for measuring
+        /// cross-socket bandwidth.
+        /// </summary>
+        remote_node
+    };
+
+
+    /// <summary>
+    /// A traits class for parsing NUMA policies.
+    /// </summary>
+    template<numa_policy P> struct numa_policy_traits { };
+
+#define __TRROJANSTREAM_DECL_NUMA_POLICY_TRAITS(p)                             \
+    template<> struct numa_policy_traits<numa_policy::p> {                     \
+        static inline const std::string& name(void) {                          \
+            static const std::string retval(#p);                               \
+            return retval;                                                     \
+        }                                                                      \
+    }
+
+    __TRROJANSTREAM_DECL_NUMA_POLICY_TRAITS(local);
+    __TRROJANSTREAM_DECL_NUMA_POLICY_TRAITS(interleave);
+    __TRROJANSTREAM_DECL_NUMA_POLICY_TRAITS(remote_node);
+
+#undef __TRROJANSTREAM_DECL_NUMA_POLICY_TRAITS
+
+
+    template<numa_policy... V>
+    using numa_policy_list_t = enum_dispatch_list<numa_policy, V...>;
+
+    typedef numa_policy_list_t<numa_policy::local, numa_policy::interleave,
+        numa_policy::remote_node> numa_policy_list;
+}
+}
@@ -8,19 +8,29 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "trrojan/constants.h"
+#include "trrojan/cpu_topology.h"
+#include "trrojan/page_size.h"
 #include "trrojan/timer.h"
 #include "trrojan/variant.h"
 
 #include "trrojan/stream/access_pattern.h"
+#include "trrojan/stream/buffer.h"
 #include "trrojan/stream/export.h"
+#include "trrojan/stream/instruction_set.h"
+#include "trrojan/stream/numa_policy.h"
 #include "trrojan/stream/scalar_type.h"
+#include "trrojan/stream/scaling.h"
+#include "trrojan/stream/store_mode.h"
 #include "trrojan/stream/task_type.h"
+#include "trrojan/stream/thread_placement.h"
 
 
 namespace trrojan {
@@ -29,14 +39,46 @@ namespace stream {
     /// <summary>
     /// Provides all storage for a stream benchmark problem.
     /// </summary>
+    /// <remarks>
+    /// The storage is not initialised when the problem is created. The
+    /// memory of each rank must be placed using <see cref="bind" /> and
+    /// initialised by the worker thread of the rank using
+    /// <see cref="initialise" />, which ensures that the pages are first
+    /// touched by the thread that is processing them.
+    /// </remarks>
     class TRROJANSTREAM_API problem {
 
     public:
 
         typedef trrojan::stream::access_pattern access_pattern_t;
+        typedef std::uint32_t index_type;
+        typedef trrojan::stream::instruction_set instruction_set_t;
+        typedef trrojan::stream::numa_policy numa_policy_t;
+        typedef trrojan::page_size page_size_t;
         typedef std::shared_ptr<problem> pointer_type;
         typedef trrojan::stream::scalar_type scalar_type_t;
+        typedef trrojan::stream::scaling scaling_t;
+        typedef trrojan::stream::store_mode store_mode_t;
         typedef trrojan::stream::task_type task_type_t;
+        typedef trrojan::stream::thread_placement thread_placement_t;
+
+        /// <summary>
+        /// The size of a cache line, which is assumed for estimating the
+        /// effective bandwidth.
+        /// </summary>
+        static const size_t cache_line_size = 64;
+
+        /// <summary>
+        /// The default number of items in a block of
+        /// <see cref="trrojan::stream::access_pattern::blocked" />.
+        /// </summary>
+        static const size_t default_block_size = 1024;
+
+        /// <summary>
+        /// The default number of additional multiply-adds per item of
+        /// <see cref="trrojan::stream::task_type::fma_chain" />.
+        /// </summary>
+        static const size_t default_chain_length = 8;
 
         /// <summary>
         /// The default value for the number of iterations.
@@ -48,6 +90,130 @@ namespace stream {
         /// </summary>
         static const size_t default_problem_size = 2000000;
 
+        /// <summary>
+        /// The default number of input arrays of
+        /// <see cref="trrojan::stream::task_type::multi_stream" />.
+        /// </summary>
+        static const size_t default_read_streams = 2;
+
+        /// <summary>
+        /// The default distance in items between two items processed using
+        /// <see cref="trrojan::stream::access_pattern::strided" />.
+        /// </summary>
+        static const size_t default_stride = 4;
+
+        /// <summary>
+        /// The default number of output arrays of
+        /// <see cref="trrojan::stream::task_type::multi_stream" />.
+        /// </summary>
+        static const size_t default_write_streams = 1;
+
+        /// <summary>
+        /// The optional properties of a problem, which are initialised with
+        /// their defaults.
+        /// </summary>
+        struct parameters {
+
+            /// <summary>
+            /// The number of items in a block of
+            /// <see cref="trrojan::stream::access_pattern::blocked" />.
+            /// </summary>
+            size_t block_size = default_block_size;
+
+            /// <summary>
+            /// The number of additional multiply-adds per item of
+            /// <see cref="trrojan::stream::task_type::fma_chain" />.
+            /// </summary>
+            size_t chain_length = default_chain_length;
+
+            /// <summary>
+            /// The instruction set of the kernel.
+            /// </summary>
+            instruction_set_t isa = instruction_set_t::scalar;
+
+            /// <summary>
+            /// The number of measurements.
+            /// </summary>
+            size_t iterations = default_iterations;
+
+            /// <summary>
+            /// The placement of the memory of the ranks on the NUMA nodes.
+            /// </summary>
+            numa_policy_t numa = numa_policy_t::local;
+
+            /// <summary>
+            /// The size of the pages backing the arrays.
+            /// </summary>
+            page_size_t pages = page_size_t::regular;
+
+            /// <summary>
+            /// The number of worker threads.
+            /// </summary>
+            size_t parallelism = 1;
+
+            /// <summary>
+            /// Determines whether hardware performance counters are captured.
+            /// </summary>
+            bool perf_counters = false;
+
+            /// <summary>
+            /// The placement of the worker threads on the logical processors.
+            /// </summary>
+            thread_placement_t placement = thread_placement_t::compact;
+
+            /// <summary>
+            /// The number of input arrays of
+            /// <see cref="trrojan::stream::task_type::multi_stream" />.
+            /// </summary>
+            size_t read_streams = default_read_streams;
+
+            /// <summary>
+            /// Determines whether the worker threads are scheduled with
+            /// real-time priority.
+            /// </summary>
+            bool real_time_priority = false;
+
+            /// <summary>
+            /// Determines whether the problem size is the total one or the
+            /// one of each thread.
+            /// </summary>
+            scaling_t scaling = scaling_t::weak;
+
+            /// <summary>
+            /// The number of items, either in total or per thread depending
+            /// on <see cref="scaling" />.
+            /// </summary>
+            size_t size = default_problem_size;
+
+            /// <summary>
+            /// The kind of stores writing the output.
+            /// </summary>
+            store_mode_t store = store_mode_t::regular;
+
+            /// <summary>
+            /// The distance in items between two items processed using
+            /// <see cref="trrojan::stream::access_pattern::strided" />.
+            /// </summary>
+            size_t stride = default_stride;
+
+            /// <summary>
+            /// Determines whether the overhead of the timer is subtracted
+            /// from the measurements.
+            /// </summary>
+            bool subtract_timer_overhead = false;
+
+            /// <summary>
+            /// Determines whether the output is checked after each run.
+            /// </summary>
+            bool verify = false;
+
+            /// <summary>
+            /// The number of output arrays of
+            /// <see cref="trrojan::stream::task_type::multi_stream" />.
+            /// </summary>
+            size_t write_streams = default_write_streams;
+        };
+
         /// <summary>
         /// Creates a new problem with the specified properties.
         /// </summary>
@@ -55,16 +221,14 @@ namespace stream {
             const trrojan::variant& value,
             const task_type_t task,
             const access_pattern_t pattern,
-            const size_t size = default_problem_size,
-            const size_t iterations = default_iterations,
-            const size_t parallelism = 1);
+            const parameters& params);
 
         /// <summary>
         /// Gets the first input array.
         /// </summary>
         /// <returns></returns>
         template<class T> inline T *a(void) {
-            return static_cast<T *>(static_cast<void *>(this->_a.data()));
+            return this->_a.data<T>();
         }
 
         /// <summary>
@@ -83,12 +247,24 @@ namespace stream {
             return this->_access_pattern;
         }
 
+        /// <summary>
+        /// Applies the <see cref="numa_policy" /> to the slices of all ranks
+        /// given the logical processors the ranks are running on.
+        /// </summary>
+        /// <remarks>
+        /// This method must be called before the worker threads
+        /// <see cref="initialise" /> their slices.
+        /// </remarks>
+        /// <param name="processors">The logical processor of each rank.
+        /// </param>
+        void bind(const cpu_topology::processor_list& processors);
+
         /// <summary>
         /// Gets the second input array.
         /// </summary>
         /// <returns></returns>
         template<class T> inline T *b(void) {
-            return static_cast<T *>(static_cast<void *>(this->_b.data()));
+            return this->_b.data<T>();
         }
 
         /// <summary>
@@ -100,12 +276,28 @@ namespace stream {
             return this->b<typename scalar_type_traits<T>::type>();
         }
 
+        /// <summary>
+        /// Answer the number of items in a block if the access pattern is
+        /// <see cref="trrojan::stream::access_pattern::blocked" />.
+        /// </summary>
+        inline size_t block_size(void) const {
+            return this->_block_size;
+        }
+
+        /// <summary>
+        /// Answer the number of additional multiply-adds per item of
+        /// <see cref="trrojan::stream::task_type::fma_chain" />.
+        /// </summary>
+        inline size_t chain_length(void) const {
+            return this->_chain_length;
+        }
+
         /// <summary>
         /// Gets the output array.
         /// </summary>
         /// <returns></returns>
         template<class T> inline T *c(void) {
-            return static_cast<T *>(static_cast<void *>(this->_c.data()));
+            return this->_c.data<T>();
         }
 
         /// <summary>
@@ -117,23 +309,85 @@ namespace stream {
             return this->c<typename scalar_type_traits<T>::type>();
         }
 
+        /// <summary>
+        /// Given the size of this problem, convert the given runtime of a
+        /// thread to billions of arithmetic operations per second.
+        /// </summary>
+        /// <param name="dt">The time one thread took to complete the benchmark
+        /// (in milliseconds).</param>
+        /// <param name="rank">The rank of the thread.</param>
+        /// <returns>The operation rate in GFLOP/s.</returns>
+        inline double calc_thread_gflop_per_s(const timer::millis_type dt,
+                const size_t rank) const {
+            typedef trrojan::constants<double> constants;
+            auto s = dt / constants::millis_per_second;
+            auto f = static_cast<double>(this->useful_flops(rank));
+            return (f / s / 1e9);
+        }
+
         /// <summary>
         /// Given the size of this problem, convert the given runtime of a
         /// thread to MB/s under the assumption that the given number of memory
         /// accesses have been performed for each item.
         /// </summary>
+        /// <remarks>
+        /// This is the useful bandwidth, ie only the scalars the kernel
+        /// actually processes are counted.
+        /// </remarks>
         /// <param name="dt">The time one thread took to complete the benchmark
         /// (in milliseconds).</param>
         /// <param name="cnt_accesses">The number of memory accesses (reads and
         /// writes) per item.</param>
+        /// <param name="rank">The rank of the thread.</param>
         /// <returns>The transfer rate in MB/s.</returns>
         inline double calc_thread_mb_per_s(const timer::millis_type dt,
-                const size_t cnt_accesses) const {
+                const size_t cnt_accesses, const size_t rank) const {
             typedef trrojan::constants<double> constants;
             auto s = dt / constants::millis_per_second;
-            auto m = static_cast<double>(this->size_in_bytes());
+            auto m = static_cast<double>(this->useful_bytes(cnt_accesses,
+                rank));
             m /= constants::bytes_per_megabyte;
-            return (m / s * cnt_accesses);
+            return (m / s);
+        }
+
+        /// <summary>
+        /// Given the size of this problem, convert the given runtime of a
+        /// thread to the effective MB/s, which includes the whole cache lines
+        /// the memory subsystem must transfer for the accesses.
+        /// </summary>
+        /// <param name="dt">The time one thread took to complete the benchmark
+        /// (in milliseconds).</param>
+        /// <param name="cnt_accesses">The number of memory accesses (reads and
+        /// writes) per item.</param>
+        /// <param name="rank">The rank of the thread.</param>
+        /// <returns>The transfer rate in MB/s.</returns>
+        inline double calc_thread_effective_mb_per_s(
+                const timer::millis_type dt, const size_t cnt_accesses,
+                const size_t rank) const {
+            typedef trrojan::constants<double> constants;
+            auto s = dt / constants::millis_per_second;
+            auto m = static_cast<double>(this->effective_bytes(cnt_accesses,
+                rank));
+            m /= constants::bytes_per_megabyte;
+            return (m / s);
+        }
+
+        /// <summary>
+        /// Given the size of this problem, convert the given total runtime to
+        /// billions of arithmetic operations per second of all threads.
+        /// </summary>
+        /// <param name="dt">The time it took to complete the benchmark (in
+        /// milliseconds).</param>
+        /// <returns>The operation rate in GFLOP/s.</returns>
+        inline double calc_total_gflop_per_s(
+                const timer::millis_type dt) const {
+            typedef trrojan::constants<double> constants;
+            auto s = dt / constants::millis_per_second;
+            auto f = 0.0;
+            for (size_t r = 0; r < this->_parallelism; ++r) {
+                f += static_cast<double>(this->useful_flops(r));
+            }
+            return (f / s / 1e9);
         }
 
         /// <summary>
@@ -150,9 +404,122 @@ namespace stream {
                 const size_t cnt_accesses) const {
             typedef trrojan::constants<double> constants;
             auto s = dt / constants::millis_per_second;
-            auto m = static_cast<double>(this->total_size_in_bytes());
+            auto m = 0.0;
+            for (size_t r = 0; r < this->_parallelism; ++r) {
+                m += static_cast<double>(this->useful_bytes(cnt_accesses, r));
+            }
             m /= constants::bytes_per_megabyte;
-            return (m / s * cnt_accesses);
+            return (m / s);
+        }
+
+        /// <summary>
+        /// Given the size of this problem, convert the given total runtime to
+        /// the effective MB/s of all threads.
+        /// </summary>
+        /// <param name="dt">The time it took to complete the benchmark (in
+        /// milliseconds).</param>
+        /// <param name="cnt_accesses">The number of memory accesses (reads and
+        /// writes) per item.</param>
+        /// <returns>The transfer rate in MB/s.</returns>
+        inline double calc_total_effective_mb_per_s(
+                const timer::millis_type dt, const size_t cnt_accesses) const {
+            typedef trrojan::constants<double> constants;
+            auto s = dt / constants::millis_per_second;
+            auto m = 0.0;
+            for (size_t r = 0; r < this->_parallelism; ++r) {
+                m += static_cast<double>(this->effective_bytes(cnt_accesses,
+                    r));
+            }
+            m /= constants::bytes_per_megabyte;
+            return (m / s);
+        }
+
+        /// <summary>
+        /// Answer the number of bytes a single thread transfers from and to
+        /// memory in one iteration, including the unused parts of cache lines
+        /// and the index buffer.
+        /// </summary>
+        /// <param name="cnt_accesses">The number of memory accesses (reads and
+        /// writes) per item.</param>
+        /// <param name="rank">The rank of the thread.</param>
+        size_t effective_bytes(const size_t cnt_accesses,
+            const size_t rank) const;
+
+        /// <summary>
+        /// Answer the number of arithmetic operations the task performs per
+        /// item, including the chain of
+        /// <see cref="trrojan::stream::task_type::fma_chain" />.
+        /// </summary>
+        size_t flops_per_item(void) const;
+
+        /// <summary>
+        /// Answer the number of bytes of all arrays the task touches in one
+        /// iteration, including the index buffer of random accesses.
+        /// </summary>
+        /// <remarks>
+        /// This is the working set of all threads together, which must fit
+        /// into a cache for the benchmark to measure the cache rather than
+        /// the memory.
+        /// </remarks>
+        size_t footprint(void) const;
+
+        /// <summary>
+        /// Gets the index buffer used by
+        /// <see cref="trrojan::stream::access_pattern::random" />, which holds
+        /// a permutation of the items of each rank relative to the begin of
+        /// its slice.
+        /// </summary>
+        inline index_type *indices(void) {
+            return this->_indices.data<index_type>();
+        }
+
+        /// <summary>
+        /// Fills the slice of the given rank with input data.
+        /// </summary>
+        /// <remarks>
+        /// This method should be called by the worker thread of
+        /// <paramref name="rank" /> such that the pages are placed on its NUMA
+        /// node if the <see cref="numa_policy" /> is
+        /// <see cref="trrojan::stream::numa_policy::local" />.
+        /// </remarks>
+        /// <param name="rank">The rank of the calling thread.</param>
+        void initialise(const size_t rank);
+
+        /// <summary>
+        /// Answer the number of items the given rank processes in one
+        /// iteration, which depends on the access pattern.
+        /// </summary>
+        /// <param name="rank">The rank of the thread.</param>
+        size_t items(const size_t rank) const;
+
+        /// <summary>
+        /// Answer the number of scalars read or written per item.
+        /// </summary>
+        size_t memory_accesses(void) const;
+
+        /// <summary>
+        /// Answer the instruction set of the kernels processing the problem.
+        /// </summary>
+        inline instruction_set_t instruction_set(void) const {
+            return this->_instruction_set;
+        }
+
+        /// <summary>
+        /// Answer the index of the first item in the slice of the given rank.
+        /// </summary>
+        /// <remarks>
+        /// The slices are the contiguous parts of the arrays that are
+        /// initialised by the ranks and placed on their NUMA nodes. For
+        /// interleaved and blocked accesses, the ranks do not process the
+        /// items of their slices.
+        /// </remarks>
+        /// <param name="rank">The rank of the thread.</param>
+        inline size_t offset(const size_t rank) const {
+            assert(rank < this->_parallelism);
+            const auto total = this->total_size();
+            const auto remainder = total % this->_parallelism;
+            return (rank * (total / this->_parallelism)
+                + (std::min)(rank, remainder));
         }
 
         /// <summary>
@@ -162,6 +529,29 @@ namespace stream {
             return this->_iterations;
         }
 
+        /// <summary>
+        /// Answer the policy for placing the memory of the ranks on NUMA
+        /// nodes.
+        /// </summary>
+        inline numa_policy_t numa_policy(void) const {
+            return this->_numa_policy;
+        }
+
+        /// <summary>
+        /// Answer the kind of pages requested for the arrays.
+        /// </summary>
+        inline page_size_t page_size(void) const {
+            return this->_a.pages();
+        }
+
+        /// <summary>
+        /// Answer whether the worker threads should capture hardware
+        /// performance counters around each iteration.
+        /// </summary>
+        inline bool perf_counters(void) const {
+            return this->_perf_counters;
+        }
+
         /// <summary>
         /// Answer for how many threads the problem is intended.
         /// </summary>
@@ -170,6 +560,49 @@ namespace stream {
             return this->_parallelism;
         }
 
+        /// <summary>
+        /// Answer the policy for pinning the worker threads to logical
+        /// processors.
+        /// </summary>
+        inline thread_placement_t placement(void) const {
+            return this->_placement;
+        }
+
+        /// <summary>
+        /// Answer whether the worker threads should be scheduled with
+        /// real-time priority.
+        /// </summary>
+        inline bool real_time_priority(void) const {
+            return this->_real_time_priority;
+        }
+
+        /// <summary>
+        /// Gets the input array with the given index.
+        /// </summary>
+        /// <remarks>
+        /// The first two input arrays are <see cref="a" /> and
+        /// <see cref="b" />. Only
+        /// <see cref="trrojan::stream::task_type::multi_stream" /> has more
+        /// of them.
+        /// </remarks>
+        template<class T> inline T *read_stream(const size_t i) {
+            switch (i) {
+                case 0: return this->_a.data<T>();
+                case 1: return this->_b.data<T>();
+                default:
+                    assert(i < this->_read_streams);
+                    return this->_streams[i - 2].data<T>();
+            }
+        }
+
+        /// <summary>
+        /// Answer the number of input arrays of
+        /// <see cref="trrojan::stream::task_type::multi_stream" />.
+        /// </summary>
+        inline size_t read_streams(void) const {
+            return this->_read_streams;
+        }
+
         /// <summary>
         /// Gets the scalar value
         /// </summary>
@@ -204,24 +637,51 @@ namespace stream {
         }
 
         /// <summary>
-        /// Answer the problem size (in number of elements) for a single thread.
+        /// Answer how the problem size relates to the number of threads.
         /// </summary>
-        /// <returns></returns>
-        inline size_t size(void) const {
-            auto s = this->total_size_in_bytes();
-            auto sp = (this->_scalar_size * this->_parallelism);
-            assert(s % sp == 0);
-            return (s / sp);
+        inline scaling_t scaling(void) const {
+            return this->_scaling;
         }
 
         /// <summary>
-        /// Answer the problem size (in bytes) for a single thread.
+        /// Answer the number of items (in number of elements) in the slice of
+        /// the given rank.
+        /// </summary>
+        /// <remarks>
+        /// If the total size is not divisible by the number of threads, the
+        /// first ranks hold one item more than the others.
+        /// </remarks>
+        /// <param name="rank">The rank of the thread.</param>
+        inline size_t size(const size_t rank) const {
+            assert(rank < this->_parallelism);
+            const auto total = this->total_size();
+            const auto remainder = total % this->_parallelism;
+            return ((total / this->_parallelism)
+                + ((rank < remainder) ? 1 : 0));
+        }
+
+        /// <summary>
+        /// Answer the size of the slice of the given rank in bytes.
         /// </summary>
-        inline size_t size_in_bytes(void) const {
-            assert(this->_a.size() == this->_b.size());
-            assert(this->_a.size() == this->_c.size());
-            assert(this->_a.size() % this->_parallelism == 0);
-            return (this->_a.size() / this->_parallelism);
+        /// <param name="rank">The rank of the thread.</param>
+        inline size_t size_in_bytes(const size_t rank) const {
+            return (this->size(rank) * this->_scalar_size);
+        }
+
+        /// <summary>
+        /// Answer how the output array is written.
+        /// </summary>
+        inline store_mode_t store_mode(void) const {
+            return this->_store_mode;
+        }
+
+        /// <summary>
+        /// Answer the distance in items between two items processed if the
+        /// access pattern is
+        /// <see cref="trrojan::stream::access_pattern::strided" />.
+        /// </summary>
+        inline size_t stride(void) const {
+            return this->_stride;
         }
 
         /// <summary>
@@ -250,9 +710,72 @@ namespace stream {
             return this->_a.size();
         }
 
+        /// <summary>
+        /// Answer the number of bytes of scalars the given rank actually
+        /// processes in one iteration.
+        /// </summary>
+        /// <param name="cnt_accesses">The number of memory accesses (reads and
+        /// writes) per item.</param>
+        /// <param name="rank">The rank of the thread.</param>
+        inline size_t useful_bytes(const size_t cnt_accesses,
+                const size_t rank) const {
+            return (this->items(rank) * this->_scalar_size * cnt_accesses);
+        }
+
+        /// <summary>
+        /// Answer the number of arithmetic operations the given rank performs
+        /// in one iteration.
+        /// </summary>
+        /// <param name="rank">The rank of the thread.</param>
+        inline size_t useful_flops(const size_t rank) const {
+            return (this->items(rank) * this->flops_per_item());
+        }
+
+        /// <summary>
+        /// Answer whether the calibrated overhead of the timer should be
+        /// subtracted from the measured times.
+        /// </summary>
+        inline bool subtract_timer_overhead(void) const {
+            return this->_subtract_timer_overhead;
+        }
+
+        /// <summary>
+        /// Answer whether the worker threads should check the output of the
+        /// last iteration.
+        /// </summary>
+        inline bool verify(void) const {
+            return this->_verify;
+        }
+
+        /// <summary>
+        /// Gets the output array with the given index.
+        /// </summary>
+        /// <remarks>
+        /// The first output array is <see cref="c" />. Only
+        /// <see cref="trrojan::stream::task_type::multi_stream" /> has more
+        /// of them.
+        /// </remarks>
+        template<class T> inline T *write_stream(const size_t i) {
+            if (i == 0) {
+                return this->_c.data<T>();
+            } else {
+                assert(i < this->_write_streams);
+                return this->_streams[this->extra_read_streams() + i - 1]
+                    .data<T>();
+            }
+        }
+
+        /// <summary>
+        /// Answer the number of output arrays of
+        /// <see cref="trrojan::stream::task_type::multi_stream" />.
+        /// </summary>
+        inline size_t write_streams(void) const {
+            return this->_write_streams;
+        }
+
     private:
 
-        typedef std::vector<std::uint8_t> problem_type;
+        typedef trrojan::stream::buffer problem_type;
 
         /// <summary>
         /// Allocates <see cref="trrojan::stream::problem::_a" />,
@@ -260,7 +783,22 @@ namespace stream {
         /// <see cref="trrojan::stream::problem::_c" /> to hold
         /// <paramref name="cnt" /> elements of type <tparamref name="T" />.
         /// </summary>
-        template<scalar_type_t T> void allocate(size_t cnt);
+        template<scalar_type_t T> void allocate(size_t cnt,
+            const page_size_t pages);
+
+        /// <summary>
+        /// Answer the number of input arrays in
+        /// <see cref="trrojan::stream::problem::_streams" />.
+        /// </summary>
+        inline size_t extra_read_streams(void) const {
+            return (this->_read_streams > 2) ? (this->_read_streams - 2) : 0;
+        }
+
+        /// <summary>
+        /// Fills the slice of <paramref name="rank" /> with random numbers of
+        /// type <tparamref name="T" />.
+        /// </summary>
+        template<scalar_type_t T> void initialise(const size_t rank);
 
         /// <summary>
         /// The first input array.
@@ -277,21 +815,70 @@ namespace stream {
         /// </summary>
         problem_type _b;
 
+        /// <summary>
+        /// The number of items in a block of blocked accesses.
+        /// </summary>
+        size_t _block_size;
+
         /// <summary>
         /// The output array.
         /// </summary>
         problem_type _c;
 
+        /// <summary>
+        /// The number of additional multiply-adds per item of
+        /// <see cref="trrojan::stream::task_type::fma_chain" />.
+        /// </summary>
+        size_t _chain_length;
+
+        /// <summary>
+        /// The index buffer for random accesses, which is empty for all other
+        /// access patterns.
+        /// </summary>
+        problem_type _indices;
+
+        /// <summary>
+        /// The instruction set of the kernels processing the problem.
+        /// </summary>
+        instruction_set_t _instruction_set;
+
         /// <summary>
         /// The number of iterations to perform for the same problem.
         /// </summary>
         size_t _iterations;
 
+        /// <summary>
+        /// The policy for placing the memory on NUMA nodes.
+        /// </summary>
+        numa_policy_t _numa_policy;
+
         /// <summary>
         /// The number of threads the problem is for.
         /// </summary>
         size_t _parallelism;
 
+        /// <summary>
+        /// Determines whether hardware performance counters are captured.
+        /// </summary>
+        bool _perf_counters;
+
+        /// <summary>
+        /// The policy for pinning the worker threads to logical processors.
+        /// </summary>
+        thread_placement_t _placement;
+
+        /// <summary>
+        /// The number of input arrays of
+        /// <see cref="trrojan::stream::task_type::multi_stream" />.
+        /// </summary>
+        size_t _read_streams;
+
+        /// <summary>
+        /// Determines whether the worker threads are scheduled with real-time
+        /// priority.
+        /// </summary>
+        bool _real_time_priority;
+
         /// <summary>
         /// Remembers the size of a single scalar.
         /// </summary>
@@ -307,10 +894,50 @@ namespace stream {
         /// </summary>
         trrojan::variant _scalar_value;
 
+        /// <summary>
+        /// Determines how the problem size relates to the number of threads.
+        /// </summary>
+        scaling_t _scaling;
+
+        /// <summary>
+        /// Determines how the output array is written.
+        /// </summary>
+        store_mode_t _store_mode;
+
+        /// <summary>
+        /// The input arrays after <see cref="_a" /> and <see cref="_b" />
+        /// followed by the output arrays after <see cref="_c" />, which are
+        /// only allocated for
+        /// <see cref="trrojan::stream::task_type::multi_stream" />.
+        /// </summary>
+        std::vector<problem_type> _streams;
+
+        /// <summary>
+        /// The distance in items between two items of strided accesses.
+        /// </summary>
+        size_t _stride;
+
+        /// <summary>
+        /// Determines whether the overhead of the timer is subtracted from
+        /// the measured times.
+        /// </summary>
+        bool _subtract_timer_overhead;
+
         /// <summary>
         /// The task to be performed on the memory.
         /// </summary>
         task_type_t _task_type;
+
+        /// <summary>
+        /// Determines whether the output is checked after the last iteration.
+        /// </summary>
+        bool _verify;
+
+        /// <summary>
+        /// The number of output arrays of
+        /// <see cref="trrojan::stream::task_type::multi_stream" />.
+        /// </summary>
+        size_t _write_streams;
     };
 
 }
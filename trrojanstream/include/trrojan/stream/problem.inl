@@ -9,24 +9,62 @@
  * trrojan::stream::problem::allocate
  */
 template<trrojan::stream::problem::scalar_type_t T>
-void trrojan::stream::problem::allocate(size_t cnt) {
+void trrojan::stream::problem::allocate(size_t cnt,
+        const page_size_t pages) {
     typedef typename scalar_type_traits<T>::type type;
+    assert(this->_parallelism > 0);
 
-    if (this->_parallelism < 1) {
-        this->_parallelism = 1;
-    }
     if (cnt < 1) {
         cnt = 1;
     }
 
     this->_scalar_size = sizeof(type);
 
-    cnt = cnt * this->_parallelism;
-    this->_a.resize(cnt * this->_scalar_size);
-    this->_b.resize(cnt * this->_scalar_size);
-    this->_c.resize(cnt * this->_scalar_size);
+    // Note: the memory is not touched here, which is done by the worker
+    // threads in 'initialise'.
+    this->_a.allocate(cnt * this->_scalar_size, pages);
+    this->_b.allocate(cnt * this->_scalar_size, pages);
+    this->_c.allocate(cnt * this->_scalar_size, pages);
+
+    this->_streams.clear();
+    if (this->_task_type == task_type_t::multi_stream) {
+        this->_streams.resize(this->extra_read_streams()
+            + this->_write_streams - 1);
+        for (auto& s : this->_streams) {
+            s.allocate(cnt * this->_scalar_size, pages);
+        }
+    }
+}
 
-    std::srand(std::time(nullptr));
-    std::generate(this->a<type>(), this->a<type>() + cnt, std::rand);
-    std::generate(this->b<type>(), this->b<type>() + cnt, std::rand);
+
+/*
+ * trrojan::stream::problem::initialise
+ */
+template<trrojan::stream::problem::scalar_type_t T>
+void trrojan::stream::problem::initialise(const size_t rank) {
+    typedef typename scalar_type_traits<T>::type type;
+    assert(rank < this->_parallelism);
+    assert(sizeof(type) == this->_scalar_size);
+
+    const auto cnt = this->size(rank);
+    const auto offset = this->offset(rank);
+    std::minstd_rand rng(static_cast<std::minstd_rand::result_type>(
+        std::time(nullptr)) + static_cast<std::minstd_rand::result_type>(rank));
+    auto generate = [&rng](void) { return static_cast<type>(rng()); };
+
+    std::generate(this->a<type>() + offset, this->a<type>() + offset + cnt,
+        generate);
+    std::generate(this->b<type>() + offset, this->b<type>() + offset + cnt,
+        generate);
+    std::fill(this->c<type>() + offset, this->c<type>() + offset + cnt,
+        static_cast<type>(0));
+
+    for (size_t i = 0; i < this->_streams.size(); ++i) {
+        auto s = this->_streams[i].data<type>() + offset;
+        if (i < this->extra_read_streams()) {
+            std::generate(s, s + cnt, generate);
+        } else {
+            std::fill(s, s + cnt, static_cast<type>(0));
+        }
+    }
 }
@@ -0,0 +1,63 @@
+/// <copyright file="scaling.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <string>
+
+#include "trrojan/enum_dispatch_list.h"
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// Determines how the problem size relates to the number of threads.
+    /// </summary>
+    enum class TRROJANSTREAM_API scaling {
+
+        /// <summary>
+        /// The problem size is the number of items per thread, ie the total
+        /// working set grows with the number of threads.
+        /// </summary>
+        weak,
+
+        /// <summary>
+        /// The problem size is the total number of items, which is split
+        /// into one chunk per thread. If the size is not divisible by the
+        /// number of threads, the first ranks process one item more.
+        /// </summary>
+        strong
+    };
+
+
+    /// <summary>
+    /// A traits class for parsing scaling modes.
+    /// </summary>
+    template<scaling S> struct scaling_traits { };
+
+#define __TRROJANSTREAM_DECL_SCALING_TRAITS(s)                                 \
+    template<> struct scaling_traits<scaling::s> {                             \
+        static inline const std::string& name(void) {                          \
+            static const std::string retval(#s);                               \
+            return retval;                                                     \
+        }                                                                      \
+    }
+
+    __TRROJANSTREAM_DECL_SCALING_TRAITS(weak);
+    __TRROJANSTREAM_DECL_SCALING_TRAITS(strong);
+
+#undef __TRROJANSTREAM_DECL_SCALING_TRAITS
+
+
+    template<scaling... V>
+    using scaling_list_t = enum_dispatch_list<scaling, V...>;
+
+    typedef scaling_list_t<scaling::weak, scaling::strong> scaling_list;
+}
+}
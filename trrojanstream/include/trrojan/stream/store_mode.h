@@ -0,0 +1,70 @@
+/// <copyright file="store_mode.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <string>
+
+#include "trrojan/enum_dispatch_list.h"
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// Possible ways of writing the output array.
+    /// </summary>
+    enum class TRROJANSTREAM_API store_mode {
+
+        /// <summary>
+        /// Regular stores through the cache hierarchy, which cause a
+        /// read-for-ownership of every cache line that is not yet cached.
+        /// </summary>
+        regular,
+
+        /// <summary>
+        /// Non-temporal (streaming) stores, which bypass the caches and avoid
+        /// the read-for-ownership traffic.
+        /// </summary>
+        non_temporal,
+
+        /// <summary>
+        /// Non-temporal stores followed by a store fence, which includes the
+        /// time for draining the write-combining buffers in the measurement.
+        /// </summary>
+        non_temporal_sfence
+    };
+
+
+    /// <summary>
+    /// A traits class for parsing store modes.
+    /// </summary>
+    template<store_mode M> struct store_mode_traits { };
+
+#define __TRROJANSTREAM_DECL_STORE_MODE_TRAITS(m)                              \
+    template<> struct store_mode_traits<store_mode::m> {                       \
+        static inline const std::string& name(void) {                          \
+            static const std::string retval(#m);                               \
+            return retval;                                                     \
+        }                                                                      \
+    }
+
+    __TRROJANSTREAM_DECL_STORE_MODE_TRAITS(regular);
+    __TRROJANSTREAM_DECL_STORE_MODE_TRAITS(non_temporal);
+    __TRROJANSTREAM_DECL_STORE_MODE_TRAITS(non_temporal_sfence);
+
+#undef __TRROJANSTREAM_DECL_STORE_MODE_TRAITS
+
+
+    template<store_mode... V>
+    using store_mode_list_t = enum_dispatch_list<store_mode, V...>;
+
+    typedef store_mode_list_t<store_mode::regular, store_mode::non_temporal,
+        store_mode::non_temporal_sfence> store_mode_list;
+}
+}
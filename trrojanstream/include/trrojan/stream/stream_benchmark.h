@@ -13,7 +13,12 @@
 #include <cassert>
 #include <iterator>
 #include <limits>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "trrojan/enum_parse_helper.h"
 #include "trrojan/timer.h"
@@ -50,10 +55,44 @@ namespace stream {
     /// details on the respective behaviour.</description>
     /// </item>
     /// <item>
+    /// <term>block_size</term>
+    /// <description>The number of consecutive items in a block if the access
+    /// pattern is <see cref="trrojan::stream::access_pattern::blocked" />.
+    /// The problem size will be rounded up to full blocks.</description>
+    /// </item>
+    /// <item>
+    /// <term>chain_length</term>
+    /// <description>The number of dependent multiply-adds performed after the
+    /// triad for each item if the task is
+    /// <see cref="trrojan::stream::task_type::fma_chain" />. Sweeping this
+    /// factor varies the arithmetic intensity without changing the memory
+    /// accesses.</description>
+    /// </item>
+    /// <item>
+    /// <term>detailed_results</term>
+    /// <description>If <c>true</c>, the benchmark reports one measurement for
+    /// each iteration of each thread instead of aggregating the threads of
+    /// an iteration. See below for the results reported in this mode.
+    /// </description>
+    /// </item>
+    /// <item>
     /// <term>threads</term>
     /// <description>The number of threads to use simultaneously. Note that at
-    /// must one thread per logical core must be started. The problem size will
-    /// be scaled by the number of threads.</description>
+    /// must one thread per logical core must be started. For weak scaling, the
+    /// problem size will be scaled by the number of threads. If the string
+    /// "auto" is specified, the benchmark sweeps the thread counts where the
+    /// placement starts using another package or another hardware thread of
+    /// the cores, the number of physical and logical cores and the powers of
+    /// two in between. Combined with a placement, this yields the whole
+    /// scaling curve of the machine.</description>
+    /// </item>
+    /// <item>
+    /// <term>instruction_set</term>
+    /// <description>The instruction set of the kernels used for contiguous
+    /// accesses. The string representation of
+    /// <see cref="trrojan::stream::instruction_set" /> must be used for this
+    /// factor. By default, the most capable instruction set supported by the
+    /// CPU is used.</description>
     /// </item>
     /// <item>
     /// <term>iterations</term>
@@ -63,13 +102,65 @@ namespace stream {
     /// results.</description>
     /// </item>
     /// <item>
-    /// <term>problem_size</term>
-    /// <description>The problem size in number of items to be processed.
+    /// <term>numa_policy</term>
+    /// <description>The policy for placing the memory of each thread on the
+    /// NUMA nodes of the system. The string representation of
+    /// <see cref="trrojan::stream::numa_policy" /> must be used for this
+    /// factor. By default, each thread first-touches its own slice such that
+    /// it is allocated locally.</description>
+    /// </item>
+    /// <item>
+    /// <term>page_size</term>
+    /// <description>The kind of virtual memory pages backing the arrays. The
+    /// string representation of <see cref="trrojan::page_size" /> must be
+    /// used for this factor. Comparing regular and huge pages shows the
+    /// effect of TLB misses on the platform. If the requested pages are not
+    /// available, smaller ones are used and a warning is issued.</description>
+    /// </item>
+    /// <item>
+    /// <term>perf_counters</term>
+    /// <description>If <c>true</c>, the hardware performance counters of
+    /// <see cref="trrojan::perf_counter_group" /> are captured around each
+    /// iteration and reported summed over all threads. Counters that are not
+    /// available on the system are omitted from the results.</description>
+    /// </item>
+    /// <item>
+    /// <term>placement</term>
+    /// <description>The policy for pinning the worker threads to logical
+    /// processors. The string representation of
+    /// <see cref="trrojan::stream::thread_placement" /> must be used for this
+    /// factor. By default, each thread is pinned to its own physical core.
     /// </description>
     /// </item>
     /// <item>
+    /// <term>problem_size</term>
+    /// <description>The problem size in number of items. For weak scaling,
+    /// this is the number of items processed by each thread, for strong
+    /// scaling, it is the total number of items that is split between the
+    /// threads. Any positive number is supported. If the string "auto" is
+    /// specified, the benchmark sweeps log-spaced sizes from well below the
+    /// smallest to well above the largest data cache of the CPU.</description>
+    /// </item>
+    /// <item>
+    /// <term>real_time_priority</term>
+    /// <description>If <c>true</c>, the worker threads are scheduled with
+    /// real-time priority on Linux, which requires <c>CAP_SYS_NICE</c>. As
+    /// the threads busy-wait at the barrier, this can starve the rest of the
+    /// system if there are more threads than available processors.
+    /// Therefore, the factor defaults to <c>false</c>.</description>
+    /// </item>
+    /// <item>
+    /// <term>read_write_ratio</term>
+    /// <description>The number of input and output arrays of
+    /// <see cref="trrojan::stream::task_type::multi_stream" /> as a string of
+    /// the form "reads:writes", eg "3:1" for summing up three arrays into
+    /// one. Both numbers must be within [1, 8]. The factor is ignored by the
+    /// other tasks and defaults to "2:1".</description>
+    /// </item>
+    /// <item>
     /// <term>scalar</term>
     /// <description>The scalar value used for the tasks
+    /// <see cref="trrojan::stream::task_type::fma_chain" />,
     /// <see cref="trrojan::stream::task_type::scale" /> and
     /// <see cref="trrojan::stream::task_type::triad" />. The string
     /// representation of <see cref="trrojan::stream::task_type" /> must be
@@ -82,12 +173,80 @@ namespace stream {
     /// factor.</description>
     /// </item>
     /// <item>
+    /// <term>scaling</term>
+    /// <description>Determines whether the problem size is per thread or
+    /// split between the threads. The string representation of
+    /// <see cref="trrojan::stream::scaling" /> must be used for this factor.
+    /// By default, each thread processes its own buffer of the given problem
+    /// size.</description>
+    /// </item>
+    /// <item>
+    /// <term>stride</term>
+    /// <description>The distance in items between two items processed if the
+    /// access pattern is
+    /// <see cref="trrojan::stream::access_pattern::strided" />.</description>
+    /// </item>
+    /// <item>
+    /// <term>store_mode</term>
+    /// <description>Determines whether the output is written using regular
+    /// or non-temporal (streaming) stores. The string representation of
+    /// <see cref="trrojan::stream::store_mode" /> must be used for this
+    /// factor. Non-temporal stores are only used for contiguous accesses.
+    /// </description>
+    /// </item>
+    /// <item>
+    /// <term>subtract_timer_overhead</term>
+    /// <description>If <c>true</c>, the calibrated overhead of reading the
+    /// timer (see <see cref="trrojan::timer::calibrate" />) is subtracted
+    /// from the time measured for each thread. This is only relevant for
+    /// problems that fit into the caches and are processed within a few
+    /// microseconds. This factor defaults to <c>false</c>.</description>
+    /// </item>
+    /// <item>
     /// <term>task_type</term>
     /// <description>The task to be performed. The string representation
     /// of <see cref="trrojan::stream::task_type" /> must be used for this
     /// factor.</description>
     /// </item>
+    /// <item>
+    /// <term>verify</term>
+    /// <description>If <c>true</c>, each thread checks the items it has
+    /// written in the last iteration against the scalar kernel after the
+    /// measurement. The outcome is reported in the result column
+    /// "verified", which is empty if no check was requested. This factor
+    /// defaults to <c>false</c>.</description>
+    /// </item>
     /// </list>
+    /// <para>The rates reported by the benchmark are the useful bandwidth,
+    /// which only counts the scalars processed by the kernel. The effective
+    /// rates also count the parts of the cache lines that are transferred,
+    /// but not used, and the index buffer of random accesses.</para>
+    /// <para>The flop rates are reported in GFLOP/s and count the arithmetic
+    /// operations of the task, where a multiply-add counts as two. Together
+    /// with the arithmetic intensity, which is the number of operations per
+    /// useful byte, they allow for placing each configuration on a roofline
+    /// plot.</para>
+    /// <para>The barrier skew is the time between the first and the last
+    /// thread arriving at the barrier that starts an iteration, ie the load
+    /// imbalance of the previous iteration. The start range is the time
+    /// between the first and the last thread leaving this barrier.</para>
+    /// <para>In detailed mode, each measurement holds the iteration, the
+    /// rank of the thread and the logical processor it is pinned to. The
+    /// arrival and start offsets are relative to the release of the barrier,
+    /// which is when the last thread arrived. Therefore, the arrival offset
+    /// is the time the thread waited as a negative number and the start
+    /// offset is the time the thread needed to be released. The rates are
+    /// the bandwidth of the individual thread.</para>
+    /// <para>The parallel efficiency is the total rate divided by the number
+    /// of threads and the average total rate of the single-threaded run of
+    /// the same configuration. If the configuration set does not contain the
+    /// single-threaded run before the multi-threaded ones, it is measured on
+    /// demand. The result is only remembered while running the same
+    /// configuration set.</para>
+    /// <para>The cache level is the smallest data cache the working set of
+    /// all arrays fits in, or "memory" if it fits in none. For caches that
+    /// are shared by several logical processors, the working set of all
+    /// threads that might share an instance is considered.</para>
     /// </remarks>
     class TRROJANSTREAM_API stream_benchmark : public trrojan::benchmark_base {
 
@@ -96,24 +255,58 @@ namespace stream {
         typedef benchmark_base::on_result_callback on_result_callback;
 
         static const std::string factor_access_pattern;
+        static const std::string factor_block_size;
+        static const std::string factor_chain_length;
+        static const std::string factor_detailed_results;
+        static const std::string factor_instruction_set;
         static const std::string factor_iterations;
+        static const std::string factor_numa_policy;
+        static const std::string factor_page_size;
+        static const std::string factor_perf_counters;
+        static const std::string factor_placement;
         static const std::string factor_problem_size;
+        static const std::string factor_read_write_ratio;
+        static const std::string factor_real_time_priority;
         static const std::string factor_scalar;
         static const std::string factor_scalar_type;
+        static const std::string factor_scaling;
+        static const std::string factor_store_mode;
+        static const std::string factor_stride;
+        static const std::string factor_subtract_timer_overhead;
         static const std::string factor_task_type;
         static const std::string factor_threads;
+        static const std::string factor_verify;
 
+        static const std::string result_name_arithmetic_intensity;
+        static const std::string result_name_arrival_offset;
+        static const std::string result_name_barrier_skew;
+        static const std::string result_name_cache_level;
+        static const std::string result_name_flop_rate;
+        static const std::string result_name_flop_rate_aggregated;
+        static const std::string result_name_flop_rate_total;
+        static const std::string result_name_flops;
+        static const std::string result_name_iteration;
+        static const std::string result_name_parallel_efficiency;
+        static const std::string result_name_processor;
+        static const std::string result_name_rank;
+        static const std::string result_name_rate;
         static const std::string result_name_rate_aggregated;
         static const std::string result_name_rate_average;
+        static const std::string result_name_rate_effective;
+        static const std::string result_name_rate_effective_aggregated;
+        static const std::string result_name_rate_effective_total;
         static const std::string result_name_rate_maximum;
         static const std::string result_name_rate_minimum;
         static const std::string result_name_rate_total;
         static const std::string result_name_range_start;
         static const std::string result_name_range_total;
+        static const std::string result_name_start_offset;
+        static const std::string result_name_time;
         static const std::string result_name_time_average;
         static const std::string result_name_time_maximum;
         static const std::string result_name_time_minimum;
         static const std::string result_name_time_slowest;
+        static const std::string result_name_verified;
 
         stream_benchmark(void);
 
@@ -121,14 +314,20 @@ namespace stream {
 
         virtual size_t run(const configuration_set& configs,
             const on_result_callback& callback,
-            const cool_down& coolDown);
+            const cool_down& coolDown,
+            const std::size_t continue_at);
 
         virtual trrojan::result run(const configuration& config);
 
+    protected:
+
+        virtual std::vector<configuration> expand_configuration(
+            const configuration& c);
+
     private:
 
         template<access_pattern A>
-        using ap_traits = trrojan::stream::access_pattern_traits<A, 0>;
+        using ap_traits = trrojan::stream::access_pattern_traits<A>;
 
         static inline access_pattern parse_access_pattern(
                 const trrojan::named_variant& s) {
@@ -138,6 +337,37 @@ namespace stream {
             return parser::parse(access_pattern_list(), value);
         }
 
+        static inline instruction_set parse_instruction_set(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<instruction_set, instruction_set_traits,
+                instruction_set_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(instruction_set_list(), value);
+        }
+
+        static inline numa_policy parse_numa_policy(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<numa_policy, numa_policy_traits,
+                numa_policy_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(numa_policy_list(), value);
+        }
+
+        static inline trrojan::page_size parse_page_size(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<trrojan::page_size, page_size_traits,
+                page_size_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(page_size_list(), value);
+        }
+
+        /// <summary>
+        /// Parses the number of read and write streams from a string of the
+        /// form "reads:writes".
+        /// </summary>
+        static std::pair<std::size_t, std::size_t> parse_read_write_ratio(
+            const trrojan::named_variant& s);
+
         static inline scalar_type parse_scalar_type(
                 const trrojan::named_variant& s) {
             typedef enum_parse_helper<scalar_type, scalar_type_traits,
@@ -146,6 +376,30 @@ namespace stream {
             return parser::parse(scalar_type_list(), value);
         }
 
+        static inline trrojan::stream::scaling parse_scaling(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<trrojan::stream::scaling, scaling_traits,
+                scaling_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(scaling_list(), value);
+        }
+
+        static inline thread_placement parse_thread_placement(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<thread_placement,
+                thread_placement_traits, thread_placement_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(thread_placement_list(), value);
+        }
+
+        static inline store_mode parse_store_mode(
+                const trrojan::named_variant& s) {
+            typedef enum_parse_helper<store_mode, store_mode_traits,
+                store_mode_list_t> parser;
+            auto value = s.value().as<std::string>();
+            return parser::parse(store_mode_list(), value);
+        }
+
         static inline task_type parse_task_type(
                 const trrojan::named_variant& s) {
             typedef enum_parse_helper<task_type, task_type_traits,
@@ -154,12 +408,53 @@ namespace stream {
             return parser::parse(task_type_list(), value);
         }
 
+        /// <summary>
+        /// The value of <see cref="factor_problem_size" /> that requests a
+        /// sweep over the cache hierarchy.
+        /// </summary>
+        static const std::string auto_problem_size;
+
+        static std::vector<std::uint64_t> auto_problem_sizes(
+            const configuration& c);
+
+        /// <summary>
+        /// The value of <see cref="factor_threads" /> that requests a sweep
+        /// over the processor topology.
+        /// </summary>
+        static const std::string auto_threads;
+
+        static std::vector<std::uint32_t> auto_thread_counts(
+            const configuration& c);
+
+        static double average_rate_total(const trrojan::result& result);
+
+        static std::string baseline_key(const configuration& c);
+
+        static std::string cache_level(const problem& problem);
+
+        static bool is_auto_problem_size(const configuration& c);
+
+        static bool is_auto_threads(const configuration& c);
+
         static trrojan::stream::problem::pointer_type to_problem(
             const configuration& c);
 
         template<class I>trrojan::result collect_results(
+            const configuration& config, problem::pointer_type problem,
+            I begin, I end, const double baseline);
+
+        template<class I>trrojan::result collect_detailed_results(
             const configuration& config, problem::pointer_type problem,
             I begin, I end);
+
+        double baseline(const configuration& c);
+
+        /// <summary>
+        /// The average total rate of the single-threaded runs measured in
+        /// the current configuration set, indexed by
+        /// <see cref="baseline_key" />.
+        /// </summary>
+        std::map<std::string, double> _baselines;
     };
 
 }
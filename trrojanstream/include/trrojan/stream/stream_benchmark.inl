@@ -11,7 +11,7 @@
 template<class I>
 trrojan::result trrojan::stream::stream_benchmark::collect_results(
         const configuration& config, problem::pointer_type problem,
-        I begin, I end) {
+        I begin, I end, const double baseline) {
     typedef std::numeric_limits<timer::millis_type> timer_limits;
 
     assert(problem != nullptr);
@@ -23,7 +23,16 @@ trrojan::result trrojan::stream::stream_benchmark::collect_results(
         result_name_time_average, result_name_time_minimum,
         result_name_rate_minimum, result_name_rate_average,
         result_name_rate_maximum, result_name_rate_total,
-        result_name_rate_aggregated };
+        result_name_rate_aggregated, result_name_rate_effective_total,
+        result_name_rate_effective_aggregated, result_name_flop_rate_total,
+        result_name_flop_rate_aggregated, result_name_flops,
+        result_name_arithmetic_intensity, result_name_barrier_skew,
+        result_name_parallel_efficiency, result_name_cache_level,
+        result_name_verified };
+    std::vector<basic_result::result_type> rows;
+    std::vector<double> totalRates;
+    auto cacheLevel = stream_benchmark::cache_level(*problem);
+    auto verified = true;
     worker_thread::results_type results;
 
     // Get the results for all iterations of all threads. The array 'results'
@@ -33,10 +42,29 @@ trrojan::result trrojan::stream::stream_benchmark::collect_results(
     cntThreads = 0;
     for (auto it = begin; it != end; ++it) {
         (**it).copy_results(std::back_inserter(results));
+        verified = verified && (**it).verified();
         ++cntThreads;
     }
     assert(results.size() == cntThreads * cntResults);
 
+    // Sum up the hardware performance counters of all threads for each
+    // iteration. Only counters that are valid for any thread are reported.
+    std::vector<perf_counter_group::values_type> counters(cntResults,
+        perf_counter_group::invalid_values());
+    for (size_t i = 0; i < cntResults; ++i) {
+        for (size_t t = 0; t < cntThreads; ++t) {
+            perf_counter_group::accumulate(counters[i],
+                results[(t * cntResults) + i].counters);
+        }
+    }
+    // The columns are the counters that are valid in any iteration, because
+    // a multiplexed counter might not have been scheduled in all of them.
+    auto columns = perf_counter_group::invalid_values();
+    for (auto& c : counters) {
+        perf_counter_group::accumulate(columns, c);
+    }
+    perf_counter_group::append_result_names(names, columns);
+
     //for (size_t i = 0; i < cntThreads; ++i) {
     //    names.emplace_back(result_name_rate + std::to_string(i));
     //}
@@ -51,13 +79,21 @@ trrojan::result trrojan::stream::stream_benchmark::collect_results(
         auto accesses = results[i].memory_accesses; // Consistent over threads!
         //assert(accesses >= 2);
         //assert(accesses <= 3);
+        auto minArrival = (timer_limits::max)();
+        auto maxArrival = (timer_limits::min)();
         auto minStart = (timer_limits::max)();
         auto maxStart = (timer_limits::min)();
         auto maxStop = (timer_limits::min)();
         auto minTime = (timer_limits::max)();
         auto maxTime = (timer_limits::min)();
+        auto minRate = (std::numeric_limits<double>::max)();
+        auto maxRate = 0.0;
         auto sumTime = static_cast<timer::millis_type>(0);
         auto sumRate = 0.0;
+        auto sumEffRate = 0.0;
+        auto sumFlopRate = 0.0;
+        auto flops = static_cast<std::size_t>(0);
+        auto bytes = static_cast<std::size_t>(0);
 
         for (size_t t = 0; t < cntThreads; ++t) {
             auto idx = (t * cntResults) + i;
@@ -65,6 +101,16 @@ trrojan::result trrojan::stream::stream_benchmark::collect_results(
             auto start = timer::millis_since_epoch(results[idx].start);
             auto time = results[idx].time;
             auto stop = start + time;
+            auto arrival = timer::millis_since_epoch(results[idx].arrival);
+
+            // The range of the arrivals at the barrier shows the imbalance
+            // between the threads in the previous iteration.
+            if (arrival < minArrival) {
+                minArrival = arrival;
+            }
+            if (arrival > maxArrival) {
+                maxArrival = arrival;
+            }
 
             // Compute range of start values, because this variance is
             // interesting.
@@ -87,17 +133,38 @@ trrojan::result trrojan::stream::stream_benchmark::collect_results(
                 maxTime = time;
             }
 
+            // The ranks might process a different number of items for strong
+            // scaling, so the extreme rates are not necessarily the ones of
+            // the extreme times.
+            auto rate = problem->calc_thread_mb_per_s(time, accesses, t);
+            if (rate < minRate) {
+                minRate = rate;
+            }
+            if (rate > maxRate) {
+                maxRate = rate;
+            }
+
             sumTime += time;
-            sumRate += problem->calc_thread_mb_per_s(time, accesses);
+            sumRate += rate;
+            sumEffRate += problem->calc_thread_effective_mb_per_s(time,
+                accesses, t);
+            sumFlopRate += problem->calc_thread_gflop_per_s(time, t);
+            flops += problem->useful_flops(t);
+            bytes += problem->useful_bytes(accesses, t);
         }
 
+        auto barrierSkew = maxArrival - minArrival;
         auto rangeStart = maxStart - minStart;
         auto rangeTotal = maxStop - minStart;
         auto avgTime = (sumTime / cntThreads);
-        auto minRate = problem->calc_thread_mb_per_s(maxTime, accesses);
         auto avgRate = (sumRate / cntThreads);
-        auto maxRate = problem->calc_thread_mb_per_s(minTime, accesses);
-        auto totalRate = problem->calc_thread_mb_per_s(rangeTotal, accesses);
+        auto totalRate = problem->calc_total_mb_per_s(rangeTotal, accesses);
+        auto totalEffRate = problem->calc_total_effective_mb_per_s(
+            rangeTotal, accesses);
+        auto totalFlopRate = problem->calc_total_gflop_per_s(rangeTotal);
+        auto intensity = (bytes > 0)
+            ? static_cast<double>(flops) / static_cast<double>(bytes)
+            : 0.0;
 
 #if (defined(DEBUG) || defined(_DEBUG))
         std::cout << "iteration " << i
@@ -115,8 +182,122 @@ trrojan::result trrojan::stream::stream_benchmark::collect_results(
             << std::endl;
 #endif /* (defined(DEBUG) || defined(_DEBUG)) */
 
-        retval->add({ rangeStart, rangeTotal, maxTime, avgTime,
-            minTime, minRate, avgRate, maxRate, totalRate, sumRate });
+        rows.push_back({ rangeStart, rangeTotal, maxTime, avgTime, minTime,
+            minRate, avgRate, maxRate, totalRate, sumRate, totalEffRate,
+            sumEffRate, totalFlopRate, sumFlopRate, flops, intensity,
+            barrierSkew });
+        totalRates.push_back(totalRate);
+    }
+
+    // The efficiency of the single-threaded run is relative to its own
+    // average. For weak scaling, the work grows with the number of threads,
+    // for strong scaling, it does not, but in both cases, an ideal speedup
+    // multiplies the total rate by the number of threads.
+    auto reference = baseline;
+    if ((reference <= 0.0) && (cntThreads == 1) && !totalRates.empty()) {
+        reference = std::accumulate(totalRates.begin(), totalRates.end(), 0.0)
+            / totalRates.size();
+    }
+
+    for (size_t i = 0; i < cntResults; ++i) {
+        auto& values = rows[i];
+        if (reference > 0.0) {
+            values.emplace_back(totalRates[i] / (cntThreads * reference));
+        } else {
+            values.emplace_back();
+        }
+        values.emplace_back(cacheLevel);
+        if (problem->verify()) {
+            values.emplace_back(verified);
+        } else {
+            values.emplace_back();
+        }
+        perf_counter_group::append_results(values, counters[i], columns);
+        retval->add(values);
+    }
+
+    return std::dynamic_pointer_cast<result::element_type>(retval);
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::collect_detailed_results
+ */
+template<class I>
+trrojan::result trrojan::stream::stream_benchmark::collect_detailed_results(
+        const configuration& config, problem::pointer_type problem,
+        I begin, I end) {
+    typedef std::numeric_limits<timer::millis_type> timer_limits;
+
+    assert(problem != nullptr);
+    auto cntResults = problem->iterations();
+    std::vector<worker_thread::results_type> results;
+    std::vector<std::string> names = { result_name_iteration,
+        result_name_rank, result_name_processor, result_name_arrival_offset,
+        result_name_start_offset, result_name_time, result_name_rate,
+        result_name_rate_effective, result_name_flop_rate,
+        result_name_cache_level, result_name_verified };
+
+    // Get the results of each thread separately, which are in order of the
+    // ranks.
+    std::vector<bool> verified;
+    for (auto it = begin; it != end; ++it) {
+        verified.push_back((**it).verified());
+        results.emplace_back();
+        results.back().reserve(cntResults);
+        (**it).copy_results(std::back_inserter(results.back()));
+        assert(results.back().size() == cntResults);
+    }
+
+    // The placement is deterministic, so we can reconstruct which logical
+    // processor the ranks have been pinned to.
+    auto processors = worker_thread::place(*problem);
+    assert(processors.size() >= results.size());
+
+    // The counters are reported in the columns that are valid for any
+    // thread, because the system-wide ones are only captured by one rank.
+    auto columns = perf_counter_group::invalid_values();
+    for (auto& r : results) {
+        for (auto& i : r) {
+            perf_counter_group::accumulate(columns, i.counters);
+        }
+    }
+    perf_counter_group::append_result_names(names, columns);
+
+    auto retval = std::make_shared<basic_result>(config, std::move(names));
+    auto cacheLevel = stream_benchmark::cache_level(*problem);
+
+    for (size_t i = 0; i < cntResults; ++i) {
+        // The barrier released the threads when the last one arrived.
+        auto release = (timer_limits::min)();
+        for (auto& r : results) {
+            auto arrival = timer::millis_since_epoch(r[i].arrival);
+            if (arrival > release) {
+                release = arrival;
+            }
+        }
+
+        for (size_t t = 0; t < results.size(); ++t) {
+            auto& r = results[t][i];
+            auto arrival = timer::millis_since_epoch(r.arrival) - release;
+            auto start = timer::millis_since_epoch(r.start) - release;
+            auto rate = problem->calc_thread_mb_per_s(r.time,
+                r.memory_accesses, t);
+            auto effRate = problem->calc_thread_effective_mb_per_s(r.time,
+                r.memory_accesses, t);
+            auto flopRate = problem->calc_thread_gflop_per_s(r.time, t);
+
+            basic_result::result_type values = { i, t, processors[t].id,
+                arrival, start, r.time, rate, effRate, flopRate,
+                cacheLevel };
+            if (problem->verify()) {
+                values.emplace_back(static_cast<bool>(verified[t]));
+            } else {
+                values.emplace_back();
+            }
+            perf_counter_group::append_results(values, r.counters, columns);
+            retval->add(values);
+        }
     }
 
     return std::dynamic_pointer_cast<result::element_type>(retval);
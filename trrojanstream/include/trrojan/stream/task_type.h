@@ -29,6 +29,22 @@ namespace stream {
         /// </summary>
         copy,
 
+        /// <summary>
+        /// Perform a triad followed by a configurable number of dependent
+        /// multiply-adds of the scalar and the second array, which allows for
+        /// increasing the arithmetic intensity without changing the memory
+        /// accesses.
+        /// </summary>
+        fma_chain,
+
+        /// <summary>
+        /// Sum up the items of a configurable number of input arrays and
+        /// store the sum in a configurable number of output arrays, which
+        /// allows for testing how many concurrent streams the prefetchers and
+        /// write-combining buffers can handle.
+        /// </summary>
+        multi_stream,
+
         /// <summary>
         /// Multiply numbers from an array with a scalar value and store the
         /// result in another array.
@@ -46,21 +62,37 @@ namespace stream {
     /// <summary>
     /// A traits class for parsing task types.
     /// </summary>
+    /// <remarks>
+    /// <para><c>memory_accesses</c> is the number of scalars read or written
+    /// per item.</para>
+    /// <para><c>flops</c> is the number of arithmetic operations per item,
+    /// where a multiply-add counts as two operations. Each additional link of
+    /// <see cref="task_type::fma_chain" /> adds <c>chain_flops</c> to it.
+    /// Operations on integers are counted the same way.</para>
+    /// <para>The memory accesses and operations of
+    /// <see cref="task_type::multi_stream" /> depend on the number of streams
+    /// and are therefore zero here. They are computed by
+    /// <see cref="trrojan::stream::problem" /> instead.</para>
+    /// </remarks>
     template<task_type S> struct task_type_traits { };
 
-#define __TRROJANCORE_DECL_TASK_TYPE_TRAITS(t, a)                              \
+#define __TRROJANCORE_DECL_TASK_TYPE_TRAITS(t, a, f, c)                        \
     template<> struct task_type_traits<task_type::t> {                         \
         static const size_t memory_accesses = a;                               \
+        static const size_t flops = f;                                         \
+        static const size_t chain_flops = c;                                   \
         static inline const std::string& name(void) {                          \
             static const std::string retval(#t);                               \
             return retval;                                                     \
         }                                                                      \
     }
 
-    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(add, 3);
-    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(copy, 2);
-    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(scale, 2);
-    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(triad, 3);
+    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(add, 3, 1, 0);
+    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(copy, 2, 0, 0);
+    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(fma_chain, 3, 2, 2);
+    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(multi_stream, 0, 0, 0);
+    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(scale, 2, 1, 0);
+    __TRROJANCORE_DECL_TASK_TYPE_TRAITS(triad, 3, 2, 0);
 
 #undef __TRROJANCORE_DECL_TASK_TYPE_TRAITS
 
@@ -69,6 +101,8 @@ namespace stream {
     using task_type_list_t = enum_dispatch_list<task_type, V...>;
 
     typedef task_type_list_t<task_type::add, task_type::copy,
-        task_type::scale, task_type::triad> task_type_list;
+        task_type::fma_chain, task_type::multi_stream, task_type::scale,
+        task_type::triad>
+        task_type_list;
 }
 }
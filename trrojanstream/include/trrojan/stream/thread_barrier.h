@@ -0,0 +1,128 @@
+/// <copyright file="thread_barrier.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// A reusable barrier for a fixed number of threads, which spins for a
+    /// bounded time before the waiting threads are parked in the kernel.
+    /// </summary>
+    /// <remarks>
+    /// <para>The barrier is sense-reversing: each thread remembers the
+    /// generation it arrived in and waits until the last thread has arrived
+    /// and advanced the generation. Therefore, the barrier can be reused
+    /// immediately without a second phase for resetting it.</para>
+    /// <para>Spinning allows for releasing all threads within a few
+    /// nanoseconds, but steals cycles from the threads that are still
+    /// running if they share a core with a spinning thread or if there are
+    /// more threads than logical processors. Therefore, threads stop
+    /// spinning after <see cref="spin_time" /> and wait on the generation
+    /// using a futex on Linux and <c>WaitOnAddress</c> on Windows.</para>
+    /// </remarks>
+    class TRROJANSTREAM_API thread_barrier {
+
+    public:
+
+        /// <summary>
+        /// The type used to specify the spin time.
+        /// </summary>
+        typedef std::chrono::nanoseconds duration_type;
+
+        /// <summary>
+        /// The default time a thread spins before it is parked.
+        /// </summary>
+        static const duration_type default_spin_time;
+
+        /// <summary>
+        /// Initialises a new instance.
+        /// </summary>
+        /// <param name="parallelism">The number of threads that must arrive
+        /// at the barrier before all of them are released.</param>
+        /// <param name="spin_time">The time a thread spins before it is
+        /// parked. If zero, threads are parked immediately.</param>
+        /// <exception cref="std::invalid_argument">If
+        /// <paramref name="parallelism" /> is zero.</exception>
+        explicit thread_barrier(const std::size_t parallelism,
+            const duration_type spin_time = default_spin_time);
+
+        thread_barrier(const thread_barrier&) = delete;
+
+        /// <summary>
+        /// Blocks the calling thread until all threads have arrived at the
+        /// barrier.
+        /// </summary>
+        void arrive_and_wait(void);
+
+        /// <summary>
+        /// Answer the number of threads synchronised by the barrier.
+        /// </summary>
+        inline std::size_t parallelism(void) const {
+            return this->_parallelism;
+        }
+
+        /// <summary>
+        /// Answer the time a thread spins before it is parked.
+        /// </summary>
+        inline duration_type spin_time(void) const {
+            return this->_spin_time;
+        }
+
+        thread_barrier& operator =(const thread_barrier&) = delete;
+
+    private:
+
+        /// <summary>
+        /// Parks the calling thread while <paramref name="word" /> has the
+        /// given <paramref name="value" />. The method may return spuriously.
+        /// </summary>
+        static void park(std::atomic<std::uint32_t>& word,
+            const std::uint32_t value);
+
+        /// <summary>
+        /// Wakes all threads parked on <paramref name="word" />.
+        /// </summary>
+        static void wake_all(std::atomic<std::uint32_t>& word);
+
+        /// <summary>
+        /// The number of threads that have arrived in the current generation.
+        /// </summary>
+        alignas(64) std::atomic<std::uint32_t> _arrived;
+
+        /// <summary>
+        /// The generation of the barrier, which is advanced by the last
+        /// thread arriving and which is the word the threads are parked on.
+        /// </summary>
+        alignas(64) std::atomic<std::uint32_t> _generation;
+
+        /// <summary>
+        /// The number of threads that are parked or about to be parked.
+        /// </summary>
+        std::atomic<std::uint32_t> _parked;
+
+        /// <summary>
+        /// The number of threads synchronised by the barrier.
+        /// </summary>
+        std::uint32_t _parallelism;
+
+        /// <summary>
+        /// The time a thread spins before it is parked.
+        /// </summary>
+        duration_type _spin_time;
+    };
+
+}
+}
@@ -0,0 +1,73 @@
+/// <copyright file="thread_placement.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <string>
+
+#include "trrojan/enum_dispatch_list.h"
+
+#include "trrojan/stream/export.h"
+
+
+namespace trrojan {
+namespace stream {
+
+    /// <summary>
+    /// Possible policies for pinning the worker threads to logical processors.
+    /// </summary>
+    enum class TRROJANSTREAM_API thread_placement {
+
+        /// <summary>
+        /// Each rank is pinned to its own physical core, filling the first
+        /// package (socket) before using the next one. SMT siblings are only
+        /// used once all physical cores are busy.
+        /// </summary>
+        compact,
+
+        /// <summary>
+        /// Each rank is pinned to its own physical core, but consecutive ranks
+        /// are distributed round-robin over the packages. SMT siblings are
+        /// only used once all physical cores are busy.
+        /// </summary>
+        scatter,
+
+        /// <summary>
+        /// All hardware threads of a physical core are filled before the next
+        /// core is used, ie consecutive ranks share a core.
+        /// </summary>
+        smt_siblings
+    };
+
+
+    /// <summary>
+    /// A traits class for parsing thread placement policies.
+    /// </summary>
+    template<thread_placement P> struct thread_placement_traits { };
+
+#define __TRROJANSTREAM_DECL_THREAD_PLACEMENT_TRAITS(p)                        \
+    template<> struct thread_placement_traits<thread_placement::p> {           \
+        static inline const std::string& name(void) {                          \
+            static const std::string retval(#p);                               \
+            return retval;                                                     \
+        }                                                                      \
+    }
+
+    __TRROJANSTREAM_DECL_THREAD_PLACEMENT_TRAITS(compact);
+    __TRROJANSTREAM_DECL_THREAD_PLACEMENT_TRAITS(scatter);
+    __TRROJANSTREAM_DECL_THREAD_PLACEMENT_TRAITS(smt_siblings);
+
+#undef __TRROJANSTREAM_DECL_THREAD_PLACEMENT_TRAITS
+
+
+    template<thread_placement... V>
+    using thread_placement_list_t = enum_dispatch_list<thread_placement, V...>;
+
+    typedef thread_placement_list_t<thread_placement::compact,
+        thread_placement::scatter, thread_placement::smt_siblings>
+        thread_placement_list;
+}
+}
@@ -16,10 +16,12 @@
 #include <climits>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <system_error>
+#include <type_traits>
 #include <vector>
 
 #ifdef _WIN32
@@ -29,15 +31,18 @@
 #endif /* _WIN32 */
 
 #include "trrojan/constants.h"
-#include "trrojan/index_sequence.h"
+#include "trrojan/cpu_topology.h"
 #include "trrojan/log.h"
+#include "trrojan/perf_counters.h"
 #include "trrojan/timer.h"
 
 #include "trrojan/stream/access_pattern.h"
 #include "trrojan/stream/export.h"
+#include "trrojan/stream/kernel.h"
 #include "trrojan/stream/problem.h"
 #include "trrojan/stream/scalar_type.h"
 #include "trrojan/stream/task_type.h"
+#include "trrojan/stream/thread_barrier.h"
 
 #if defined(_MSC_VER)
 #define TRROJANSTREAM_FORCE_INLINE __forceinline
@@ -55,26 +60,22 @@ namespace stream {
     /// A worker thread performing the benchmarking.
     /// </summary>
     /// <remarks>
-    /// <para>The worker thread provides implementations of pre-defined problem
-    /// sizes, which are implemented as templates instantiated at compile time.
-    /// The reason for that is that loops with dynamic (runtime) bounds cannot
-    /// be optimised by the compile in the same way as static ones can.
-    /// Therefore, allowing arbitrary problem sizes would cause significant
-    /// overhead for evaluating the loop conditions (the operations actually
-    /// performed and measured are mostly a few instructions which are quickly
-    /// outweighed by the programme flow control). The problem sizes the
-    /// implementation provides can be controlled by adjusting the
-    /// <see cref="trrojan::stream::problem_sizes" /> instantiation below.
-    /// </para>
-    /// <para>Our implementation of the memory streaming benchmark scales the
-    /// user-defined problem size (number of elements to be copied) by the
-    /// number of threads used (weak scaling). The reason for that is that we
-    /// can ensure this way that the total problem size is always divisible by
-    /// the number of threads and that in turn the threads should need
-    /// approximately the same time to complete the task (minimise load
-    /// imbalance). As we cannot assume that the throughput actually increases
-    /// as the number of cores increases, we think this is a reasonable
-    /// simplification.</para>
+    /// <para>The worker thread runs the kernels returned by
+    /// <see cref="trrojan::stream::get_kernel" />, which work on runtime-sized
+    /// ranges. The kernels for contiguous accesses are hand-vectorised and
+    /// unrolled, which keeps the overhead for evaluating the loop conditions
+    /// low compared to the few instructions actually performed and measured.
+    /// Therefore, any problem size can be used.</para>
+    /// <para>By default, our implementation of the memory streaming benchmark
+    /// scales the user-defined problem size (number of elements to be copied)
+    /// by the number of threads used (weak scaling). The reason for that is
+    /// that we can ensure this way that the total problem size is always
+    /// divisible by the number of threads and that in turn the threads should
+    /// need approximately the same time to complete the task (minimise load
+    /// imbalance). For strong scaling, the problem size is split between the
+    /// threads and the first ranks process one additional item if it is not
+    /// divisible by the number of threads, which is reported by
+    /// <see cref="trrojan::stream::problem::size" /> for each rank.</para>
     /// </remarks>
     class TRROJANSTREAM_API worker_thread {
 
@@ -97,6 +98,17 @@ namespace stream {
             /// </remarks>
             size_t memory_accesses;
 
+            /// <summary>
+            /// The hardware performance counters captured around the run,
+            /// which are all invalid unless the problem requests them.
+            /// </summary>
+            trrojan::perf_counter_group::values_type counters;
+
+            /// <summary>
+            /// The time the thread arrived at the barrier before the run.
+            /// </summary>
+            trrojan::timer::value_type arrival;
+
             /// <summary>
             /// The start time of the specific run.
             /// </summary>
@@ -109,26 +121,15 @@ namespace stream {
         };
 
         /// <summary>
-        /// A spin lock used as a barrier to ensure simultaneous memory access.
+        /// A barrier used to ensure simultaneous memory access.
         /// </summary>
-        typedef std::shared_ptr<std::atomic<int>> barrier_type;
+        typedef std::shared_ptr<thread_barrier> barrier_type;
 
         /// <summary>
         /// A pointer to a <see cref="worker_thread" />.
         /// </summary>
         typedef std::shared_ptr<worker_thread> pointer_type;
 
-        /// <summary>
-        /// The type to specify problem sizes.
-        /// </summary>
-        typedef std::uint64_t problem_size_type;
-
-        /// <summary>
-        /// The list of available problem sizes.
-        /// </summary>
-        typedef trrojan::integer_sequence<problem_size_type,
-            2000000, 2000000, 10000000, 20000000> problem_sizes;
-
         /// <summary>
         /// The type of a problem to be processed by a thread.
         /// </summary>
@@ -156,6 +157,44 @@ namespace stream {
         /// </summary>
         static std::vector<pointer_type> create(problem_type problem);
 
+        /// <summary>
+        /// Determines the logical processor each rank of the given problem
+        /// should be pinned to according to its
+        /// <see cref="trrojan::stream::problem::placement" />.
+        /// </summary>
+        /// <remarks>
+        /// If the problem requests more threads than there are logical
+        /// processors, the assignment wraps around and the processors are
+        /// oversubscribed.
+        /// </remarks>
+        /// <param name="problem">The problem to compute the placement for.
+        /// </param>
+        /// <returns>The logical processor for each rank.</returns>
+        static cpu_topology::processor_list place(const problem& problem);
+
+        /// <summary>
+        /// Determines the logical processor each of
+        /// <paramref name="parallelism" /> ranks should be pinned to
+        /// according to the given <paramref name="placement" />.
+        /// </summary>
+        /// <remarks>
+        /// This overload allows for placing threads that do not work on a
+        /// <see cref="trrojan::stream::problem" />.
+        /// </remarks>
+        static cpu_topology::processor_list place(
+            const thread_placement placement, const size_t parallelism);
+
+        /// <summary>
+        /// Pins the calling thread to the given logical processor.
+        /// </summary>
+        /// <remarks>
+        /// This allows for pinning threads that are not worker threads, but
+        /// run on the same logical processors.
+        /// </remarks>
+        /// <exception cref="std::system_error">If the affinity could not be
+        /// set.</exception>
+        static void pin(const cpu_topology::logical_processor& processor);
+
         /// <summary>
         /// Join all worker threads in the specified range.
         /// </summary>
@@ -170,21 +209,38 @@ namespace stream {
         /// Creates a pre-initialised barriert for the given number of threads
         /// working on the same problem.
         /// </summary>
+        /// <remarks>
+        /// If there are more threads than logical processors, the threads
+        /// waiting at the barrier do not spin, because they would steal the
+        /// processors from the threads still running.
+        /// </remarks>
         /// <param name="parallelism"></param>
         /// <returns></returns>
-        static inline barrier_type make_barrier(const size_t parallelism) {
-            return std::make_shared<barrier_type::element_type>(
-                static_cast<int>(parallelism));
-        }
+        static barrier_type make_barrier(const size_t parallelism);
 
         /// <summary>
         /// Verifies that <paramref name="c"> holds the results of the specified
         /// task <tparamref name="T" /> executed on <paramref name="a" /> and
         /// <paramref name="b" />.
         /// </summary>
+        /// <remarks>
+        /// The expected results are computed in blocks by the scalar kernel,
+        /// which the compiler can vectorise. Floating-point results are
+        /// compared with a relative tolerance, because the vectorised kernels
+        /// may use fused multiply-adds.
+        /// </remarks>
+        /// <param name="cnt">The number of items to check.</param>
+        /// <param name="step">The distance between two items.</param>
+        /// <param name="chain">The length of the chain of
+        /// <see cref="trrojan::stream::task_type::fma_chain" />.</param>
+        /// <param name="indices">If not <c>nullptr</c>, the inputs of the
+        /// contiguous output items are gathered from <paramref name="a" />
+        /// and <paramref name="b" /> via this index buffer and
+        /// <paramref name="step" /> must be one.</param>
         template<class S, task_type T>
         static bool verify(const S *a, const S *b, const S *c, const S s,
-            const size_t cnt);
+            const size_t cnt, const size_t step, const size_t chain,
+            const problem::index_type *indices = nullptr);
 
         /// <summary>
         /// Verifies that <paramref name="c"> holds the results of the specified
@@ -193,12 +249,26 @@ namespace stream {
         /// </summary>
         template<class S>
         static bool verify(const S *a, const S *b, const S *c, const S s,
-            const size_t cnt, const task_type task);
+            const size_t cnt, const size_t step, const size_t chain,
+            const task_type task,
+            const problem::index_type *indices = nullptr);
+
+        /// <summary>
+        /// Verifies that each of the <paramref name="writes" /> holds the
+        /// results of <see cref="trrojan::stream::task_type::multi_stream" />
+        /// executed on the <paramref name="reads" />.
+        /// </summary>
+        /// <param name="cnt">The number of items to check.</param>
+        /// <param name="step">The distance between two items.</param>
+        template<class S>
+        static bool verify(const S *const *reads, const size_t cnt_reads,
+            const S *const *writes, const size_t cnt_writes,
+            const size_t cnt, const size_t step);
 
         /// <summary>
         /// Initialises a new instance.
         /// </summary>
-        inline worker_thread(void) : hThread(0), rank(0) { }
+        inline worker_thread(void) : hThread(0), rank(0), _verified(false) { }
 
         worker_thread(const worker_thread&) = delete;
 
@@ -225,140 +295,53 @@ namespace stream {
             const rank_type rank, const uint64_t affinity_mask = 0,
             const uint16_t affinity_group = 0);
 
-        worker_thread& operator =(const worker_thread&) = delete;
-
-    private:
-
         /// <summary>
-        /// The type of a native thread handle.
-        /// </summary>
-#ifdef _WIN32
-        typedef HANDLE handle_type;
-#else /* _WIN32 */
-        typedef pthread_t handle_type;
-#endif /* _WIN32 */
-
-        /// <summary>
-        /// This functor expands the testing loop at compile time to remove any
-        /// overhead for control flow checks (which outweighs the actual tests
-        /// performed by far) from the benchmark.
+        /// Answer whether the output of the thread has been verified
+        /// successfully.
         /// </summary>
         /// <remarks>
-        /// We are going the template way here, because compilers usually cannot
-        /// unroll loops with dynamic (runtime-defined) boundaries. Therefore,
-        /// the loop boundaries must be hardcoded. Using a template allows us to
-        /// provide several different pre-compiled problem sizes.
+        /// The result is only meaningful after the thread has been joined and
+        /// if the problem requested a
+        /// <see cref="trrojan::stream::problem::verify" />.
         /// </remarks>
-        /// <tparam name="N">The problem size (number of elements in each array
-        /// per thread).</tparam>
-        /// <tparam name="S">The scalar type stored in the arrays.</tparam>
-        /// <tparam name="T">The type of test to be performed.</tparam>
-        template<int N, scalar_type S, task_type T> struct step {
-            typedef typename scalar_type_traits<S>::type scalar_type;
-
-            // TODO: this is insanely slow; we need to make it faster ...
-            //static TRROJANSTREAM_FORCE_INLINE void apply(const scalar_type *a,
-            //        const scalar_type *b, scalar_type *c, const scalar_type s,
-            //        const size_t o) {
-            //    std::cout << N << " " << o << std::endl;
-            //    step<1, S, T>::apply(a, b, c, s, o);
-            //    step<N - 1, S, T>::apply(a + o, b + o, c + o, s, o);
-            //}
-#ifdef __GNUC___
-            __attribute__((optimize("unroll-loops")))
-#endif /* __GNUC___ */
-            static TRROJANSTREAM_FORCE_INLINE void apply(const scalar_type *a,
-                    const scalar_type *b, scalar_type *c, const scalar_type s,
-                    const size_t o) {
-#ifdef _MSC_VER
-//#pragma loop(hint_parallel(0))
-//#pragma loop(ivdep)
-//#pragma loop(no_vector)
-#endif /* _MSC_VER */
-                for (int i = 0; i < N; i += o) {
-                    step<1, S, T>::apply(a + i, b + i, c + i, s, o);
-                }
-            }
-        };
-
-        ///// <summary>
-        ///// Specialisation of <see cref="step" /> which performs ten steps an
-        ///// once and thus makes code generation faster.
-        ///// </summary>
-        //template<scalar_type S, task_type T> struct step<10, S, T> {
-        //    typedef typename scalar_type_traits<S>::type scalar_type;
-
-        //    static TRROJANSTREAM_FORCE_INLINE void apply(const scalar_type *a,
-        //            const scalar_type *b, scalar_type *c, const scalar_type s,
-        //            const size_t o) {
-        //        step<1, S, T>::apply(a + 0 * o, b + 0 * o, c + 0 * o, s, o);
-        //        step<1, S, T>::apply(a + 1 * o, b + 1 * o, c + 1 * o, s, o);
-        //        step<1, S, T>::apply(a + 2 * o, b + 2 * o, c + 2 * o, s, o);
-        //        step<1, S, T>::apply(a + 3 * o, b + 3 * o, c + 3 * o, s, o);
-        //        step<1, S, T>::apply(a + 4 * o, b + 4 * o, c + 4 * o, s, o);
-        //        step<1, S, T>::apply(a + 5 * o, b + 5 * o, c + 5 * o, s, o);
-        //        step<1, S, T>::apply(a + 6 * o, b + 6 * o, c + 6 * o, s, o);
-        //        step<1, S, T>::apply(a + 7 * o, b + 7 * o, c + 7 * o, s, o);
-        //        step<1, S, T>::apply(a + 8 * o, b + 8 * o, c + 8 * o, s, o);
-        //        step<1, S, T>::apply(a + 9 * o, b + 9 * o, c + 9 * o, s, o);
-        //    }
-        //};
-
-        /// <summary>
-        /// Template specialisation which actually performs the
-        /// <see cref="trrojan::stream::task_type::add" /> task.
-        /// </summary>
-        template<scalar_type S> struct step<1, S, task_type::add> {
-            typedef typename scalar_type_traits<S>::type scalar_type;
-
-            static TRROJANSTREAM_FORCE_INLINE void apply(const scalar_type *a,
-                    const scalar_type *b, scalar_type *c, const scalar_type s,
-                    const size_t o) {
-                *c = *a + *b;
-            }
-        };
+        inline bool verified(void) const {
+            return this->_verified;
+        }
 
-        /// <summary>
-        /// Template specialisation which actually performs the
-        /// <see cref="trrojan::stream::task_type::copy" /> task.
-        /// </summary>
-        template<scalar_type S> struct step<1, S, task_type::copy> {
-            typedef typename scalar_type_traits<S>::type scalar_type;
+        worker_thread& operator =(const worker_thread&) = delete;
 
-            static TRROJANSTREAM_FORCE_INLINE void apply(const scalar_type *a,
-                    const scalar_type *b, scalar_type *c, const scalar_type s,
-                    const size_t o) {
-                *c = *a;
-            }
-        };
+    private:
 
         /// <summary>
-        /// Template specialisation which actually performs the
-        /// <see cref="trrojan::stream::task_type::scale" /> task.
+        /// Answer whether <paramref name="actual" /> equals
+        /// <paramref name="expected" /> within the given relative
+        /// <paramref name="tolerance" />.
         /// </summary>
-        template<scalar_type S> struct step<1, S, task_type::scale> {
-            typedef typename scalar_type_traits<S>::type scalar_type;
-
-            static TRROJANSTREAM_FORCE_INLINE void apply(const scalar_type *a,
-                    const scalar_type *b, scalar_type *c, const scalar_type s,
-                    const size_t o) {
-                *c = s * *a;
+        template<class S>
+        static TRROJANSTREAM_FORCE_INLINE bool is_close(const S actual,
+                const S expected, const S tolerance) {
+            if (actual == expected) {
+                return true;
             }
-        };
+            if (!std::is_floating_point<S>::value) {
+                return false;
+            }
+            auto d = (actual > expected)
+                ? (actual - expected)
+                : (expected - actual);
+            auto m = (std::max)((actual < 0) ? -actual : actual,
+                (expected < 0) ? -expected : expected);
+            return (d <= tolerance * m);
+        }
 
         /// <summary>
-        /// Template specialisation which actually performs the
-        /// <see cref="trrojan::stream::task_type::triad" /> task.
+        /// The type of a native thread handle.
         /// </summary>
-        template<scalar_type S> struct step<1, S, task_type::triad> {
-            typedef typename scalar_type_traits<S>::type scalar_type;
-
-            static TRROJANSTREAM_FORCE_INLINE void apply(const scalar_type *a,
-                    const scalar_type *b, scalar_type *c, const scalar_type s,
-                    const size_t o) {
-                *c = s * *a + *b;
-            }
-        };
+#ifdef _WIN32
+        typedef HANDLE handle_type;
+#else /* _WIN32 */
+        typedef pthread_t handle_type;
+#endif /* _WIN32 */
 
         /// <summary>
         /// The thread function which invokes the
@@ -387,7 +370,7 @@ namespace stream {
 
         /// <summary>
         /// Selects the specified scalar type <paramref name="s" /> for
-        /// execution and continues with dispatching the problem size.
+        /// execution and continues with dispatching the access pattern.
         /// </summary>
         template<trrojan::stream::scalar_type S,
             trrojan::stream::scalar_type... Ss>
@@ -395,15 +378,14 @@ namespace stream {
                 trrojan::stream::scalar_type_list_t<S, Ss...>,
                 const trrojan::stream::scalar_type s,
                 const trrojan::stream::access_pattern a,
-                const problem_size_type p,
                 const trrojan::stream::task_type t) {
             if (S == s) {
                 //std::cout << "scalar type " << (int) S << " selected." << std::endl;
-                this->dispatch<S>(problem_sizes(), a, p, t);
+                this->dispatch<S>(access_pattern_list(), a, t);
             } else {
                 this->dispatch(
                     trrojan::stream::scalar_type_list_t<Ss...>(),
-                    s, a, p, t);
+                    s, a, t);
             }
         }
 
@@ -414,45 +396,13 @@ namespace stream {
             trrojan::stream::scalar_type_list_t<>,
             const trrojan::stream::scalar_type s,
             const trrojan::stream::access_pattern a,
-            const problem_size_type p,
-            const trrojan::stream::task_type t) { }
-
-        /// <summary>
-        /// Selects the specified problem size <paramref name="p" /> for
-        /// execution and continues with dispatching the access pattern.
-        /// </summary>
-        template<trrojan::stream::scalar_type S,
-            problem_size_type P, problem_size_type... Ps>
-        inline void dispatch(
-                trrojan::integer_sequence<problem_size_type, P, Ps...>,
-                const trrojan::stream::access_pattern a,
-                const problem_size_type p,
-                const trrojan::stream::task_type t) {
-            if (P == p) {
-                //std::cout << "problem size " << P << " (" << p << ") selected." << std::endl;
-                this->dispatch<S, P>(access_pattern_list(), a, t);
-            } else {
-                this->dispatch<S>(
-                    trrojan::integer_sequence<problem_size_type, Ps...>(),
-                    a, p, t);
-            }
-        }
-
-        /// <summary>
-        /// Recursion stop.
-        /// </summary>
-        template<trrojan::stream::scalar_type S>
-        inline void dispatch(
-            trrojan::integer_sequence<problem_size_type>,
-            const trrojan::stream::access_pattern a,
-            const problem_size_type p,
             const trrojan::stream::task_type t) { }
 
         /// <summary>
         /// Selects the specified access pattern <paramref name="a" /> for
         /// execution.
         /// </summary>
-        template<trrojan::stream::scalar_type S, problem_size_type P,
+        template<trrojan::stream::scalar_type S,
             trrojan::stream::access_pattern A,
             trrojan::stream::access_pattern... As>
         inline void dispatch(trrojan::stream::access_pattern_list_t<A, As...>,
@@ -460,9 +410,9 @@ namespace stream {
                 const trrojan::stream::task_type t) {
             if (A == a) {
                 //std::cout << "access pattern " << (int) A << " selected." << std::endl;
-                this->dispatch<S, P, A>(task_type_list(), t);
+                this->dispatch<S, A>(task_type_list(), t);
             } else {
-                this->dispatch<S, P>(
+                this->dispatch<S>(
                     trrojan::stream::access_pattern_list_t<As...>(),
                     a, t);
             }
@@ -471,7 +421,7 @@ namespace stream {
         /// <summary>
         /// Recursion stop.
         /// </summary>
-        template<trrojan::stream::scalar_type S, problem_size_type P>
+        template<trrojan::stream::scalar_type S>
         inline void dispatch(trrojan::stream::access_pattern_list_t<>,
             const trrojan::stream::access_pattern a,
             const trrojan::stream::task_type t) { }
@@ -482,7 +432,6 @@ namespace stream {
         /// execution.
         /// </summary>
         template<trrojan::stream::scalar_type S,
-            trrojan::stream::worker_thread::problem_size_type P,
             trrojan::stream::access_pattern A,
             trrojan::stream::task_type T,
             trrojan::stream::task_type... Ts>
@@ -493,18 +442,17 @@ namespace stream {
         /// Recursion stop.
         /// </summary>
         template<trrojan::stream::scalar_type S,
-            trrojan::stream::worker_thread::problem_size_type P,
             trrojan::stream::access_pattern A>
         inline void dispatch(trrojan::stream::task_type_list_t<>,
             const trrojan::stream::task_type t) { }
 
         /// <summary>
         /// Synchronises the worker threads using the same
-        /// <see cref="trrojan::stream::worker_thread::barrier" />
-        /// for the <see cref="barrierId" />th iteration using busy
-        /// waiting (spin lock).
+        /// <see cref="trrojan::stream::worker_thread::barrier" />.
         /// </summary>
-        void synchronise(const int barrierId);
+        /// <returns>The time the calling thread arrived at the barrier.
+        /// </returns>
+        trrojan::timer::value_type synchronise(void);
 
         /// <summary>
         /// The barrier synchronising the test.
@@ -535,6 +483,11 @@ namespace stream {
         /// The lock for <see cref="results" />.
         /// </summary>
         mutable std::mutex results_lock;
+
+        /// <summary>
+        /// Remembers whether the output of the last iteration was correct.
+        /// </summary>
+        bool _verified;
     };
 
 }
@@ -54,23 +54,74 @@ void trrojan::stream::worker_thread::join(I begin, I end) {
  */
 template<class S, trrojan::stream::task_type T>
 bool trrojan::stream::worker_thread::verify(const S *a, const S *b, const S *c,
-        const S s, const size_t cnt) {
-    S expected;
-
-    for (size_t i = 0; i < cnt; ++i) {
-        step<1, scalar_reverse_traits<S>::type, T>::apply(a + i, b + i,
-            &expected, s, 0);
-        if (expected != c[i]) {
-            trrojan::log::instance().write(trrojan::log_level::warning,
-                "Verification of stream results failed for item {}: found {}, "
-                "but expected {}.\n", i, std::to_string(c[i]).c_str(),
-                std::to_string(expected).c_str());
+        const S s, const size_t cnt, const size_t step, const size_t chain,
+        const problem::index_type *indices) {
+    typedef task_type_traits<T> traits;
+    const size_t block = 1024;
+    auto kernel = get_kernel<S>(instruction_set::scalar, T, 1);
+    std::array<S, block> ea, eb, ec;
+
+    // The vectorised kernels may fuse multiply-adds, which the scalar
+    // reference does not, so floating-point results may differ by a few
+    // ulps per operation. Integers must match exactly.
+    auto tolerance = static_cast<S>(0);
+    if (std::is_floating_point<S>::value) {
+        auto flops = traits::flops + chain * traits::chain_flops;
+        tolerance = static_cast<S>(4 * (flops + 1))
+            * std::numeric_limits<S>::epsilon();
+    }
+
+    for (size_t i = 0; i < cnt; i += block) {
+        const auto n = (std::min)(block, cnt - i);
+        const S *ia = a + i * step;
+        const S *ib = b + i * step;
+
+        // Gather the inputs into contiguous blocks unless they already are,
+        // such that the reference kernel and the comparison can be
+        // vectorised by the compiler.
+        if (indices != nullptr) {
+            for (size_t j = 0; j < n; ++j) {
+                ea[j] = a[indices[i + j]];
+                eb[j] = b[indices[i + j]];
+            }
+            ia = ea.data();
+            ib = eb.data();
+        } else if (step != 1) {
+            for (size_t j = 0; j < n; ++j) {
+                ea[j] = ia[j * step];
+                eb[j] = ib[j * step];
+            }
+            ia = ea.data();
+            ib = eb.data();
+        }
+
+        kernel(ia, ib, ec.data(), s, n, 1, chain);
+
+        const S *ac = c + i * step;
+        size_t failed = 0;
+        for (size_t j = 0; j < n; ++j) {
+            failed += worker_thread::is_close(ac[j * step], ec[j], tolerance)
+                ? 0 : 1;
+        }
+
+        if (failed > 0) {
+            // Only search the culprit if we know that there is one.
+            for (size_t j = 0; j < n; ++j) {
+                if (!worker_thread::is_close(ac[j * step], ec[j], tolerance)) {
+                    trrojan::log::instance().write(
+                        trrojan::log_level::warning, "Verification of stream "
+                        "results failed for item {}: found {}, but expected "
+                        "{}.\n", i + j, std::to_string(ac[j * step]),
+                        std::to_string(ec[j]));
+                    break;
+                }
+            }
             return false;
         }
     }
     /* No problem found at this point. */
 
-    trrojan::log::instance().write(trrojan::log_level::information,
+    trrojan::log::instance().write(trrojan::log_level::verbose,
         "Verification of {} stream results succeeded.\n", cnt);
     return true;
 }
@@ -81,16 +132,24 @@ bool trrojan::stream::worker_thread::verify(const S *a, const S *b, const S *c,
  */
 template<class S> 
 bool trrojan::stream::worker_thread::verify(const S *a, const S *b, const S *c,
-        const S s, const size_t cnt, const task_type task) {
+        const S s, const size_t cnt, const size_t step, const size_t chain,
+        const task_type task, const problem::index_type *indices) {
     switch (task) {
         case task_type::add:
-            return worker_thread::verify<S, task_type::add>(a, b, c, s, cnt);
+            return worker_thread::verify<S, task_type::add>(a, b, c, s, cnt,
+                step, chain, indices);
         case task_type::copy:
-            return worker_thread::verify<S, task_type::copy>(a, b, c, s, cnt);
+            return worker_thread::verify<S, task_type::copy>(a, b, c, s, cnt,
+                step, chain, indices);
+        case task_type::fma_chain:
+            return worker_thread::verify<S, task_type::fma_chain>(a, b, c, s,
+                cnt, step, chain, indices);
         case task_type::scale:
-            return worker_thread::verify<S, task_type::scale>(a, b, c, s, cnt);
+            return worker_thread::verify<S, task_type::scale>(a, b, c, s, cnt,
+                step, chain, indices);
         case task_type::triad:
-            return worker_thread::verify<S, task_type::triad>(a, b, c, s, cnt);
+            return worker_thread::verify<S, task_type::triad>(a, b, c, s, cnt,
+                step, chain, indices);
         default:
             throw std::logic_error("No verification is possible for the given "
                 "task.");
@@ -98,11 +157,77 @@ bool trrojan::stream::worker_thread::verify(const S *a, const S *b, const S *c,
 }
 
 
+/*
+ * trrojan::stream::worker_thread::verify
+ */
+template<class S>
+bool trrojan::stream::worker_thread::verify(const S *const *reads,
+        const size_t cnt_reads, const S *const *writes,
+        const size_t cnt_writes, const size_t cnt, const size_t step) {
+    const size_t block = 1024;
+    auto kernel = get_multi_stream_kernel<S>(instruction_set::scalar,
+        cnt_reads, 1, 1);
+    std::vector<S> inputs(cnt_reads * block);
+    std::array<const S *, max_streams> in;
+    std::array<S, block> expected;
+    auto out = expected.data();
+
+    for (size_t i = 0; i < cnt; i += block) {
+        const auto n = (std::min)(block, cnt - i);
+
+        // Gather strided inputs into contiguous blocks like for the other
+        // tasks.
+        for (size_t r = 0; r < cnt_reads; ++r) {
+            if (step == 1) {
+                in[r] = reads[r] + i;
+            } else {
+                auto dst = inputs.data() + r * block;
+                for (size_t j = 0; j < n; ++j) {
+                    dst[j] = reads[r][(i + j) * step];
+                }
+                in[r] = dst;
+            }
+        }
+
+        kernel(in.data(), &out, n, 1);
+
+        // The vectorised kernels add in the same order as the scalar one,
+        // so all outputs must match exactly.
+        for (size_t w = 0; w < cnt_writes; ++w) {
+            const S *ac = writes[w] + i * step;
+            size_t failed = 0;
+            for (size_t j = 0; j < n; ++j) {
+                failed += (ac[j * step] == expected[j]) ? 0 : 1;
+            }
+
+            if (failed > 0) {
+                for (size_t j = 0; j < n; ++j) {
+                    if (ac[j * step] != expected[j]) {
+                        trrojan::log::instance().write(
+                            trrojan::log_level::warning, "Verification of "
+                            "stream results failed for item {} of output "
+                            "{}: found {}, but expected {}.\n", i + j, w,
+                            std::to_string(ac[j * step]),
+                            std::to_string(expected[j]));
+                        break;
+                    }
+                }
+                return false;
+            }
+        }
+    }
+    /* No problem found at this point. */
+
+    trrojan::log::instance().write(trrojan::log_level::verbose,
+        "Verification of {} stream results succeeded.\n", cnt);
+    return true;
+}
+
+
 /*
  * trrojan::stream::worker_thread::dispatch
  */
 template<trrojan::stream::scalar_type S,
-    trrojan::stream::worker_thread::problem_size_type P,
     trrojan::stream::access_pattern A,
     trrojan::stream::task_type T,
     trrojan::stream::task_type... Ts>
@@ -113,43 +238,191 @@ void trrojan::stream::worker_thread::dispatch(
     assert(this->results.size() == this->_problem->iterations() + 1);
 
     if (T == t) {
-        typedef access_pattern_traits<A, P> pattern;
-        typedef step<P, S, T> step;
+        typedef access_pattern_traits<A> pattern;
+        typedef typename scalar_type_traits<S>::type scalar_type;
+
+        auto size = this->_problem->size(this->rank);
+        auto items = this->_problem->items(this->rank);
+        auto offset = pattern::offset(this->rank,
+            this->_problem->offset(this->rank));
+        auto o = pattern::step(this->_problem->parallelism());
+        auto step = o;
+
+        if constexpr (A == access_pattern::strided) {
+            o *= this->_problem->stride();
+            step = o;
+        } else if constexpr (A == access_pattern::blocked) {
+            // Offset and step are measured in blocks, the blocks themselves
+            // are processed contiguously.
+            offset *= this->_problem->block_size();
+            o *= this->_problem->block_size();
+            step = 1;
+        }
 
-        auto offset = pattern::offset(this->rank);
         auto a = this->_problem->a<S>() + offset;
         auto b = this->_problem->b<S>() + offset;
         auto c = this->_problem->c<S>() + offset;
         auto s = this->_problem->s<S>();
-        auto o = pattern::step(this->_problem->parallelism());
         auto cnt = this->_problem->iterations();
+        auto chain = this->_problem->chain_length();
+        auto isa = this->_problem->instruction_set();
+        auto accesses = this->_problem->memory_accesses();
+        auto multi = (T == task_type::multi_stream);
+        auto kernel = !multi
+            ? get_kernel<scalar_type>(isa, T, step,
+                this->_problem->store_mode())
+            : nullptr;
+        auto gather = ((A == access_pattern::random) && !multi)
+            ? get_gather_kernel<scalar_type>(T) : nullptr;
+        auto cntReads = this->_problem->read_streams();
+        auto cntWrites = this->_problem->write_streams();
+        auto multiKernel = multi
+            ? get_multi_stream_kernel<scalar_type>(isa, cntReads, cntWrites,
+                step, this->_problem->store_mode())
+            : nullptr;
+        std::array<const scalar_type *, max_streams> reads;
+        std::array<scalar_type *, max_streams> writes;
+        std::unique_ptr<trrojan::perf_counter_group> counters;
         trrojan::timer timer;
 
+        if (this->_problem->perf_counters()) {
+            // Only the first rank counts the system-wide memory controller
+            // events, because they would be summed up for each thread.
+            counters.reset(new trrojan::perf_counter_group(this->rank == 0));
+        }
+
+        for (size_t r = 0; r < cntReads; ++r) {
+            reads[r] = this->_problem->read_stream<scalar_type>(r) + offset;
+        }
+        for (size_t w = 0; w < cntWrites; ++w) {
+            writes[w] = this->_problem->write_stream<scalar_type>(w) + offset;
+        }
+
+        // Shifts all streams to the block starting at 'j' for processing
+        // blocked accesses.
+        auto shift = [&](const size_t j,
+                std::array<const scalar_type *, max_streams>& r,
+                std::array<scalar_type *, max_streams>& w) {
+            for (size_t k = 0; k < cntReads; ++k) {
+                r[k] = reads[k] + j;
+            }
+            for (size_t k = 0; k < cntWrites; ++k) {
+                w[k] = writes[k] + j;
+            }
+        };
+
+        auto run = [&](void) {
+            if constexpr (T == task_type::multi_stream) {
+                if constexpr (A == access_pattern::blocked) {
+                    const auto block = this->_problem->block_size();
+                    std::array<const scalar_type *, max_streams> r;
+                    std::array<scalar_type *, max_streams> w;
+                    for (size_t i = 0, j = 0; i < items; i += block, j += o) {
+                        shift(j, r, w);
+                        multiKernel(r.data(), w.data(), block, 1);
+                    }
+                } else {
+                    // Random accesses are rejected by the problem.
+                    multiKernel(reads.data(), writes.data(), items, o);
+                }
+
+            } else if constexpr (A == access_pattern::random) {
+                auto indices = this->_problem->indices() + offset;
+                gather(a, b, c, s, indices, items, chain);
+
+            } else if constexpr (A == access_pattern::blocked) {
+                const auto block = this->_problem->block_size();
+                for (size_t i = 0, j = 0; i < items; i += block, j += o) {
+                    kernel(a + j, b + j, c + j, s, block, 1, chain);
+                }
+
+            } else {
+                kernel(a, b, c, s, items, o, chain);
+            }
+        };
+
         log::instance().write(log_level::verbose, "Worker thread {} is "
             "performing the following test: size = {}, offset = {}, "
             "step = {}, task = {}, access pattern = {}, scalar type = {}, "
-            "scalar value = {}, iterations = {}\n", this->rank, P, offset, o,
-            static_cast<int>(T), static_cast<int>(A), static_cast<int>(S),
-            s, cnt);
+            "scalar value = {}, iterations = {}, instruction set = {}\n",
+            this->rank, size, offset, o, static_cast<int>(T),
+            static_cast<int>(A), static_cast<int>(S), s, cnt,
+            static_cast<int>(isa));
 
         for (size_t i = 0; i <= cnt; ++i) {
             auto& result = this->results[i];
-            result.memory_accesses = task_type_traits<T>::memory_accesses;
-            // Note: we assign 'memory_accesses' before entering the spin lock,
-            // because it enforces that 'result' is used before the splin lock,
+            result.memory_accesses = accesses;
+            result.counters = trrojan::perf_counter_group::invalid_values();
+            // Note: we assign 'memory_accesses' before entering the barrier,
+            // because it enforces that 'result' is used before the barrier,
             // which forces the compiler to initialise the local variable at
             // the point where it is in the code. Otherwise, some compilers
             // reorder the operations, because 'result' is not used before the
-            // spin lock was passed.
-            this->synchronise(i);
+            // barrier was passed.
+            result.arrival = this->synchronise();
+            if (counters != nullptr) {
+                counters->start();
+            }
             result.start = timer.start();
-            step::apply(a, b, c, s, o);
+            run();
             result.time = timer.elapsed_millis();
+            if (this->_problem->subtract_timer_overhead()) {
+                result.time = trrojan::timer::subtract_overhead(result.time);
+            }
+            if (counters != nullptr) {
+                result.counters = counters->stop();
+            }
             // std::cout << "Iteration " << i << ", worker " << this->rank << ": " << this->_problem->calc_mb_per_s(result.time) << " MB/s" << std::endl;
         }
 
+        if (this->_problem->verify()) {
+            // Check the output of the last iteration after the measurement.
+            // Each thread checks the items it has written, so the check runs
+            // on all threads in parallel.
+            if constexpr (T == task_type::multi_stream) {
+                if constexpr (A == access_pattern::blocked) {
+                    const auto block = this->_problem->block_size();
+                    std::array<const scalar_type *, max_streams> r;
+                    std::array<scalar_type *, max_streams> w;
+                    this->_verified = true;
+                    for (size_t i = 0, j = 0; (i < items) && this->_verified;
+                            i += block, j += o) {
+                        shift(j, r, w);
+                        this->_verified = verify<scalar_type>(r.data(),
+                            cntReads, w.data(), cntWrites, block, 1);
+                    }
+                } else {
+                    this->_verified = verify<scalar_type>(reads.data(),
+                        cntReads, writes.data(), cntWrites, items, o);
+                }
+
+            } else if constexpr (A == access_pattern::random) {
+                auto indices = this->_problem->indices() + offset;
+                this->_verified = verify<scalar_type, T>(a, b, c, s, items, 1,
+                    chain, indices);
+
+            } else if constexpr (A == access_pattern::blocked) {
+                const auto block = this->_problem->block_size();
+                this->_verified = true;
+                for (size_t i = 0, j = 0; (i < items) && this->_verified;
+                        i += block, j += o) {
+                    this->_verified = verify<scalar_type, T>(a + j, b + j,
+                        c + j, s, block, 1, chain);
+                }
+
+            } else {
+                this->_verified = verify<scalar_type, T>(a, b, c, s, items, o,
+                    chain);
+            }
+
+            if (!this->_verified) {
+                log::instance().write(log_level::warning, "Worker thread {} "
+                    "produced wrong results.\n", this->rank);
+            }
+        }
+
     } else {
-        this->dispatch<S, P, A>(
+        this->dispatch<S, A>(
             trrojan::stream::task_type_list_t<Ts...>(),
             t);
     }
@@ -0,0 +1,363 @@
+/// <copyright file="allocation_benchmark.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "trrojan/stream/allocation_benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif /* !defined(_WIN32) */
+
+#include "trrojan/constants.h"
+#include "trrojan/cpu_topology.h"
+#include "trrojan/log.h"
+#include "trrojan/timer.h"
+
+#include "trrojan/stream/worker_thread.h"
+
+
+#define _TRROJANSTREAM_DEFINE_FACTOR(f)                                        \
+const std::string trrojan::stream::allocation_benchmark::factor_##f(#f)
+
+_TRROJANSTREAM_DEFINE_FACTOR(iterations);
+_TRROJANSTREAM_DEFINE_FACTOR(method);
+_TRROJANSTREAM_DEFINE_FACTOR(page_size);
+_TRROJANSTREAM_DEFINE_FACTOR(placement);
+_TRROJANSTREAM_DEFINE_FACTOR(size);
+_TRROJANSTREAM_DEFINE_FACTOR(threads);
+
+#undef _TRROJANSTREAM_DEFINE_FACTOR
+
+
+#define _TRROJANSTREAM_DEFINE_RES_NAME(r)                                      \
+const std::string trrojan::stream::allocation_benchmark::result_name_##r(#r)
+
+_TRROJANSTREAM_DEFINE_RES_NAME(fault_latency);
+_TRROJANSTREAM_DEFINE_RES_NAME(pages);
+_TRROJANSTREAM_DEFINE_RES_NAME(rate_unmap);
+_TRROJANSTREAM_DEFINE_RES_NAME(rate_zeroing);
+_TRROJANSTREAM_DEFINE_RES_NAME(time_map);
+_TRROJANSTREAM_DEFINE_RES_NAME(time_touch);
+_TRROJANSTREAM_DEFINE_RES_NAME(time_unmap);
+
+#undef _TRROJANSTREAM_DEFINE_RES_NAME
+
+
+/*
+ * trrojan::stream::allocation_benchmark::is_supported
+ */
+bool trrojan::stream::allocation_benchmark::is_supported(
+        const allocation_method method) {
+    switch (method) {
+        case allocation_method::populate:
+#if defined(MAP_POPULATE)
+            return true;
+#else /* defined(MAP_POPULATE) */
+            return false;
+#endif /* defined(MAP_POPULATE) */
+
+        case allocation_method::will_need:
+#if defined(MADV_WILLNEED)
+            return true;
+#else /* defined(MADV_WILLNEED) */
+            return false;
+#endif /* defined(MADV_WILLNEED) */
+
+        default:
+            return true;
+    }
+}
+
+
+/*
+ * trrojan::stream::allocation_benchmark::allocation_benchmark
+ */
+trrojan::stream::allocation_benchmark::allocation_benchmark(void)
+        : trrojan::benchmark_base("allocation") {
+    // If no method is given, compare all that the platform supports.
+    {
+        std::vector<std::string> methods;
+        auto add = [&methods](const allocation_method m,
+                const std::string& n) {
+            if (allocation_benchmark::is_supported(m)) {
+                methods.push_back(n);
+            }
+        };
+
+        add(allocation_method::first_touch,
+            allocation_method_traits<allocation_method::first_touch>::name());
+        add(allocation_method::populate,
+            allocation_method_traits<allocation_method::populate>::name());
+        add(allocation_method::will_need,
+            allocation_method_traits<allocation_method::will_need>::name());
+
+        this->_default_configs.add_factor(factor::from_manifestations(
+            factor_method, methods));
+    }
+
+    // If no size is given, quadruple the size from 1 MiB to 1 GiB, which
+    // ranges from a few huge pages to the size of a large data set.
+    {
+        std::vector<std::uint64_t> sizes;
+        for (std::uint64_t s = 1024 * 1024; s <= (static_cast<std::uint64_t>(1)
+                << 30); s *= 4) {
+            sizes.push_back(s);
+        }
+        this->_default_configs.add_factor(factor::from_manifestations(
+            factor_size, sizes));
+    }
+
+    // If no number of threads is given, compare a single thread to one
+    // thread per logical processor.
+    {
+        std::vector<std::uint64_t> threads { 1 };
+        auto cnt = cpu_topology::instance().logical_processors().size();
+        if (cnt > 1) {
+            threads.push_back(cnt);
+        }
+        this->_default_configs.add_factor(factor::from_manifestations(
+            factor_threads, threads));
+    }
+
+    // If no number of iterations is specified, use a magic number.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_iterations, static_cast<std::uint64_t>(5)));
+
+    // Use regular pages unless requested otherwise.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_page_size, page_size_traits<page_size::regular>::name()));
+
+    // Fill the physical cores first like the stream benchmark.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_placement,
+        thread_placement_traits<thread_placement::compact>::name()));
+}
+
+
+/*
+ * trrojan::stream::allocation_benchmark::~allocation_benchmark
+ */
+trrojan::stream::allocation_benchmark::~allocation_benchmark(void) { }
+
+
+/*
+ * trrojan::stream::allocation_benchmark::run
+ */
+trrojan::result trrojan::stream::allocation_benchmark::run(
+        const configuration& config) {
+    typedef trrojan::constants<double> constants;
+    typedef trrojan::timer::millis_type millis_type;
+
+    // The timestamps of the phases of a single thread in one iteration.
+    struct measurement {
+        trrojan::timer::value_type start;
+        trrojan::timer::value_type mapped;
+        trrojan::timer::value_type touched;
+        trrojan::timer::value_type unmapped;
+    };
+
+    const auto iterations = config.get<std::uint64_t>(factor_iterations);
+    const auto method = parse_method(*config.find(factor_method));
+    const auto pages = parse_page_size(*config.find(factor_page_size));
+    const auto placement = parse_placement(*config.find(factor_placement));
+    const auto size = static_cast<std::size_t>(
+        config.get<std::uint64_t>(factor_size));
+    const auto threads = config.get<std::uint64_t>(factor_threads);
+
+    if (!allocation_benchmark::is_supported(method)) {
+        throw std::invalid_argument("The requested allocation method is not "
+            "supported on this platform.");
+    }
+    if (size < 1) {
+        throw std::invalid_argument("The allocation benchmark must map at "
+            "least one byte.");
+    }
+    if (iterations < 1) {
+        throw std::invalid_argument("The allocation benchmark requires at "
+            "least one iteration.");
+    }
+    if (threads < 1) {
+        throw std::invalid_argument("The allocation benchmark requires at "
+            "least one thread.");
+    }
+
+    // Do not start threads that would not have a page to map. As the chunks
+    // are rounded to full pages, fewer threads than pages might be needed.
+    const auto pageSize = get_page_size(pages);
+    const auto touchStep = get_page_size(page_size::regular);
+    auto parallelism = static_cast<std::size_t>((std::min)(threads,
+        static_cast<std::uint64_t>((size + pageSize - 1) / pageSize)));
+    const auto chunk = round_to_pages((size + parallelism - 1) / parallelism,
+        pages);
+    parallelism = (size + chunk - 1) / chunk;
+    if (parallelism < threads) {
+        log::instance().write(log_level::verbose, "Only {} threads are used "
+            "to map {} bytes.\n", parallelism, size);
+    }
+
+    auto chunkSize = [&](const std::size_t rank) {
+        const auto begin = (std::min)(rank * chunk, size);
+        return round_to_pages((std::min)(begin + chunk, size) - begin, pages);
+    };
+
+    auto barrier = worker_thread::make_barrier(parallelism);
+    std::vector<std::exception_ptr> errors(parallelism);
+    std::atomic<bool> failed(false);
+    std::vector<std::vector<measurement>> measurements(parallelism,
+        std::vector<measurement>(static_cast<std::size_t>(iterations + 1)));
+    auto processors = worker_thread::place(placement, parallelism);
+
+    auto body = [&](const std::size_t rank) {
+        const auto cnt = chunkSize(rank);
+
+        try {
+            worker_thread::pin(processors[rank]);
+        } catch (...) {
+            errors[rank] = std::current_exception();
+            failed.store(true);
+        }
+
+        // All threads pass the barrier in every iteration even if one has
+        // failed, because the others would wait for it forever otherwise.
+        for (auto& m : measurements[rank]) {
+            barrier->arrive_and_wait();
+            if (failed.load()) {
+                continue;
+            }
+
+            try {
+                m.start = trrojan::timer::now();
+                auto data = allocation_benchmark::map(cnt, pages, method);
+                m.mapped = trrojan::timer::now();
+
+                // Write instead of reading, because reading would only map
+                // the shared zero page.
+                auto d = static_cast<volatile std::uint8_t *>(data);
+                for (std::size_t o = 0; o < cnt; o += touchStep) {
+                    d[o] = 1;
+                }
+                m.touched = trrojan::timer::now();
+
+                free_pages(data, cnt, pages);
+                m.unmapped = trrojan::timer::now();
+            } catch (...) {
+                errors[rank] = std::current_exception();
+                failed.store(true);
+            }
+        }
+    };
+
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(parallelism);
+        for (std::size_t r = 0; r < parallelism; ++r) {
+            workers.emplace_back(body, r);
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+    for (auto& e : errors) {
+        if (e != nullptr) {
+            std::rethrow_exception(e);
+        }
+    }
+
+    basic_result::result_names_type names { result_name_pages,
+        result_name_time_map, result_name_time_touch, result_name_time_unmap,
+        result_name_fault_latency, result_name_rate_zeroing,
+        result_name_rate_unmap };
+    auto retval = std::make_shared<basic_result>(config, names);
+
+    auto toMegabytesPerSecond = [](const std::size_t cnt,
+            const millis_type time) {
+        return (static_cast<double>(cnt) / constants::bytes_per_megabyte)
+            / (time / constants::millis_per_second);
+    };
+
+    // Skip the first iteration, which warmed up the allocator.
+    for (std::size_t i = 1; i < iterations + 1; ++i) {
+        auto minStart = measurements[0][i].start;
+        auto maxTouched = measurements[0][i].touched;
+        auto minTouched = measurements[0][i].touched;
+        auto maxUnmapped = measurements[0][i].unmapped;
+        auto maxMap = static_cast<millis_type>(0);
+        auto maxTouch = static_cast<millis_type>(0);
+        auto maxUnmap = static_cast<millis_type>(0);
+        auto sumLatency = static_cast<double>(0);
+        std::size_t totalSize = 0;
+
+        for (std::size_t r = 0; r < parallelism; ++r) {
+            auto& m = measurements[r][i];
+            auto cnt = chunkSize(r);
+            auto faults = (cnt + pageSize - 1) / pageSize;
+
+            minStart = (std::min)(minStart, m.start);
+            minTouched = (std::min)(minTouched, m.touched);
+            maxTouched = (std::max)(maxTouched, m.touched);
+            maxUnmapped = (std::max)(maxUnmapped, m.unmapped);
+            maxMap = (std::max)(maxMap, timer::to_millis(m.mapped - m.start));
+            maxTouch = (std::max)(maxTouch,
+                timer::to_millis(m.touched - m.mapped));
+            maxUnmap = (std::max)(maxUnmap,
+                timer::to_millis(m.unmapped - m.touched));
+            sumLatency += timer::to_millis(m.touched - m.start) * 1000.0
+                * 1000.0 / static_cast<double>(faults);
+            totalSize += cnt;
+        }
+
+        auto zeroing = timer::to_millis(maxTouched - minStart);
+        auto unmap = timer::to_millis(maxUnmapped - minTouched);
+
+        retval->add({ static_cast<std::uint64_t>(totalSize / pageSize),
+            maxMap, maxTouch, maxUnmap,
+            sumLatency / static_cast<double>(parallelism),
+            toMegabytesPerSecond(totalSize, zeroing),
+            toMegabytesPerSecond(totalSize, unmap) });
+    }
+
+    return std::dynamic_pointer_cast<result::element_type>(retval);
+}
+
+
+/*
+ * trrojan::stream::allocation_benchmark::map
+ */
+void *trrojan::stream::allocation_benchmark::map(const std::size_t size,
+        const trrojan::page_size pages, const allocation_method method) {
+    switch (method) {
+        case allocation_method::populate:
+            return allocate_pages(size, pages, true);
+
+        case allocation_method::will_need: {
+            auto retval = allocate_pages(size, pages);
+#if defined(MADV_WILLNEED)
+            if (::madvise(retval, round_to_pages(size, pages), MADV_WILLNEED)
+                    != 0) {
+                std::error_code ec(errno, std::system_category());
+                free_pages(retval, size, pages);
+                throw std::system_error(ec, "Failed to advise the kernel "
+                    "of the upcoming accesses.");
+            }
+#endif /* defined(MADV_WILLNEED) */
+            return retval;
+            }
+
+        default:
+            return allocate_pages(size, pages);
+    }
+}
@@ -0,0 +1,261 @@
+/// <copyright file="buffer.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "trrojan/stream/buffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else /* defined(_WIN32) */
+#include <sys/mman.h>
+#include <unistd.h>
+#endif /* defined(_WIN32) */
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif /* defined(__linux__) */
+
+#include "trrojan/log.h"
+
+
+#if defined(__linux__)
+namespace {
+
+    /* Memory policies from linux/mempolicy.h, which might not be installed. */
+    const int mpol_bind = 2;
+    const int mpol_interleave = 3;
+
+    /// <summary>
+    /// Invokes the mbind system call directly, which saves us from depending
+    /// on libnuma.
+    /// </summary>
+    long mbind(void *addr, const std::size_t len, const int mode,
+            const trrojan::stream::buffer::node_list& nodes) {
+        typedef unsigned long mask_type;
+        const auto bits = sizeof(mask_type) * CHAR_BIT;
+        auto maxNode = *std::max_element(nodes.begin(), nodes.end());
+        std::vector<mask_type> mask(maxNode / bits + 1, 0);
+
+        for (auto n : nodes) {
+            mask[n / bits] |= static_cast<mask_type>(1) << (n % bits);
+        }
+
+        // Note: The kernel ignores the last bit of 'maxnode', so we pass one
+        // more than we actually use like libnuma does.
+        return ::syscall(SYS_mbind, addr, len, mode, mask.data(),
+            mask.size() * bits + 1, 0);
+    }
+}
+#endif /* defined(__linux__) */
+
+
+/*
+ * trrojan::stream::buffer::page_size
+ */
+std::size_t trrojan::stream::buffer::page_size(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    ::GetSystemInfo(&info);
+    return info.dwPageSize;
+#else /* defined(_WIN32) */
+    return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * trrojan::stream::buffer::buffer
+ */
+trrojan::stream::buffer::buffer(buffer&& rhs) noexcept
+        : _data(rhs._data), _pages(rhs._pages), _size(rhs._size) {
+    rhs._data = nullptr;
+    rhs._pages = trrojan::page_size::regular;
+    rhs._size = 0;
+}
+
+
+/*
+ * trrojan::stream::buffer::~buffer
+ */
+trrojan::stream::buffer::~buffer(void) {
+    this->release();
+}
+
+
+/*
+ * trrojan::stream::buffer::allocate
+ */
+void trrojan::stream::buffer::allocate(const std::size_t size,
+        const trrojan::page_size pages) {
+    this->release();
+
+    if ((size > 0) && (pages != trrojan::page_size::regular)) {
+        this->_data = trrojan::allocate_pages(size, pages);
+        this->_pages = pages;
+        this->_size = size;
+
+    } else if (size > 0) {
+#if defined(_WIN32)
+        this->_data = ::VirtualAlloc(nullptr, size, MEM_RESERVE,
+            PAGE_READWRITE);
+        if (this->_data == nullptr) {
+            std::error_code ec(::GetLastError(), std::system_category());
+            throw std::system_error(ec, "Failed to reserve memory for "
+                "stream buffer.");
+        }
+#else /* defined(_WIN32) */
+        auto data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED) {
+            std::error_code ec(errno, std::system_category());
+            throw std::system_error(ec, "Failed to map memory for stream "
+                "buffer.");
+        }
+        this->_data = data;
+#endif /* defined(_WIN32) */
+
+        this->_size = size;
+    }
+}
+
+
+/*
+ * trrojan::stream::buffer::bind
+ */
+void trrojan::stream::buffer::bind(const std::size_t offset,
+        const std::size_t size, const node_list& nodes) {
+    if (offset + size > this->_size) {
+        throw std::out_of_range("The range to be bound exceeds the buffer.");
+    }
+
+    // Extend the range to full pages of the kind the buffer was allocated
+    // with, because huge pages can only be bound as a whole.
+    const auto pageSize = trrojan::get_page_size(this->_pages);
+    const auto begin = (offset / pageSize) * pageSize;
+    const auto end = std::min(((offset + size + pageSize - 1) / pageSize)
+        * pageSize, ((this->_size + pageSize - 1) / pageSize) * pageSize);
+    auto data = static_cast<std::uint8_t *>(this->_data) + begin;
+
+    if (begin >= end) {
+        return;
+    }
+
+#if defined(_WIN32)
+    if (this->_pages != trrojan::page_size::regular) {
+        // Large pages have been committed on allocation.
+        if (!nodes.empty()) {
+            log::instance().write(log_level::warning, "NUMA policies cannot "
+                "be applied to large pages on Windows.\n");
+        }
+
+    } else if (nodes.empty()) {
+        // Windows places committed memory on the node of the thread causing
+        // the page fault, so we just commit the range here.
+        if (::VirtualAlloc(data, end - begin, MEM_COMMIT, PAGE_READWRITE)
+                == nullptr) {
+            std::error_code ec(::GetLastError(), std::system_category());
+            throw std::system_error(ec, "Failed to commit stream buffer.");
+        }
+
+    } else {
+        // Commit the pages with the preferred node, distributing them
+        // round-robin if there is more than one node.
+        const auto step = (nodes.size() > 1) ? pageSize : (end - begin);
+        auto n = nodes.begin();
+
+        for (auto o = begin; o < end; o += step) {
+            auto s = std::min(step, end - o);
+            auto d = static_cast<std::uint8_t *>(this->_data) + o;
+            if (::VirtualAllocExNuma(::GetCurrentProcess(), d, s, MEM_COMMIT,
+                    PAGE_READWRITE, *n) == nullptr) {
+                log::instance().write(log_level::warning, "Failed to commit "
+                    "memory on NUMA node {} (error {}). The default policy "
+                    "will be used.\n", *n, ::GetLastError());
+                if (::VirtualAlloc(d, s, MEM_COMMIT, PAGE_READWRITE)
+                        == nullptr) {
+                    std::error_code ec(::GetLastError(),
+                        std::system_category());
+                    throw std::system_error(ec, "Failed to commit stream "
+                        "buffer.");
+                }
+            }
+
+            if (++n == nodes.end()) {
+                n = nodes.begin();
+            }
+        }
+    }
+
+#elif defined(__linux__)
+    // The default policy of Linux is placing pages on the node that touches
+    // them first, so we only need to act if specific nodes are requested.
+    if (!nodes.empty()) {
+        auto mode = (nodes.size() > 1) ? mpol_interleave : mpol_bind;
+        if (::mbind(data, end - begin, mode, nodes) != 0) {
+            auto error = errno;
+            log::instance().write(log_level::warning, "Setting the NUMA "
+                "policy of the stream buffer failed (error {}). The default "
+                "policy will be used.\n", error);
+        }
+    }
+
+#else /* defined(_WIN32) */
+    if (!nodes.empty()) {
+        log::instance().write(log_level::warning, "NUMA policies are not "
+            "supported on this platform.\n");
+    }
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * trrojan::stream::buffer::release
+ */
+void trrojan::stream::buffer::release(void) noexcept {
+    if ((this->_data != nullptr)
+            && (this->_pages != trrojan::page_size::regular)) {
+        trrojan::free_pages(this->_data, this->_size, this->_pages);
+        this->_data = nullptr;
+
+    } else if (this->_data != nullptr) {
+#if defined(_WIN32)
+        ::VirtualFree(this->_data, 0, MEM_RELEASE);
+#else /* defined(_WIN32) */
+        ::munmap(this->_data, this->_size);
+#endif /* defined(_WIN32) */
+        this->_data = nullptr;
+    }
+
+    this->_pages = trrojan::page_size::regular;
+    this->_size = 0;
+}
+
+
+/*
+ * trrojan::stream::buffer::operator =
+ */
+trrojan::stream::buffer& trrojan::stream::buffer::operator =(
+        buffer&& rhs) noexcept {
+    if (this != std::addressof(rhs)) {
+        this->release();
+        this->_data = rhs._data;
+        this->_pages = rhs._pages;
+        this->_size = rhs._size;
+        rhs._data = nullptr;
+        rhs._pages = trrojan::page_size::regular;
+        rhs._size = 0;
+    }
+
+    return *this;
+}
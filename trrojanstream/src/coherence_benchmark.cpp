@@ -0,0 +1,383 @@
+/// <copyright file="coherence_benchmark.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "trrojan/stream/coherence_benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iomanip>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) \
+    || defined(__i386__))
+#include <immintrin.h>
+#define TRROJANSTREAM_SPIN_PAUSE() _mm_pause()
+#else /* (defined(_M_X64) || ... */
+#define TRROJANSTREAM_SPIN_PAUSE()
+#endif /* (defined(_M_X64) || ... */
+
+#include "trrojan/log.h"
+#include "trrojan/timer.h"
+
+#include "trrojan/stream/thread_barrier.h"
+#include "trrojan/stream/worker_thread.h"
+
+
+#define _TRROJANSTREAM_DEFINE_FACTOR(f)                                        \
+const std::string trrojan::stream::coherence_benchmark::factor_##f(#f)
+
+_TRROJANSTREAM_DEFINE_FACTOR(first_processor);
+_TRROJANSTREAM_DEFINE_FACTOR(iterations);
+_TRROJANSTREAM_DEFINE_FACTOR(operations);
+_TRROJANSTREAM_DEFINE_FACTOR(second_processor);
+_TRROJANSTREAM_DEFINE_FACTOR(test);
+
+#undef _TRROJANSTREAM_DEFINE_FACTOR
+
+
+#define _TRROJANSTREAM_DEFINE_RES_NAME(r)                                      \
+const std::string trrojan::stream::coherence_benchmark::result_name_##r(#r)
+
+_TRROJANSTREAM_DEFINE_RES_NAME(latency_average);
+_TRROJANSTREAM_DEFINE_RES_NAME(latency_maximum);
+_TRROJANSTREAM_DEFINE_RES_NAME(latency_minimum);
+_TRROJANSTREAM_DEFINE_RES_NAME(operations);
+_TRROJANSTREAM_DEFINE_RES_NAME(throughput_average);
+_TRROJANSTREAM_DEFINE_RES_NAME(throughput_maximum);
+_TRROJANSTREAM_DEFINE_RES_NAME(throughput_minimum);
+_TRROJANSTREAM_DEFINE_RES_NAME(time_average);
+_TRROJANSTREAM_DEFINE_RES_NAME(time_maximum);
+_TRROJANSTREAM_DEFINE_RES_NAME(time_minimum);
+
+#undef _TRROJANSTREAM_DEFINE_RES_NAME
+
+
+/*
+ * trrojan::stream::coherence_benchmark::coherence_benchmark
+ */
+trrojan::stream::coherence_benchmark::coherence_benchmark(void)
+        : trrojan::benchmark_base("coherence") {
+    // If no processors are given, measure all pairs of logical processors.
+    {
+        std::vector<std::uint32_t> ids;
+        for (auto& p : cpu_topology::instance().logical_processors()) {
+            ids.push_back(p.id);
+        }
+        this->_default_configs.add_factor(factor::from_manifestations(
+            factor_first_processor, ids));
+        this->_default_configs.add_factor(factor::from_manifestations(
+            factor_second_processor, ids));
+    }
+
+    // If no test is given, run all of them.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_test, std::vector<std::string> {
+            coherence_test_traits<coherence_test::atomic_increment>::name(),
+            coherence_test_traits<coherence_test::false_sharing>::name(),
+            coherence_test_traits<coherence_test::ping_pong>::name() }));
+
+    // If no number of operations is given, use enough for the timer
+    // resolution while keeping the matrix of a large machine tractable.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_operations, static_cast<std::uint64_t>(1 << 16)));
+
+    // If no number of iterations is specified, use a magic number.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_iterations, static_cast<std::uint64_t>(5)));
+}
+
+
+/*
+ * trrojan::stream::coherence_benchmark::~coherence_benchmark
+ */
+trrojan::stream::coherence_benchmark::~coherence_benchmark(void) { }
+
+
+/*
+ * trrojan::stream::coherence_benchmark::run
+ */
+size_t trrojan::stream::coherence_benchmark::run(
+        const configuration_set& configs,
+        const on_result_callback& callback,
+        const cool_down& coolDown,
+        const std::size_t continue_at) {
+    this->_matrices.clear();
+
+    auto retval = benchmark_base::run(configs, callback, coolDown,
+        continue_at);
+
+    for (auto& m : this->_matrices) {
+        coherence_benchmark::log_matrix(m.first, m.second);
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::stream::coherence_benchmark::run
+ */
+trrojan::result trrojan::stream::coherence_benchmark::run(
+        const configuration& config) {
+    typedef trrojan::timer::millis_type millis_type;
+    typedef std::numeric_limits<millis_type> timer_limits;
+
+    // The state shared by the threads, which occupies a cache line of its own
+    // such that the threads do not disturb anything else and vice versa.
+    struct alignas(64) line_type {
+        std::atomic<std::uint64_t> values[2];
+    };
+
+    const auto test = parse_test(*config.find(factor_test));
+    const auto iterations = config.get<std::uint64_t>(factor_iterations);
+    const auto operations = config.get<std::uint64_t>(factor_operations);
+    const cpu_topology::logical_processor *processors[] = {
+        &find_processor(config.get<std::uint32_t>(factor_first_processor)),
+        &find_processor(config.get<std::uint32_t>(factor_second_processor))
+    };
+
+    if (processors[0]->id == processors[1]->id) {
+        throw std::invalid_argument("The coherence benchmark requires two "
+            "distinct logical processors.");
+    }
+    if (iterations < 1) {
+        throw std::invalid_argument("The coherence benchmark requires at "
+            "least one iteration.");
+    }
+    if (operations < 1) {
+        throw std::invalid_argument("The coherence benchmark requires at "
+            "least one operation per thread.");
+    }
+
+    thread_barrier barrier(2);
+    auto broken = false;
+    std::exception_ptr errors[2];
+    line_type line;
+    std::vector<millis_type> times(static_cast<std::size_t>(iterations + 1));
+
+    auto body = [&](const std::size_t rank) {
+        try {
+            worker_thread::pin(*processors[rank]);
+        } catch (...) {
+            errors[rank] = std::current_exception();
+        }
+
+        // The barrier makes the errors of both threads visible, such that
+        // either both of them run the test or none does.
+        barrier.arrive_and_wait();
+        if ((errors[0] != nullptr) || (errors[1] != nullptr)) {
+            return;
+        }
+
+        auto& flag = line.values[0];
+        auto& mine = line.values[rank];
+        trrojan::timer timer;
+
+        for (std::size_t i = 0; i < times.size(); ++i) {
+            if (rank == 0) {
+                line.values[0].store(0);
+                line.values[1].store(0);
+            }
+
+            barrier.arrive_and_wait();
+            if (rank == 0) {
+                timer.start();
+            }
+
+            switch (test) {
+                case coherence_test::atomic_increment:
+                    // A locked read-modify-write on the same line.
+                    for (std::uint64_t k = 0; k < operations; ++k) {
+                        flag.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+
+                case coherence_test::false_sharing:
+                    // Plain increments of a private counter, which the
+                    // atomic prevents from being kept in a register.
+                    for (std::uint64_t k = 0; k < operations; ++k) {
+                        mine.store(mine.load(std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+                    }
+                    break;
+
+                case coherence_test::ping_pong:
+                default:
+                    // The first thread writes odd, the second one even
+                    // values, each after having seen the other one's write.
+                    for (std::uint64_t k = 0; k < operations; ++k) {
+                        const auto expected = 2 * k + rank;
+                        while (flag.load(std::memory_order_acquire)
+                                != expected) {
+                            TRROJANSTREAM_SPIN_PAUSE();
+                        }
+                        flag.store(expected + 1, std::memory_order_release);
+                    }
+                    break;
+            }
+
+            barrier.arrive_and_wait();
+            if (rank == 0) {
+                times[i] = timer.elapsed_millis();
+
+                // Consume the shared state, because we would otherwise
+                // measure nothing.
+                if (test == coherence_test::false_sharing) {
+                    broken = broken
+                        || (line.values[0].load() != operations)
+                        || (line.values[1].load() != operations);
+                } else {
+                    broken = broken
+                        || (line.values[0].load() != 2 * operations);
+                }
+            }
+        }
+    };
+
+    {
+        std::thread first(body, 0);
+        std::thread second(body, 1);
+        first.join();
+        second.join();
+    }
+
+    for (auto& e : errors) {
+        if (e != nullptr) {
+            std::rethrow_exception(e);
+        }
+    }
+    if (broken) {
+        throw std::logic_error("The threads of the coherence benchmark did "
+            "not perform the expected number of operations.");
+    }
+
+    // Skip the first iteration, which warmed up the threads.
+    auto minTime = (timer_limits::max)();
+    auto maxTime = (timer_limits::min)();
+    auto sumTime = static_cast<millis_type>(0);
+    for (std::size_t i = 1; i < times.size(); ++i) {
+        minTime = (std::min)(minTime, times[i]);
+        maxTime = (std::max)(maxTime, times[i]);
+        sumTime += times[i];
+    }
+
+    auto avgTime = sumTime / static_cast<millis_type>(iterations);
+    const auto total = static_cast<double>(2 * operations);
+    auto toNanos = [total](const millis_type t) {
+        return (t * 1000.0 * 1000.0) / total;
+    };
+    auto toThroughput = [total](const millis_type t) {
+        // Million operations per second.
+        return total / (t * 1000.0);
+    };
+
+    basic_result::result_names_type names { result_name_operations,
+        result_name_time_maximum, result_name_time_average,
+        result_name_time_minimum, result_name_latency_maximum,
+        result_name_latency_average, result_name_latency_minimum,
+        result_name_throughput_minimum, result_name_throughput_average,
+        result_name_throughput_maximum };
+
+    basic_result::result_type values { operations, maxTime, avgTime, minTime,
+        toNanos(maxTime), toNanos(avgTime), toNanos(minTime),
+        toThroughput(maxTime), toThroughput(avgTime), toThroughput(minTime) };
+
+    auto retval = std::make_shared<basic_result>(config, names);
+    retval->add(values);
+
+    // Remember the average latency for the matrix.
+    auto testName = config.find(factor_test)->value().as<std::string>();
+    this->_matrices[testName][std::make_pair(processors[0]->id,
+        processors[1]->id)] = toNanos(avgTime);
+
+    return std::dynamic_pointer_cast<result::element_type>(retval);
+}
+
+
+/*
+ * trrojan::stream::coherence_benchmark::expand_configuration
+ */
+std::vector<trrojan::configuration>
+trrojan::stream::coherence_benchmark::expand_configuration(
+        const configuration& c) {
+    const auto first = c.get<std::uint32_t>(factor_first_processor);
+    const auto second = c.get<std::uint32_t>(factor_second_processor);
+
+    if (first == second) {
+        log::instance().write(log_level::verbose, "Skipping the coherence "
+            "test of logical processor {} with itself.\n", first);
+        return std::vector<configuration>();
+    } else {
+        return std::vector<configuration> { c };
+    }
+}
+
+
+/*
+ * trrojan::stream::coherence_benchmark::find_processor
+ */
+const trrojan::cpu_topology::logical_processor&
+trrojan::stream::coherence_benchmark::find_processor(const std::uint32_t id) {
+    auto& processors = cpu_topology::instance().logical_processors();
+    auto it = std::find_if(processors.begin(), processors.end(),
+        [id](const cpu_topology::logical_processor& p) {
+            return (p.id == id);
+        });
+
+    if (it == processors.end()) {
+        throw std::invalid_argument("The logical processor "
+            + std::to_string(id) + " does not exist.");
+    }
+
+    return *it;
+}
+
+
+/*
+ * trrojan::stream::coherence_benchmark::log_matrix
+ */
+void trrojan::stream::coherence_benchmark::log_matrix(
+        const std::string& test, const matrix_type& matrix) {
+    const int width = 9;
+    std::set<std::uint32_t> rows;
+    std::set<std::uint32_t> columns;
+    std::stringstream table;
+
+    for (auto& e : matrix) {
+        rows.insert(e.first.first);
+        columns.insert(e.first.second);
+    }
+
+    table << std::setw(width) << "";
+    for (auto c : columns) {
+        table << ' ' << std::setw(width) << c;
+    }
+    table << std::endl;
+
+    table << std::fixed << std::setprecision(1);
+    for (auto r : rows) {
+        table << std::setw(width) << r;
+        for (auto c : columns) {
+            auto it = matrix.find(std::make_pair(r, c));
+            if (it != matrix.end()) {
+                table << ' ' << std::setw(width) << it->second;
+            } else {
+                table << ' ' << std::setw(width) << "-";
+            }
+        }
+        table << std::endl;
+    }
+
+    log::instance().write(log_level::information, "Average core-to-core "
+        "latency of \"{}\" in ns (rows: first processor, columns: second "
+        "processor):\n{}", test, table.str());
+}
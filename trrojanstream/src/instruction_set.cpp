@@ -0,0 +1,176 @@
+/// <copyright file="instruction_set.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "trrojan/stream/instruction_set.h"
+
+#include <cinttypes>
+
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) \
+    || defined(__i386__))
+#define TRROJANSTREAM_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else /* defined(_MSC_VER) */
+#include <cpuid.h>
+#endif /* defined(_MSC_VER) */
+#endif /* (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) ... */
+
+#include "kernel_detail.h"
+
+
+#if defined(TRROJANSTREAM_X86)
+namespace {
+
+    /// <summary>
+    /// Retrieves the CPUID leaf <paramref name="leaf" />.
+    /// </summary>
+    void cpuid(std::uint32_t regs[4], const std::uint32_t leaf,
+            const std::uint32_t subleaf = 0) {
+#if defined(_MSC_VER)
+        int r[4];
+        ::__cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+        for (int i = 0; i < 4; ++i) {
+            regs[i] = static_cast<std::uint32_t>(r[i]);
+        }
+#else /* defined(_MSC_VER) */
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif /* defined(_MSC_VER) */
+    }
+
+    /// <summary>
+    /// Reads the extended control register 0, which tells us which register
+    /// states the operating system saves on context switches.
+    /// </summary>
+    std::uint64_t xgetbv0(void) {
+#if defined(_MSC_VER)
+        return ::_xgetbv(0);
+#else /* defined(_MSC_VER) */
+        std::uint32_t lo, hi;
+        __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return (static_cast<std::uint64_t>(hi) << 32) | lo;
+#endif /* defined(_MSC_VER) */
+    }
+
+    /// <summary>
+    /// Determines whether the CPU and the OS support the instruction set.
+    /// </summary>
+    bool cpu_supports(const trrojan::stream::instruction_set isa) {
+        typedef trrojan::stream::instruction_set isa_type;
+        std::uint32_t regs[4];
+
+        cpuid(regs, 0);
+        const auto maxLeaf = regs[0];
+
+        cpuid(regs, 1);
+        const auto sse2 = ((regs[3] & (1u << 26)) != 0);
+        const auto osxsave = ((regs[2] & (1u << 27)) != 0);
+        const auto avx = ((regs[2] & (1u << 28)) != 0);
+        const auto fma = ((regs[2] & (1u << 12)) != 0);
+
+        if (isa == isa_type::sse2) {
+            return sse2;
+        }
+
+        // AVX requires the OS to save the YMM state (bits 1 and 2) and
+        // AVX-512 additionally the opmask and ZMM states (bits 5 to 7).
+        if (!osxsave || !avx || (maxLeaf < 7)) {
+            return false;
+        }
+
+        const auto xcr0 = xgetbv0();
+        if ((xcr0 & 0x06) != 0x06) {
+            return false;
+        }
+
+        cpuid(regs, 7, 0);
+        switch (isa) {
+            case isa_type::avx2:
+                // The AVX2 kernels use FMA3, which all CPUs supporting AVX2
+                // should also support.
+                return fma && ((regs[1] & (1u << 5)) != 0);
+
+            case isa_type::avx512:
+                return ((xcr0 & 0xE0) == 0xE0)
+                    && ((regs[1] & (1u << 16)) != 0)    // AVX512F
+                    && ((regs[1] & (1u << 17)) != 0);   // AVX512DQ
+
+            default:
+                return false;
+        }
+    }
+}
+#endif /* defined(TRROJANSTREAM_X86) */
+
+
+/*
+ * trrojan::stream::best_instruction_set
+ */
+trrojan::stream::instruction_set trrojan::stream::best_instruction_set(void) {
+    static const instruction_set retval = [](void) {
+        instruction_set candidates[] = { instruction_set::avx512,
+            instruction_set::avx2, instruction_set::sse2 };
+
+        for (auto c : candidates) {
+            if (is_supported(c)) {
+                return c;
+            }
+        }
+
+        return instruction_set::scalar;
+    }();
+
+    return retval;
+}
+
+
+/*
+ * trrojan::stream::is_supported
+ */
+bool trrojan::stream::is_supported(const instruction_set isa) {
+    switch (isa) {
+        case instruction_set::scalar:
+            return true;
+
+#if defined(TRROJANSTREAM_X86)
+        case instruction_set::sse2:
+            return (detail::get_sse2_kernel<float>(task_type::copy,
+                store_mode::regular) != nullptr)
+                && cpu_supports(isa);
+
+        case instruction_set::avx2:
+            return (detail::get_avx2_kernel<float>(task_type::copy,
+                store_mode::regular) != nullptr)
+                && cpu_supports(isa);
+
+        case instruction_set::avx512:
+            return (detail::get_avx512_kernel<float>(task_type::copy,
+                store_mode::regular) != nullptr) && cpu_supports(isa);
+#endif /* defined(TRROJANSTREAM_X86) */
+
+        default:
+            return false;
+    }
+}
+
+
+/*
+ * trrojan::stream::to_string
+ */
+const std::string& trrojan::stream::to_string(const instruction_set isa) {
+    switch (isa) {
+        case instruction_set::sse2:
+            return instruction_set_traits<instruction_set::sse2>::name();
+
+        case instruction_set::avx2:
+            return instruction_set_traits<instruction_set::avx2>::name();
+
+        case instruction_set::avx512:
+            return instruction_set_traits<instruction_set::avx512>::name();
+
+        default:
+            return instruction_set_traits<instruction_set::scalar>::name();
+    }
+}
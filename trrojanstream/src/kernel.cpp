@@ -0,0 +1,176 @@
+/// <copyright file="kernel.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "trrojan/stream/kernel.h"
+
+#include <cassert>
+#include <cinttypes>
+#include <stdexcept>
+
+#include "trrojan/log.h"
+
+#include "kernel_detail.h"
+
+
+/*
+ * trrojan::stream::get_kernel
+ */
+template<class S>
+trrojan::stream::kernel_type<S> trrojan::stream::get_kernel(
+        const instruction_set isa, const task_type task,
+        const std::size_t step, const store_mode mode) {
+    kernel_type<S> retval = nullptr;
+
+    if (step == 1) {
+        switch (isa) {
+            case instruction_set::sse2:
+                retval = detail::get_sse2_kernel<S>(task, mode);
+                break;
+
+            case instruction_set::avx2:
+                retval = detail::get_avx2_kernel<S>(task, mode);
+                break;
+
+            case instruction_set::avx512:
+                retval = detail::get_avx512_kernel<S>(task, mode);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (retval == nullptr) {
+        // Either the access is not contiguous or the instruction set cannot
+        // handle the task for the scalar type.
+        if (mode != store_mode::regular) {
+            log::instance().write(log_level::warning, "Non-temporal stores "
+                "are only supported by vectorised kernels for contiguous "
+                "accesses. Regular stores will be used instead.\n");
+        }
+        retval = detail::get_scalar_kernel<S>(task);
+    }
+
+    if (retval == nullptr) {
+        throw std::invalid_argument("No kernel is available for the "
+            "requested task.");
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::stream::get_gather_kernel
+ */
+template<class S>
+trrojan::stream::gather_kernel_type<S> trrojan::stream::get_gather_kernel(
+        const task_type task) {
+    auto retval = detail::get_scalar_gather_kernel<S>(task);
+
+    if (retval == nullptr) {
+        throw std::invalid_argument("No gathering kernel is available for the "
+            "requested task.");
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::stream::get_multi_stream_kernel
+ */
+template<class S>
+trrojan::stream::multi_stream_kernel_type<S>
+trrojan::stream::get_multi_stream_kernel(const instruction_set isa,
+        const std::size_t reads, const std::size_t writes,
+        const std::size_t step, const store_mode mode) {
+    multi_stream_kernel_type<S> retval = nullptr;
+
+    if ((reads < 1) || (reads > max_streams)) {
+        throw std::invalid_argument("The number of read streams is out of "
+            "range.");
+    }
+    if ((writes < 1) || (writes > max_streams)) {
+        throw std::invalid_argument("The number of write streams is out of "
+            "range.");
+    }
+
+    if (step == 1) {
+        switch (isa) {
+            case instruction_set::sse2:
+                retval = detail::get_sse2_multi_stream_kernel<S>(reads,
+                    writes, mode);
+                break;
+
+            case instruction_set::avx2:
+                retval = detail::get_avx2_multi_stream_kernel<S>(reads,
+                    writes, mode);
+                break;
+
+            case instruction_set::avx512:
+                retval = detail::get_avx512_multi_stream_kernel<S>(reads,
+                    writes, mode);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (retval == nullptr) {
+        if (mode != store_mode::regular) {
+            log::instance().write(log_level::warning, "Non-temporal stores "
+                "are only supported by vectorised kernels for contiguous "
+                "accesses. Regular stores will be used instead.\n");
+        }
+        retval = detail::get_scalar_multi_stream_kernel<S>(reads, writes);
+    }
+
+    assert(retval != nullptr);
+    return retval;
+}
+
+
+// Explicit instantiations for all scalar types.
+template trrojan::stream::kernel_type<float>
+trrojan::stream::get_kernel<float>(const instruction_set, const task_type,
+    const std::size_t, const store_mode);
+template trrojan::stream::kernel_type<double>
+trrojan::stream::get_kernel<double>(const instruction_set, const task_type,
+    const std::size_t, const store_mode);
+template trrojan::stream::kernel_type<std::int32_t>
+trrojan::stream::get_kernel<std::int32_t>(const instruction_set,
+    const task_type, const std::size_t, const store_mode);
+template trrojan::stream::kernel_type<std::int64_t>
+trrojan::stream::get_kernel<std::int64_t>(const instruction_set,
+    const task_type, const std::size_t, const store_mode);
+
+template trrojan::stream::gather_kernel_type<float>
+trrojan::stream::get_gather_kernel<float>(const task_type);
+template trrojan::stream::gather_kernel_type<double>
+trrojan::stream::get_gather_kernel<double>(const task_type);
+template trrojan::stream::gather_kernel_type<std::int32_t>
+trrojan::stream::get_gather_kernel<std::int32_t>(const task_type);
+template trrojan::stream::gather_kernel_type<std::int64_t>
+trrojan::stream::get_gather_kernel<std::int64_t>(const task_type);
+
+template trrojan::stream::multi_stream_kernel_type<float>
+trrojan::stream::get_multi_stream_kernel<float>(const instruction_set,
+    const std::size_t, const std::size_t, const std::size_t,
+    const store_mode);
+template trrojan::stream::multi_stream_kernel_type<double>
+trrojan::stream::get_multi_stream_kernel<double>(const instruction_set,
+    const std::size_t, const std::size_t, const std::size_t,
+    const store_mode);
+template trrojan::stream::multi_stream_kernel_type<std::int32_t>
+trrojan::stream::get_multi_stream_kernel<std::int32_t>(const instruction_set,
+    const std::size_t, const std::size_t, const std::size_t,
+    const store_mode);
+template trrojan::stream::multi_stream_kernel_type<std::int64_t>
+trrojan::stream::get_multi_stream_kernel<std::int64_t>(const instruction_set,
+    const std::size_t, const std::size_t, const std::size_t,
+    const store_mode);
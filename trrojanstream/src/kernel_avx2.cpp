@@ -0,0 +1,262 @@
+/// <copyright file="kernel_avx2.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "kernel_detail.h"
+
+#include <cinttypes>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TRROJANSTREAM_AVX2_KERNELS
+#endif /* defined(__AVX2__) */
+
+
+#if defined(TRROJANSTREAM_AVX2_KERNELS)
+namespace {
+
+    /// <summary>
+    /// Vector traits for the AVX2 kernels.
+    /// </summary>
+    template<class S> struct avx2_traits { };
+
+    /// <summary>
+    /// Eight 32-bit floating point numbers.
+    /// </summary>
+    template<> struct avx2_traits<float> {
+        typedef float scalar_type;
+        typedef __m256 vector_type;
+        static constexpr std::size_t width = 8;
+        static constexpr bool can_multiply = true;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm256_add_ps(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type fmadd(const vector_type l,
+                const vector_type r, const vector_type a) {
+#if (defined(__FMA__) || defined(_MSC_VER))
+            return _mm256_fmadd_ps(l, r, a);
+#else /* (defined(__FMA__) || defined(_MSC_VER)) */
+            return _mm256_add_ps(_mm256_mul_ps(l, r), a);
+#endif /* (defined(__FMA__) || defined(_MSC_VER)) */
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm256_loadu_ps(p);
+        }
+
+        static inline vector_type mul(const vector_type l,
+                const vector_type r) {
+            return _mm256_mul_ps(l, r);
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm256_set1_ps(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm256_storeu_ps(p, v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm256_stream_ps(p, v);
+        }
+    };
+
+    /// <summary>
+    /// Four 64-bit floating point numbers.
+    /// </summary>
+    template<> struct avx2_traits<double> {
+        typedef double scalar_type;
+        typedef __m256d vector_type;
+        static constexpr std::size_t width = 4;
+        static constexpr bool can_multiply = true;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm256_add_pd(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type fmadd(const vector_type l,
+                const vector_type r, const vector_type a) {
+#if (defined(__FMA__) || defined(_MSC_VER))
+            return _mm256_fmadd_pd(l, r, a);
+#else /* (defined(__FMA__) || defined(_MSC_VER)) */
+            return _mm256_add_pd(_mm256_mul_pd(l, r), a);
+#endif /* (defined(__FMA__) || defined(_MSC_VER)) */
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm256_loadu_pd(p);
+        }
+
+        static inline vector_type mul(const vector_type l,
+                const vector_type r) {
+            return _mm256_mul_pd(l, r);
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm256_set1_pd(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm256_storeu_pd(p, v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm256_stream_pd(p, v);
+        }
+    };
+
+    /// <summary>
+    /// Eight 32-bit integers.
+    /// </summary>
+    template<> struct avx2_traits<std::int32_t> {
+        typedef std::int32_t scalar_type;
+        typedef __m256i vector_type;
+        static constexpr std::size_t width = 8;
+        static constexpr bool can_multiply = true;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm256_add_epi32(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type fmadd(const vector_type l,
+                const vector_type r, const vector_type a) {
+            return _mm256_add_epi32(_mm256_mullo_epi32(l, r), a);
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        }
+
+        static inline vector_type mul(const vector_type l,
+                const vector_type r) {
+            return _mm256_mullo_epi32(l, r);
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm256_set1_epi32(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(p), v);
+        }
+    };
+
+    /// <summary>
+    /// Four 64-bit integers, which AVX2 cannot multiply.
+    /// </summary>
+    template<> struct avx2_traits<std::int64_t> {
+        typedef std::int64_t scalar_type;
+        typedef __m256i vector_type;
+        static constexpr std::size_t width = 4;
+        static constexpr bool can_multiply = false;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm256_add_epi64(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm256_set1_epi64x(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(p), v);
+        }
+    };
+
+}
+#endif /* defined(TRROJANSTREAM_AVX2_KERNELS) */
+
+
+/*
+ * trrojan::stream::detail::get_avx2_kernel
+ */
+template<class S>
+trrojan::stream::kernel_type<S> trrojan::stream::detail::get_avx2_kernel(
+        const task_type task, const store_mode mode) {
+#if defined(TRROJANSTREAM_AVX2_KERNELS)
+    return select_simd_kernel<avx2_traits<S>>(task, mode);
+#else /* defined(TRROJANSTREAM_AVX2_KERNELS) */
+    return nullptr;
+#endif /* defined(TRROJANSTREAM_AVX2_KERNELS) */
+}
+
+
+/*
+ * trrojan::stream::detail::get_avx2_multi_stream_kernel
+ */
+template<class S>
+trrojan::stream::multi_stream_kernel_type<S>
+trrojan::stream::detail::get_avx2_multi_stream_kernel(
+        const std::size_t reads, const std::size_t writes,
+        const store_mode mode) {
+#if defined(TRROJANSTREAM_AVX2_KERNELS)
+    return select_simd_multi_stream_kernel<avx2_traits<S>>(reads, writes, mode);
+#else /* defined(TRROJANSTREAM_AVX2_KERNELS) */
+    return nullptr;
+#endif /* defined(TRROJANSTREAM_AVX2_KERNELS) */
+}
+
+
+// Explicit instantiations for all scalar types.
+template trrojan::stream::kernel_type<float>
+trrojan::stream::detail::get_avx2_kernel<float>(const task_type,
+    const store_mode);
+template trrojan::stream::kernel_type<double>
+trrojan::stream::detail::get_avx2_kernel<double>(const task_type,
+    const store_mode);
+template trrojan::stream::kernel_type<std::int32_t>
+trrojan::stream::detail::get_avx2_kernel<std::int32_t>(const task_type,
+    const store_mode);
+template trrojan::stream::kernel_type<std::int64_t>
+trrojan::stream::detail::get_avx2_kernel<std::int64_t>(const task_type,
+    const store_mode);
+
+template trrojan::stream::multi_stream_kernel_type<float>
+trrojan::stream::detail::get_avx2_multi_stream_kernel<float>(
+    const std::size_t, const std::size_t, const store_mode);
+template trrojan::stream::multi_stream_kernel_type<double>
+trrojan::stream::detail::get_avx2_multi_stream_kernel<double>(
+    const std::size_t, const std::size_t, const store_mode);
+template trrojan::stream::multi_stream_kernel_type<std::int32_t>
+trrojan::stream::detail::get_avx2_multi_stream_kernel<std::int32_t>(
+    const std::size_t, const std::size_t, const store_mode);
+template trrojan::stream::multi_stream_kernel_type<std::int64_t>
+trrojan::stream::detail::get_avx2_multi_stream_kernel<std::int64_t>(
+    const std::size_t, const std::size_t, const store_mode);
@@ -0,0 +1,265 @@
+/// <copyright file="kernel_avx512.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "kernel_detail.h"
+
+#include <cinttypes>
+
+#if (defined(__AVX512F__) && defined(__AVX512DQ__))
+#include <immintrin.h>
+#define TRROJANSTREAM_AVX512_KERNELS
+#endif /* (defined(__AVX512F__) && defined(__AVX512DQ__)) */
+
+
+#if defined(TRROJANSTREAM_AVX512_KERNELS)
+namespace {
+
+    /// <summary>
+    /// Vector traits for the AVX-512 kernels.
+    /// </summary>
+    template<class S> struct avx512_traits { };
+
+    /// <summary>
+    /// Sixteen 32-bit floating point numbers.
+    /// </summary>
+    template<> struct avx512_traits<float> {
+        typedef float scalar_type;
+        typedef __m512 vector_type;
+        static constexpr std::size_t width = 16;
+        static constexpr bool can_multiply = true;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm512_add_ps(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type fmadd(const vector_type l,
+                const vector_type r, const vector_type a) {
+            return _mm512_fmadd_ps(l, r, a);
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm512_loadu_ps(p);
+        }
+
+        static inline vector_type mul(const vector_type l,
+                const vector_type r) {
+            return _mm512_mul_ps(l, r);
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm512_set1_ps(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm512_storeu_ps(p, v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm512_stream_ps(p, v);
+        }
+    };
+
+    /// <summary>
+    /// Eight 64-bit floating point numbers.
+    /// </summary>
+    template<> struct avx512_traits<double> {
+        typedef double scalar_type;
+        typedef __m512d vector_type;
+        static constexpr std::size_t width = 8;
+        static constexpr bool can_multiply = true;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm512_add_pd(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type fmadd(const vector_type l,
+                const vector_type r, const vector_type a) {
+            return _mm512_fmadd_pd(l, r, a);
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm512_loadu_pd(p);
+        }
+
+        static inline vector_type mul(const vector_type l,
+                const vector_type r) {
+            return _mm512_mul_pd(l, r);
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm512_set1_pd(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm512_storeu_pd(p, v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm512_stream_pd(p, v);
+        }
+    };
+
+    /// <summary>
+    /// Sixteen 32-bit integers.
+    /// </summary>
+    template<> struct avx512_traits<std::int32_t> {
+        typedef std::int32_t scalar_type;
+        typedef __m512i vector_type;
+        static constexpr std::size_t width = 16;
+        static constexpr bool can_multiply = true;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm512_add_epi32(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type fmadd(const vector_type l,
+                const vector_type r, const vector_type a) {
+            return _mm512_add_epi32(_mm512_mullo_epi32(l, r), a);
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm512_loadu_si512(p);
+        }
+
+        static inline vector_type mul(const vector_type l,
+                const vector_type r) {
+            return _mm512_mullo_epi32(l, r);
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm512_set1_epi32(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm512_storeu_si512(p, v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm512_stream_si512(reinterpret_cast<__m512i *>(p), v);
+        }
+    };
+
+    /// <summary>
+    /// Eight 64-bit integers.
+    /// </summary>
+    template<> struct avx512_traits<std::int64_t> {
+        typedef std::int64_t scalar_type;
+        typedef __m512i vector_type;
+        static constexpr std::size_t width = 8;
+        static constexpr bool can_multiply = true;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm512_add_epi64(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type fmadd(const vector_type l,
+                const vector_type r, const vector_type a) {
+            return _mm512_add_epi64(_mm512_mullo_epi64(l, r), a);
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm512_loadu_si512(p);
+        }
+
+        static inline vector_type mul(const vector_type l,
+                const vector_type r) {
+            return _mm512_mullo_epi64(l, r);
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm512_set1_epi64(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm512_storeu_si512(p, v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm512_stream_si512(reinterpret_cast<__m512i *>(p), v);
+        }
+    };
+
+}
+#endif /* defined(TRROJANSTREAM_AVX512_KERNELS) */
+
+
+/*
+ * trrojan::stream::detail::get_avx512_kernel
+ */
+template<class S>
+trrojan::stream::kernel_type<S> trrojan::stream::detail::get_avx512_kernel(
+        const task_type task, const store_mode mode) {
+#if defined(TRROJANSTREAM_AVX512_KERNELS)
+    return select_simd_kernel<avx512_traits<S>>(task, mode);
+#else /* defined(TRROJANSTREAM_AVX512_KERNELS) */
+    return nullptr;
+#endif /* defined(TRROJANSTREAM_AVX512_KERNELS) */
+}
+
+
+/*
+ * trrojan::stream::detail::get_avx512_multi_stream_kernel
+ */
+template<class S>
+trrojan::stream::multi_stream_kernel_type<S>
+trrojan::stream::detail::get_avx512_multi_stream_kernel(
+        const std::size_t reads, const std::size_t writes,
+        const store_mode mode) {
+#if defined(TRROJANSTREAM_AVX512_KERNELS)
+    return select_simd_multi_stream_kernel<avx512_traits<S>>(reads,
+        writes, mode);
+#else /* defined(TRROJANSTREAM_AVX512_KERNELS) */
+    return nullptr;
+#endif /* defined(TRROJANSTREAM_AVX512_KERNELS) */
+}
+
+
+// Explicit instantiations for all scalar types.
+template trrojan::stream::kernel_type<float>
+trrojan::stream::detail::get_avx512_kernel<float>(const task_type,
+    const store_mode);
+template trrojan::stream::kernel_type<double>
+trrojan::stream::detail::get_avx512_kernel<double>(const task_type,
+    const store_mode);
+template trrojan::stream::kernel_type<std::int32_t>
+trrojan::stream::detail::get_avx512_kernel<std::int32_t>(const task_type,
+    const store_mode);
+template trrojan::stream::kernel_type<std::int64_t>
+trrojan::stream::detail::get_avx512_kernel<std::int64_t>(const task_type,
+    const store_mode);
+
+template trrojan::stream::multi_stream_kernel_type<float>
+trrojan::stream::detail::get_avx512_multi_stream_kernel<float>(
+    const std::size_t, const std::size_t, const store_mode);
+template trrojan::stream::multi_stream_kernel_type<double>
+trrojan::stream::detail::get_avx512_multi_stream_kernel<double>(
+    const std::size_t, const std::size_t, const store_mode);
+template trrojan::stream::multi_stream_kernel_type<std::int32_t>
+trrojan::stream::detail::get_avx512_multi_stream_kernel<std::int32_t>(
+    const std::size_t, const std::size_t, const store_mode);
+template trrojan::stream::multi_stream_kernel_type<std::int64_t>
+trrojan::stream::detail::get_avx512_multi_stream_kernel<std::int64_t>(
+    const std::size_t, const std::size_t, const store_mode);
@@ -0,0 +1,634 @@
+/// <copyright file="kernel_detail.h" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "trrojan/stream/kernel.h"
+
+
+/*
+ * Note: This header is included by translation units that are compiled with
+ * different instruction set flags. In order to prevent the linker from
+ * merging instantiations that have been compiled for different instruction
+ * sets, all templates herein are parameterised with the vector traits of the
+ * instruction set, which must be declared in an anonymous namespace of the
+ * including translation unit.
+ */
+
+
+namespace trrojan {
+namespace stream {
+namespace detail {
+
+    /// <summary>
+    /// Gets the portable kernel for the given task.
+    /// </summary>
+    template<class S> kernel_type<S> get_scalar_kernel(const task_type task);
+
+    /// <summary>
+    /// Gets the portable gathering kernel for the given task.
+    /// </summary>
+    template<class S>
+    gather_kernel_type<S> get_scalar_gather_kernel(const task_type task);
+
+    /// <summary>
+    /// Gets the SSE2 kernel for the given task or <c>nullptr</c> if there is
+    /// none.
+    /// </summary>
+    template<class S> kernel_type<S> get_sse2_kernel(const task_type task,
+        const store_mode mode);
+
+    /// <summary>
+    /// Gets the AVX2 kernel for the given task or <c>nullptr</c> if there is
+    /// none.
+    /// </summary>
+    template<class S> kernel_type<S> get_avx2_kernel(const task_type task,
+        const store_mode mode);
+
+    /// <summary>
+    /// Gets the AVX-512 kernel for the given task or <c>nullptr</c> if there
+    /// is none.
+    /// </summary>
+    template<class S> kernel_type<S> get_avx512_kernel(const task_type task,
+        const store_mode mode);
+
+    /// <summary>
+    /// Gets the portable kernel for the given number of streams.
+    /// </summary>
+    template<class S>
+    multi_stream_kernel_type<S> get_scalar_multi_stream_kernel(
+        const std::size_t reads, const std::size_t writes);
+
+    /// <summary>
+    /// Gets the SSE2 kernel for the given number of streams or
+    /// <c>nullptr</c> if there is none.
+    /// </summary>
+    template<class S>
+    multi_stream_kernel_type<S> get_sse2_multi_stream_kernel(
+        const std::size_t reads, const std::size_t writes,
+        const store_mode mode);
+
+    /// <summary>
+    /// Gets the AVX2 kernel for the given number of streams or
+    /// <c>nullptr</c> if there is none.
+    /// </summary>
+    template<class S>
+    multi_stream_kernel_type<S> get_avx2_multi_stream_kernel(
+        const std::size_t reads, const std::size_t writes,
+        const store_mode mode);
+
+    /// <summary>
+    /// Gets the AVX-512 kernel for the given number of streams or
+    /// <c>nullptr</c> if there is none.
+    /// </summary>
+    template<class S>
+    multi_stream_kernel_type<S> get_avx512_multi_stream_kernel(
+        const std::size_t reads, const std::size_t writes,
+        const store_mode mode);
+
+    /// <summary>
+    /// Computes <c>l + r</c> for a single scalar.
+    /// </summary>
+    /// <remarks>
+    /// Integers are added as unsigned numbers, because the sum of many
+    /// streams can overflow and the overflow of signed numbers is undefined.
+    /// </remarks>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V>
+    inline typename V::scalar_type scalar_add(const typename V::scalar_type l,
+            const typename V::scalar_type r) {
+        typedef typename V::scalar_type S;
+        if constexpr (std::is_integral<S>::value) {
+            typedef typename std::make_unsigned<S>::type unsigned_type;
+            return static_cast<S>(static_cast<unsigned_type>(l)
+                + static_cast<unsigned_type>(r));
+        } else {
+            return l + r;
+        }
+    }
+
+    /// <summary>
+    /// Computes <c>l * r + a</c> for a single scalar.
+    /// </summary>
+    /// <remarks>
+    /// Integers are multiplied as unsigned numbers, because the chains of
+    /// <see cref="task_type::fma_chain" /> overflow quickly and the
+    /// overflow of signed numbers is undefined.
+    /// </remarks>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V>
+    inline typename V::scalar_type scalar_fmadd(
+            const typename V::scalar_type l, const typename V::scalar_type r,
+            const typename V::scalar_type a) {
+        typedef typename V::scalar_type S;
+        if constexpr (std::is_integral<S>::value) {
+            typedef typename std::make_unsigned<S>::type unsigned_type;
+            return static_cast<S>(static_cast<unsigned_type>(l)
+                * static_cast<unsigned_type>(r)
+                + static_cast<unsigned_type>(a));
+        } else {
+            return l * r + a;
+        }
+    }
+
+    /// <summary>
+    /// Performs task <tparamref name="T" /> for a single item.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, task_type T>
+    inline void scalar_step(const typename V::scalar_type *a,
+            const typename V::scalar_type *b, typename V::scalar_type *c,
+            const typename V::scalar_type s, const std::size_t chain) {
+        if constexpr (T == task_type::add) {
+            *c = *a + *b;
+        } else if constexpr (T == task_type::copy) {
+            *c = *a;
+        } else if constexpr (T == task_type::fma_chain) {
+            // Each multiply-add depends on the previous one, so the chain
+            // cannot be overlapped within the item.
+            auto x = scalar_fmadd<V>(s, *a, *b);
+            for (std::size_t i = 0; i < chain; ++i) {
+                x = scalar_fmadd<V>(x, s, *b);
+            }
+            *c = x;
+        } else if constexpr (T == task_type::scale) {
+            *c = s * *a;
+        } else if constexpr (T == task_type::triad) {
+            *c = s * *a + *b;
+        }
+    }
+
+    /// <summary>
+    /// Writes <paramref name="v" /> to <paramref name="p" /> using the store
+    /// mode <tparamref name="M" />.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, store_mode M>
+    inline void simd_store(typename V::scalar_type *p,
+            const typename V::vector_type v) {
+        if constexpr (M == store_mode::regular) {
+            V::store(p, v);
+        } else {
+            V::stream(p, v);
+        }
+    }
+
+    /// <summary>
+    /// Performs task <tparamref name="T" /> for a single vector.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, task_type T, store_mode M>
+    inline void simd_step(const typename V::scalar_type *a,
+            const typename V::scalar_type *b, typename V::scalar_type *c,
+            const typename V::vector_type s, const std::size_t chain) {
+        if constexpr (T == task_type::add) {
+            simd_store<V, M>(c, V::add(V::load(a), V::load(b)));
+        } else if constexpr (T == task_type::copy) {
+            simd_store<V, M>(c, V::load(a));
+        } else if constexpr (T == task_type::fma_chain) {
+            const auto vb = V::load(b);
+            auto x = V::fmadd(s, V::load(a), vb);
+            for (std::size_t i = 0; i < chain; ++i) {
+                x = V::fmadd(x, s, vb);
+            }
+            simd_store<V, M>(c, x);
+        } else if constexpr (T == task_type::scale) {
+            simd_store<V, M>(c, V::mul(s, V::load(a)));
+        } else if constexpr (T == task_type::triad) {
+            simd_store<V, M>(c, V::add(V::mul(s, V::load(a)), V::load(b)));
+        }
+    }
+
+    /// <summary>
+    /// Performs <see cref="task_type::fma_chain" /> for four consecutive
+    /// vectors, whose chains are interleaved such that the independent
+    /// multiply-adds can hide the latency of each other.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, store_mode M>
+    inline void simd_fma_chain4(const typename V::scalar_type *a,
+            const typename V::scalar_type *b, typename V::scalar_type *c,
+            const typename V::vector_type s, const std::size_t chain) {
+        const auto w = V::width;
+        const auto b0 = V::load(b);
+        const auto b1 = V::load(b + w);
+        const auto b2 = V::load(b + 2 * w);
+        const auto b3 = V::load(b + 3 * w);
+        auto x0 = V::fmadd(s, V::load(a), b0);
+        auto x1 = V::fmadd(s, V::load(a + w), b1);
+        auto x2 = V::fmadd(s, V::load(a + 2 * w), b2);
+        auto x3 = V::fmadd(s, V::load(a + 3 * w), b3);
+
+        for (std::size_t i = 0; i < chain; ++i) {
+            x0 = V::fmadd(x0, s, b0);
+            x1 = V::fmadd(x1, s, b1);
+            x2 = V::fmadd(x2, s, b2);
+            x3 = V::fmadd(x3, s, b3);
+        }
+
+        simd_store<V, M>(c, x0);
+        simd_store<V, M>(c + w, x1);
+        simd_store<V, M>(c + 2 * w, x2);
+        simd_store<V, M>(c + 3 * w, x3);
+    }
+
+    /// <summary>
+    /// Performs task <tparamref name="T" /> on <paramref name="cnt" /> items,
+    /// which are <paramref name="step" /> elements apart.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, task_type T>
+    void strided_kernel(const typename V::scalar_type *a,
+            const typename V::scalar_type *b, typename V::scalar_type *c,
+            const typename V::scalar_type s, const std::size_t cnt,
+            const std::size_t step, const std::size_t chain) {
+        const auto end = cnt * step;
+        for (std::size_t i = 0; i < end; i += step) {
+            scalar_step<V, T>(a + i, b + i, c + i, s, chain);
+        }
+    }
+
+    /// <summary>
+    /// Performs task <tparamref name="T" /> on <paramref name="cnt" /> items,
+    /// whose inputs are read from the positions in
+    /// <paramref name="indices" />.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, task_type T>
+    void gather_kernel(const typename V::scalar_type *a,
+            const typename V::scalar_type *b, typename V::scalar_type *c,
+            const typename V::scalar_type s, const std::uint32_t *indices,
+            const std::size_t cnt, const std::size_t chain) {
+        for (std::size_t i = 0; i < cnt; ++i) {
+            const auto j = indices[i];
+            scalar_step<V, T>(a + j, b + j, c + i, s, chain);
+        }
+    }
+
+    /// <summary>
+    /// Performs task <tparamref name="T" /> on <paramref name="cnt" />
+    /// contiguous items using the vector instructions described by
+    /// <tparamref name="V" />.
+    /// </summary>
+    /// <remarks>
+    /// <para>The main loop is unrolled four times, which amortises the loop
+    /// overhead that the fixed-size templates used to avoid. The remainder
+    /// that does not fill a vector is processed item by item.</para>
+    /// <para>Non-temporal stores require the output to be aligned to the
+    /// vector size. Therefore, the items before the first aligned vector are
+    /// processed using regular scalar stores, too.</para>
+    /// </remarks>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, task_type T, store_mode M>
+    void simd_kernel(const typename V::scalar_type *a,
+            const typename V::scalar_type *b, typename V::scalar_type *c,
+            const typename V::scalar_type s, const std::size_t cnt,
+            const std::size_t /* step */, const std::size_t chain) {
+        typedef typename V::scalar_type scalar_type;
+        const auto w = V::width;
+        const auto vs = V::set1(s);
+        std::size_t i = 0;
+
+        if constexpr (M != store_mode::regular) {
+            const auto alignment = sizeof(typename V::vector_type);
+            const auto misalignment = reinterpret_cast<std::uintptr_t>(c)
+                % alignment;
+            if (misalignment != 0) {
+                auto head = (alignment - misalignment) / sizeof(scalar_type);
+                for (; (i < head) && (i < cnt); ++i) {
+                    scalar_step<V, T>(a + i, b + i, c + i, s, chain);
+                }
+            }
+        }
+
+        for (; i + 4 * w <= cnt; i += 4 * w) {
+            if constexpr (T == task_type::fma_chain) {
+                simd_fma_chain4<V, M>(a + i, b + i, c + i, vs, chain);
+            } else {
+                simd_step<V, T, M>(a + i, b + i, c + i, vs, chain);
+                simd_step<V, T, M>(a + i + w, b + i + w, c + i + w, vs,
+                    chain);
+                simd_step<V, T, M>(a + i + 2 * w, b + i + 2 * w,
+                    c + i + 2 * w, vs, chain);
+                simd_step<V, T, M>(a + i + 3 * w, b + i + 3 * w,
+                    c + i + 3 * w, vs, chain);
+            }
+        }
+
+        for (; i + w <= cnt; i += w) {
+            simd_step<V, T, M>(a + i, b + i, c + i, vs, chain);
+        }
+
+        for (; i < cnt; ++i) {
+            scalar_step<V, T>(a + i, b + i, c + i, s, chain);
+        }
+
+        if constexpr (M == store_mode::non_temporal_sfence) {
+            V::fence();
+        }
+    }
+
+    /// <summary>
+    /// Performs <see cref="task_type::multi_stream" /> with
+    /// <tparamref name="R" /> read and <tparamref name="W" /> write streams
+    /// for the single item at <paramref name="i" />.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, std::size_t R, std::size_t W>
+    inline void multi_stream_scalar_step(
+            const typename V::scalar_type *const *reads,
+            typename V::scalar_type *const *writes, const std::size_t i) {
+        auto x = reads[0][i];
+        for (std::size_t r = 1; r < R; ++r) {
+            x = scalar_add<V>(x, reads[r][i]);
+        }
+        for (std::size_t w = 0; w < W; ++w) {
+            writes[w][i] = x;
+        }
+    }
+
+    /// <summary>
+    /// Performs <see cref="task_type::multi_stream" /> with
+    /// <tparamref name="R" /> read and <tparamref name="W" /> write streams
+    /// for the vector at <paramref name="i" />.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, std::size_t R, std::size_t W, store_mode M>
+    inline void multi_stream_simd_step(
+            const typename V::scalar_type *const *reads,
+            typename V::scalar_type *const *writes, const std::size_t i) {
+        auto x = V::load(reads[0] + i);
+        for (std::size_t r = 1; r < R; ++r) {
+            x = V::add(x, V::load(reads[r] + i));
+        }
+        for (std::size_t w = 0; w < W; ++w) {
+            simd_store<V, M>(writes[w] + i, x);
+        }
+    }
+
+    /// <summary>
+    /// Performs <see cref="task_type::multi_stream" /> with
+    /// <tparamref name="R" /> read and <tparamref name="W" /> write streams
+    /// on <paramref name="cnt" /> items, which are <paramref name="step" />
+    /// elements apart.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, std::size_t R, std::size_t W>
+    void strided_multi_stream_kernel(
+            const typename V::scalar_type *const *reads,
+            typename V::scalar_type *const *writes, const std::size_t cnt,
+            const std::size_t step) {
+        typedef typename V::scalar_type scalar_type;
+        // Copy the stream pointers such that the compiler knows that they
+        // cannot change while writing the outputs. Note: std::copy is not
+        // used, because it is not specific to the instruction set.
+        const scalar_type *r[R];
+        scalar_type *w[W];
+        for (std::size_t j = 0; j < R; ++j) {
+            r[j] = reads[j];
+        }
+        for (std::size_t j = 0; j < W; ++j) {
+            w[j] = writes[j];
+        }
+
+        const auto end = cnt * step;
+        for (std::size_t i = 0; i < end; i += step) {
+            multi_stream_scalar_step<V, R, W>(r, w, i);
+        }
+    }
+
+    /// <summary>
+    /// Performs <see cref="task_type::multi_stream" /> with
+    /// <tparamref name="R" /> read and <tparamref name="W" /> write streams
+    /// on <paramref name="cnt" /> contiguous items using the vector
+    /// instructions described by <tparamref name="V" />.
+    /// </summary>
+    /// <remarks>
+    /// The handling of the loop and of non-temporal stores is the same as for
+    /// <see cref="simd_kernel" />. All streams are expected to have the same
+    /// alignment, which is the case for the arrays of a problem.
+    /// </remarks>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, std::size_t R, std::size_t W, store_mode M>
+    void simd_multi_stream_kernel(
+            const typename V::scalar_type *const *reads,
+            typename V::scalar_type *const *writes, const std::size_t cnt,
+            const std::size_t /* step */) {
+        typedef typename V::scalar_type scalar_type;
+        const auto v = V::width;
+        const scalar_type *r[R];
+        scalar_type *w[W];
+        std::size_t i = 0;
+        for (std::size_t j = 0; j < R; ++j) {
+            r[j] = reads[j];
+        }
+        for (std::size_t j = 0; j < W; ++j) {
+            w[j] = writes[j];
+        }
+
+        if constexpr (M != store_mode::regular) {
+            const auto alignment = sizeof(typename V::vector_type);
+            const auto misalignment = reinterpret_cast<std::uintptr_t>(w[0])
+                % alignment;
+            if (misalignment != 0) {
+                auto head = (alignment - misalignment) / sizeof(scalar_type);
+                for (; (i < head) && (i < cnt); ++i) {
+                    multi_stream_scalar_step<V, R, W>(r, w, i);
+                }
+            }
+        }
+
+        for (; i + 4 * v <= cnt; i += 4 * v) {
+            multi_stream_simd_step<V, R, W, M>(r, w, i);
+            multi_stream_simd_step<V, R, W, M>(r, w, i + v);
+            multi_stream_simd_step<V, R, W, M>(r, w, i + 2 * v);
+            multi_stream_simd_step<V, R, W, M>(r, w, i + 3 * v);
+        }
+
+        for (; i + v <= cnt; i += v) {
+            multi_stream_simd_step<V, R, W, M>(r, w, i);
+        }
+
+        for (; i < cnt; ++i) {
+            multi_stream_scalar_step<V, R, W>(r, w, i);
+        }
+
+        if constexpr (M == store_mode::non_temporal_sfence) {
+            V::fence();
+        }
+    }
+
+    /// <summary>
+    /// Provides <see cref="strided_multi_stream_kernel" /> to
+    /// <see cref="select_multi_stream_kernel" />.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V> struct strided_multi_stream_factory {
+        typedef multi_stream_kernel_type<typename V::scalar_type> kernel_type;
+
+        template<std::size_t R, std::size_t W>
+        static inline kernel_type get(void) {
+            return strided_multi_stream_kernel<V, R, W>;
+        }
+    };
+
+    /// <summary>
+    /// Provides <see cref="simd_multi_stream_kernel" /> to
+    /// <see cref="select_multi_stream_kernel" />.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, store_mode M> struct simd_multi_stream_factory {
+        typedef multi_stream_kernel_type<typename V::scalar_type> kernel_type;
+
+        template<std::size_t R, std::size_t W>
+        static inline kernel_type get(void) {
+            return simd_multi_stream_kernel<V, R, W, M>;
+        }
+    };
+
+    /// <summary>
+    /// Selects the kernel of the factory <tparamref name="F" /> for
+    /// <tparamref name="R" /> read streams and the given number of write
+    /// streams.
+    /// </summary>
+    template<class F, std::size_t R, std::size_t... Ws>
+    typename F::kernel_type select_multi_stream_kernel(
+            const std::size_t writes, std::index_sequence<Ws...>) {
+        typename F::kernel_type retval = nullptr;
+        ((retval = (writes == Ws + 1)
+            ? F::template get<R, Ws + 1>()
+            : retval), ...);
+        return retval;
+    }
+
+    /// <summary>
+    /// Selects the kernel of the factory <tparamref name="F" /> for the given
+    /// number of read and write streams.
+    /// </summary>
+    template<class F, std::size_t... Rs>
+    typename F::kernel_type select_multi_stream_kernel(
+            const std::size_t reads, const std::size_t writes,
+            std::index_sequence<Rs...>) {
+        typename F::kernel_type retval = nullptr;
+        ((retval = (reads == Rs + 1)
+            ? select_multi_stream_kernel<F, Rs + 1>(writes,
+                std::make_index_sequence<max_streams>())
+            : retval), ...);
+        return retval;
+    }
+
+    /// <summary>
+    /// Selects the kernel of the factory <tparamref name="F" /> for the given
+    /// number of read and write streams.
+    /// </summary>
+    /// <returns>The kernel or <c>nullptr</c> if the number of streams is not
+    /// within [1, <see cref="max_streams" />].</returns>
+    template<class F>
+    inline typename F::kernel_type select_multi_stream_kernel(
+            const std::size_t reads, const std::size_t writes) {
+        return select_multi_stream_kernel<F>(reads, writes,
+            std::make_index_sequence<max_streams>());
+    }
+
+    /// <summary>
+    /// Selects the vectorised multi-stream kernel for the given number of
+    /// streams and store mode.
+    /// </summary>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V>
+    multi_stream_kernel_type<typename V::scalar_type>
+    select_simd_multi_stream_kernel(const std::size_t reads,
+            const std::size_t writes, const store_mode mode) {
+        switch (mode) {
+            case store_mode::non_temporal:
+                return select_multi_stream_kernel<simd_multi_stream_factory<V,
+                    store_mode::non_temporal>>(reads, writes);
+
+            case store_mode::non_temporal_sfence:
+                return select_multi_stream_kernel<simd_multi_stream_factory<V,
+                    store_mode::non_temporal_sfence>>(reads, writes);
+
+            case store_mode::regular:
+            default:
+                return select_multi_stream_kernel<simd_multi_stream_factory<V,
+                    store_mode::regular>>(reads, writes);
+        }
+    }
+
+    /// <summary>
+    /// Selects the vectorised kernel for the given task and store mode
+    /// <tparamref name="M" />.
+    /// </summary>
+    /// <returns>The kernel or <c>nullptr</c> if the instruction set cannot
+    /// perform the task for the scalar type.</returns>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V, store_mode M>
+    kernel_type<typename V::scalar_type> select_simd_kernel(
+            const task_type task) {
+        switch (task) {
+            case task_type::add:
+                return simd_kernel<V, task_type::add, M>;
+
+            case task_type::copy:
+                return simd_kernel<V, task_type::copy, M>;
+
+            case task_type::fma_chain:
+                if constexpr (V::can_multiply) {
+                    return simd_kernel<V, task_type::fma_chain, M>;
+                } else {
+                    return nullptr;
+                }
+
+            case task_type::scale:
+                if constexpr (V::can_multiply) {
+                    return simd_kernel<V, task_type::scale, M>;
+                } else {
+                    return nullptr;
+                }
+
+            case task_type::triad:
+                if constexpr (V::can_multiply) {
+                    return simd_kernel<V, task_type::triad, M>;
+                } else {
+                    return nullptr;
+                }
+
+            default:
+                return nullptr;
+        }
+    }
+
+    /// <summary>
+    /// Selects the vectorised kernel for the given task and store mode.
+    /// </summary>
+    /// <returns>The kernel or <c>nullptr</c> if the instruction set cannot
+    /// perform the task for the scalar type.</returns>
+    /// <tparam name="V">The vector traits of the instruction set.</tparam>
+    template<class V>
+    kernel_type<typename V::scalar_type> select_simd_kernel(
+            const task_type task, const store_mode mode) {
+        switch (mode) {
+            case store_mode::non_temporal:
+                return select_simd_kernel<V, store_mode::non_temporal>(task);
+
+            case store_mode::non_temporal_sfence:
+                return select_simd_kernel<V,
+                    store_mode::non_temporal_sfence>(task);
+
+            case store_mode::regular:
+            default:
+                return select_simd_kernel<V, store_mode::regular>(task);
+        }
+    }
+
+}
+}
+}
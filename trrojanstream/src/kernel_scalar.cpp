@@ -0,0 +1,129 @@
+/// <copyright file="kernel_scalar.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "kernel_detail.h"
+
+#include <cinttypes>
+
+
+namespace {
+
+    /// <summary>
+    /// Traits for the portable kernels, which only need to know the scalar.
+    /// </summary>
+    template<class S> struct scalar_traits {
+        typedef S scalar_type;
+    };
+
+}
+
+
+/*
+ * trrojan::stream::detail::get_scalar_kernel
+ */
+template<class S>
+trrojan::stream::kernel_type<S> trrojan::stream::detail::get_scalar_kernel(
+        const task_type task) {
+    typedef scalar_traits<S> traits;
+
+    switch (task) {
+        case task_type::add:
+            return strided_kernel<traits, task_type::add>;
+
+        case task_type::copy:
+            return strided_kernel<traits, task_type::copy>;
+
+        case task_type::fma_chain:
+            return strided_kernel<traits, task_type::fma_chain>;
+
+        case task_type::scale:
+            return strided_kernel<traits, task_type::scale>;
+
+        case task_type::triad:
+            return strided_kernel<traits, task_type::triad>;
+
+        default:
+            return nullptr;
+    }
+}
+
+
+/*
+ * trrojan::stream::detail::get_scalar_gather_kernel
+ */
+template<class S>
+trrojan::stream::gather_kernel_type<S>
+trrojan::stream::detail::get_scalar_gather_kernel(const task_type task) {
+    typedef scalar_traits<S> traits;
+
+    switch (task) {
+        case task_type::add:
+            return gather_kernel<traits, task_type::add>;
+
+        case task_type::copy:
+            return gather_kernel<traits, task_type::copy>;
+
+        case task_type::fma_chain:
+            return gather_kernel<traits, task_type::fma_chain>;
+
+        case task_type::scale:
+            return gather_kernel<traits, task_type::scale>;
+
+        case task_type::triad:
+            return gather_kernel<traits, task_type::triad>;
+
+        default:
+            return nullptr;
+    }
+}
+
+
+/*
+ * trrojan::stream::detail::get_scalar_multi_stream_kernel
+ */
+template<class S>
+trrojan::stream::multi_stream_kernel_type<S>
+trrojan::stream::detail::get_scalar_multi_stream_kernel(
+        const std::size_t reads, const std::size_t writes) {
+    typedef scalar_traits<S> traits;
+    return select_multi_stream_kernel<strided_multi_stream_factory<traits>>(
+        reads, writes);
+}
+
+
+// Explicit instantiations for all scalar types.
+template trrojan::stream::kernel_type<float>
+trrojan::stream::detail::get_scalar_kernel<float>(const task_type);
+template trrojan::stream::kernel_type<double>
+trrojan::stream::detail::get_scalar_kernel<double>(const task_type);
+template trrojan::stream::kernel_type<std::int32_t>
+trrojan::stream::detail::get_scalar_kernel<std::int32_t>(const task_type);
+template trrojan::stream::kernel_type<std::int64_t>
+trrojan::stream::detail::get_scalar_kernel<std::int64_t>(const task_type);
+
+template trrojan::stream::gather_kernel_type<float>
+trrojan::stream::detail::get_scalar_gather_kernel<float>(const task_type);
+template trrojan::stream::gather_kernel_type<double>
+trrojan::stream::detail::get_scalar_gather_kernel<double>(const task_type);
+template trrojan::stream::gather_kernel_type<std::int32_t>
+trrojan::stream::detail::get_scalar_gather_kernel<std::int32_t>(
+    const task_type);
+template trrojan::stream::gather_kernel_type<std::int64_t>
+trrojan::stream::detail::get_scalar_gather_kernel<std::int64_t>(
+    const task_type);
+
+template trrojan::stream::multi_stream_kernel_type<float>
+trrojan::stream::detail::get_scalar_multi_stream_kernel<float>(
+    const std::size_t, const std::size_t);
+template trrojan::stream::multi_stream_kernel_type<double>
+trrojan::stream::detail::get_scalar_multi_stream_kernel<double>(
+    const std::size_t, const std::size_t);
+template trrojan::stream::multi_stream_kernel_type<std::int32_t>
+trrojan::stream::detail::get_scalar_multi_stream_kernel<std::int32_t>(
+    const std::size_t, const std::size_t);
+template trrojan::stream::multi_stream_kernel_type<std::int64_t>
+trrojan::stream::detail::get_scalar_multi_stream_kernel<std::int64_t>(
+    const std::size_t, const std::size_t);
@@ -0,0 +1,244 @@
+/// <copyright file="kernel_sse2.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "kernel_detail.h"
+
+#include <cinttypes>
+
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#include <immintrin.h>
+#define TRROJANSTREAM_SSE2_KERNELS
+#endif /* (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))) */
+
+
+#if defined(TRROJANSTREAM_SSE2_KERNELS)
+namespace {
+
+    /// <summary>
+    /// Vector traits for the SSE2 kernels.
+    /// </summary>
+    template<class S> struct sse2_traits { };
+
+    /// <summary>
+    /// Four 32-bit floating point numbers.
+    /// </summary>
+    template<> struct sse2_traits<float> {
+        typedef float scalar_type;
+        typedef __m128 vector_type;
+        static constexpr std::size_t width = 4;
+        static constexpr bool can_multiply = true;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm_add_ps(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type fmadd(const vector_type l,
+                const vector_type r, const vector_type a) {
+            return _mm_add_ps(_mm_mul_ps(l, r), a);
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm_loadu_ps(p);
+        }
+
+        static inline vector_type mul(const vector_type l,
+                const vector_type r) {
+            return _mm_mul_ps(l, r);
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm_set1_ps(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm_storeu_ps(p, v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm_stream_ps(p, v);
+        }
+    };
+
+    /// <summary>
+    /// Two 64-bit floating point numbers.
+    /// </summary>
+    template<> struct sse2_traits<double> {
+        typedef double scalar_type;
+        typedef __m128d vector_type;
+        static constexpr std::size_t width = 2;
+        static constexpr bool can_multiply = true;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm_add_pd(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type fmadd(const vector_type l,
+                const vector_type r, const vector_type a) {
+            return _mm_add_pd(_mm_mul_pd(l, r), a);
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm_loadu_pd(p);
+        }
+
+        static inline vector_type mul(const vector_type l,
+                const vector_type r) {
+            return _mm_mul_pd(l, r);
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm_set1_pd(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm_storeu_pd(p, v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm_stream_pd(p, v);
+        }
+    };
+
+    /// <summary>
+    /// Four 32-bit integers, which SSE2 cannot multiply.
+    /// </summary>
+    template<> struct sse2_traits<std::int32_t> {
+        typedef std::int32_t scalar_type;
+        typedef __m128i vector_type;
+        static constexpr std::size_t width = 4;
+        static constexpr bool can_multiply = false;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm_add_epi32(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm_set1_epi32(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm_stream_si128(reinterpret_cast<__m128i *>(p), v);
+        }
+    };
+
+    /// <summary>
+    /// Two 64-bit integers, which SSE2 cannot multiply.
+    /// </summary>
+    template<> struct sse2_traits<std::int64_t> {
+        typedef std::int64_t scalar_type;
+        typedef __m128i vector_type;
+        static constexpr std::size_t width = 2;
+        static constexpr bool can_multiply = false;
+
+        static inline vector_type add(const vector_type l,
+                const vector_type r) {
+            return _mm_add_epi64(l, r);
+        }
+
+        static inline void fence(void) {
+            _mm_sfence();
+        }
+
+        static inline vector_type load(const scalar_type *p) {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        }
+
+        static inline vector_type set1(const scalar_type s) {
+            return _mm_set1_epi64x(s);
+        }
+
+        static inline void store(scalar_type *p, const vector_type v) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+        }
+
+        static inline void stream(scalar_type *p, const vector_type v) {
+            _mm_stream_si128(reinterpret_cast<__m128i *>(p), v);
+        }
+    };
+
+}
+#endif /* defined(TRROJANSTREAM_SSE2_KERNELS) */
+
+
+/*
+ * trrojan::stream::detail::get_sse2_kernel
+ */
+template<class S>
+trrojan::stream::kernel_type<S> trrojan::stream::detail::get_sse2_kernel(
+        const task_type task, const store_mode mode) {
+#if defined(TRROJANSTREAM_SSE2_KERNELS)
+    return select_simd_kernel<sse2_traits<S>>(task, mode);
+#else /* defined(TRROJANSTREAM_SSE2_KERNELS) */
+    return nullptr;
+#endif /* defined(TRROJANSTREAM_SSE2_KERNELS) */
+}
+
+
+/*
+ * trrojan::stream::detail::get_sse2_multi_stream_kernel
+ */
+template<class S>
+trrojan::stream::multi_stream_kernel_type<S>
+trrojan::stream::detail::get_sse2_multi_stream_kernel(
+        const std::size_t reads, const std::size_t writes,
+        const store_mode mode) {
+#if defined(TRROJANSTREAM_SSE2_KERNELS)
+    return select_simd_multi_stream_kernel<sse2_traits<S>>(reads, writes, mode);
+#else /* defined(TRROJANSTREAM_SSE2_KERNELS) */
+    return nullptr;
+#endif /* defined(TRROJANSTREAM_SSE2_KERNELS) */
+}
+
+
+// Explicit instantiations for all scalar types.
+template trrojan::stream::kernel_type<float>
+trrojan::stream::detail::get_sse2_kernel<float>(const task_type,
+    const store_mode);
+template trrojan::stream::kernel_type<double>
+trrojan::stream::detail::get_sse2_kernel<double>(const task_type,
+    const store_mode);
+template trrojan::stream::kernel_type<std::int32_t>
+trrojan::stream::detail::get_sse2_kernel<std::int32_t>(const task_type,
+    const store_mode);
+template trrojan::stream::kernel_type<std::int64_t>
+trrojan::stream::detail::get_sse2_kernel<std::int64_t>(const task_type,
+    const store_mode);
+
+template trrojan::stream::multi_stream_kernel_type<float>
+trrojan::stream::detail::get_sse2_multi_stream_kernel<float>(
+    const std::size_t, const std::size_t, const store_mode);
+template trrojan::stream::multi_stream_kernel_type<double>
+trrojan::stream::detail::get_sse2_multi_stream_kernel<double>(
+    const std::size_t, const std::size_t, const store_mode);
+template trrojan::stream::multi_stream_kernel_type<std::int32_t>
+trrojan::stream::detail::get_sse2_multi_stream_kernel<std::int32_t>(
+    const std::size_t, const std::size_t, const store_mode);
+template trrojan::stream::multi_stream_kernel_type<std::int64_t>
+trrojan::stream::detail::get_sse2_multi_stream_kernel<std::int64_t>(
+    const std::size_t, const std::size_t, const store_mode);
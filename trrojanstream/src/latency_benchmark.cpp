@@ -0,0 +1,259 @@
+/// <copyright file="latency_benchmark.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "trrojan/stream/latency_benchmark.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "trrojan/log.h"
+#include "trrojan/perf_counters.h"
+#include "trrojan/timer.h"
+
+
+#define _TRROJANSTREAM_DEFINE_FACTOR(f)                                        \
+const std::string trrojan::stream::latency_benchmark::factor_##f(#f)
+
+_TRROJANSTREAM_DEFINE_FACTOR(accesses);
+_TRROJANSTREAM_DEFINE_FACTOR(iterations);
+_TRROJANSTREAM_DEFINE_FACTOR(page_size);
+_TRROJANSTREAM_DEFINE_FACTOR(perf_counters);
+_TRROJANSTREAM_DEFINE_FACTOR(stride);
+_TRROJANSTREAM_DEFINE_FACTOR(working_set);
+
+#undef _TRROJANSTREAM_DEFINE_FACTOR
+
+
+#define _TRROJANSTREAM_DEFINE_RES_NAME(r)                                      \
+const std::string trrojan::stream::latency_benchmark::result_name_##r(#r)
+
+_TRROJANSTREAM_DEFINE_RES_NAME(accesses);
+_TRROJANSTREAM_DEFINE_RES_NAME(latency_average);
+_TRROJANSTREAM_DEFINE_RES_NAME(latency_maximum);
+_TRROJANSTREAM_DEFINE_RES_NAME(latency_minimum);
+_TRROJANSTREAM_DEFINE_RES_NAME(time_average);
+_TRROJANSTREAM_DEFINE_RES_NAME(time_maximum);
+_TRROJANSTREAM_DEFINE_RES_NAME(time_minimum);
+
+#undef _TRROJANSTREAM_DEFINE_RES_NAME
+
+
+/*
+ * trrojan::stream::latency_benchmark::latency_benchmark
+ */
+trrojan::stream::latency_benchmark::latency_benchmark(void)
+        : trrojan::benchmark_base("latency") {
+    // If no working set is given, double the size from 4 KiB to 256 MiB,
+    // which covers all cache levels and main memory on current machines.
+    {
+        std::vector<std::uint64_t> sizes;
+        for (std::uint64_t s = 4 * 1024; s <= 256 * 1024 * 1024; s *= 2) {
+            sizes.push_back(s);
+        }
+        this->_default_configs.add_factor(factor::from_manifestations(
+            factor_working_set, sizes));
+    }
+
+    // If no stride is given, use one slot per cache line.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_stride, static_cast<std::uint64_t>(64)));
+
+    // If no number of accesses is given, use enough for the timer resolution.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_accesses, static_cast<std::uint64_t>(1 << 22)));
+
+    // If no number of iterations is specified, use a magic number.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_iterations, 5));
+
+    // Use regular pages unless requested otherwise.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_page_size, page_size_traits<page_size::regular>::name()));
+
+    // Do not capture performance counters unless requested.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_perf_counters, false));
+}
+
+
+/*
+ * trrojan::stream::latency_benchmark::~latency_benchmark
+ */
+trrojan::stream::latency_benchmark::~latency_benchmark(void) { }
+
+
+/*
+ * trrojan::stream::latency_benchmark::run
+ */
+trrojan::result trrojan::stream::latency_benchmark::run(
+        const configuration& config) {
+    typedef trrojan::timer::millis_type millis_type;
+    typedef std::numeric_limits<millis_type> timer_limits;
+
+    const auto workingSet = config.get<std::uint64_t>(factor_working_set);
+    const auto stride = config.get<std::uint64_t>(factor_stride);
+    const auto pages = parse_page_size(*config.find(factor_page_size));
+    const auto iterations = config.get<std::uint64_t>(factor_iterations);
+    const auto perfCounters = config.get<bool>(factor_perf_counters);
+    auto accesses = config.get<std::uint64_t>(factor_accesses);
+
+    if (stride < sizeof(void *)) {
+        throw std::invalid_argument("The stride of the latency benchmark "
+            "must be at least the size of a pointer.");
+    }
+    if (workingSet < stride) {
+        throw std::invalid_argument("The working set of the latency "
+            "benchmark must hold at least one slot.");
+    }
+    if (iterations < 1) {
+        throw std::invalid_argument("The latency benchmark requires at least "
+            "one iteration.");
+    }
+
+    trrojan::stream::buffer buffer;
+    buffer.allocate(static_cast<std::size_t>(workingSet), pages);
+    buffer.bind(0, buffer.size(), trrojan::stream::buffer::node_list());
+
+    // Build the ring and round the number of accesses up to full laps such
+    // that every slot is visited equally often.
+    const auto cntSlots = latency_benchmark::link(buffer,
+        static_cast<std::size_t>(stride));
+    accesses = std::max<std::uint64_t>(accesses, 1);
+    accesses = ((accesses + cntSlots - 1) / cntSlots) * cntSlots;
+
+    // Warm up the caches and the TLB with one lap.
+    auto cursor = latency_benchmark::chase(buffer.data<void>(), cntSlots);
+
+    auto minTime = (timer_limits::max)();
+    auto maxTime = (timer_limits::min)();
+    auto sumTime = static_cast<millis_type>(0);
+    auto sumCounters = perf_counter_group::invalid_values();
+    std::unique_ptr<perf_counter_group> counters;
+    trrojan::timer timer;
+
+    if (perfCounters) {
+        counters.reset(new perf_counter_group());
+    }
+
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        if (counters != nullptr) {
+            counters->start();
+        }
+        timer.start();
+        cursor = latency_benchmark::chase(cursor,
+            static_cast<std::size_t>(accesses));
+        auto time = timer.elapsed_millis();
+        if (counters != nullptr) {
+            perf_counter_group::accumulate(sumCounters, counters->stop());
+        }
+
+        if (time < minTime) {
+            minTime = time;
+        }
+        if (time > maxTime) {
+            maxTime = time;
+        }
+        sumTime += time;
+    }
+
+    // Consume the cursor, because we would otherwise measure nothing.
+    if (cursor == nullptr) {
+        throw std::logic_error("The pointer-chasing ring of the latency "
+            "benchmark is broken.");
+    }
+
+    auto avgTime = sumTime / static_cast<millis_type>(iterations);
+    auto toNanos = [accesses](const millis_type t) {
+        return (t * 1000.0 * 1000.0) / static_cast<double>(accesses);
+    };
+
+    // Report the counters per iteration like the times.
+    for (auto& c : sumCounters) {
+        if (c != perf_counter_group::invalid_value) {
+            c /= iterations;
+        }
+    }
+
+    basic_result::result_names_type names { result_name_accesses,
+        result_name_time_maximum, result_name_time_average,
+        result_name_time_minimum, result_name_latency_maximum,
+        result_name_latency_average, result_name_latency_minimum };
+    perf_counter_group::append_result_names(names, sumCounters);
+
+    basic_result::result_type values { accesses, maxTime, avgTime, minTime,
+        toNanos(maxTime), toNanos(avgTime), toNanos(minTime) };
+    perf_counter_group::append_results(values, sumCounters);
+
+    auto retval = std::make_shared<basic_result>(config, names);
+    retval->add(values);
+
+    return std::dynamic_pointer_cast<result::element_type>(retval);
+}
+
+
+/*
+ * trrojan::stream::latency_benchmark::chase
+ */
+void *trrojan::stream::latency_benchmark::chase(void *start,
+        const std::size_t cnt) {
+    auto p = start;
+    std::size_t i = 0;
+
+    // Unroll the loop such that the loop overhead does not hide behind the
+    // latency of L1 hits.
+    for (; i + 8 <= cnt; i += 8) {
+        p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p);
+    }
+
+    for (; i < cnt; ++i) {
+        p = *static_cast<void **>(p);
+    }
+
+    return p;
+}
+
+
+/*
+ * trrojan::stream::latency_benchmark::link
+ */
+std::size_t trrojan::stream::latency_benchmark::link(
+        trrojan::stream::buffer& buffer, const std::size_t stride) {
+    assert(stride >= sizeof(void *));
+    const auto cnt = buffer.size() / stride;
+    auto data = buffer.data<std::uint8_t>();
+    std::vector<std::size_t> order(cnt);
+    std::minstd_rand prng;
+
+    // Sattolo's algorithm yields a random permutation consisting of a single
+    // cycle, ie the chase visits all slots before it returns to the start.
+    for (std::size_t i = 0; i < cnt; ++i) {
+        order[i] = i;
+    }
+    for (std::size_t i = cnt - 1; i > 0; --i) {
+        std::uniform_int_distribution<std::size_t> dist(0, i - 1);
+        std::swap(order[i], order[dist(prng)]);
+    }
+
+    // Slot i points to slot order[i], which closes the cycle.
+    for (std::size_t i = 0; i < cnt; ++i) {
+        auto slot = reinterpret_cast<void **>(data + i * stride);
+        *slot = data + order[i] * stride;
+    }
+
+    return cnt;
+}
@@ -0,0 +1,446 @@
+/// <copyright file="memcpy_benchmark.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "trrojan/stream/memcpy_benchmark.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#include <intrin.h>
+#define TRROJANSTREAM_REP_MOVSB
+#elif (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)))
+#define TRROJANSTREAM_REP_MOVSB
+#endif /* (defined(_MSC_VER) && ... */
+
+#include "trrojan/constants.h"
+#include "trrojan/cpu_topology.h"
+#include "trrojan/log.h"
+#include "trrojan/timer.h"
+
+#include "trrojan/stream/buffer.h"
+#include "trrojan/stream/instruction_set.h"
+#include "trrojan/stream/kernel.h"
+#include "trrojan/stream/stream_benchmark.h"
+#include "trrojan/stream/worker_thread.h"
+
+
+namespace {
+
+    /// <summary>
+    /// The alignment of the chunks copied by the threads, which prevents
+    /// them from writing to the same cache line.
+    /// </summary>
+    const std::size_t chunk_alignment = 64;
+
+    /// <summary>
+    /// Answer the instruction set of the stream kernel used by
+    /// <paramref name="engine" />.
+    /// </summary>
+    trrojan::stream::instruction_set get_instruction_set(
+            const trrojan::stream::copy_engine engine) {
+        using trrojan::stream::copy_engine;
+        using trrojan::stream::instruction_set;
+
+        switch (engine) {
+            case copy_engine::sse2:
+            case copy_engine::sse2_non_temporal:
+                return instruction_set::sse2;
+
+            case copy_engine::avx2:
+            case copy_engine::avx2_non_temporal:
+                return instruction_set::avx2;
+
+            case copy_engine::avx512:
+            case copy_engine::avx512_non_temporal:
+                return instruction_set::avx512;
+
+            default:
+                return instruction_set::scalar;
+        }
+    }
+
+    /// <summary>
+    /// Answer the store mode of the stream kernel used by
+    /// <paramref name="engine" />.
+    /// </summary>
+    trrojan::stream::store_mode get_store_mode(
+            const trrojan::stream::copy_engine engine) {
+        using trrojan::stream::copy_engine;
+        using trrojan::stream::store_mode;
+
+        switch (engine) {
+            case copy_engine::sse2_non_temporal:
+            case copy_engine::avx2_non_temporal:
+            case copy_engine::avx512_non_temporal:
+                return store_mode::non_temporal;
+
+            default:
+                return store_mode::regular;
+        }
+    }
+
+    /// <summary>
+    /// Answer whether <paramref name="engine" /> uses a stream kernel.
+    /// </summary>
+    inline bool uses_kernel(const trrojan::stream::copy_engine engine) {
+        using trrojan::stream::copy_engine;
+        return ((engine != copy_engine::libc)
+            && (engine != copy_engine::rep_movsb));
+    }
+}
+
+
+#define _TRROJANSTREAM_DEFINE_FACTOR(f)                                        \
+const std::string trrojan::stream::memcpy_benchmark::factor_##f(#f)
+
+_TRROJANSTREAM_DEFINE_FACTOR(engine);
+_TRROJANSTREAM_DEFINE_FACTOR(iterations);
+_TRROJANSTREAM_DEFINE_FACTOR(page_size);
+_TRROJANSTREAM_DEFINE_FACTOR(placement);
+_TRROJANSTREAM_DEFINE_FACTOR(size);
+_TRROJANSTREAM_DEFINE_FACTOR(threads);
+
+#undef _TRROJANSTREAM_DEFINE_FACTOR
+
+
+/*
+ * trrojan::stream::memcpy_benchmark::is_supported
+ */
+bool trrojan::stream::memcpy_benchmark::is_supported(
+        const copy_engine engine) {
+    switch (engine) {
+        case copy_engine::libc:
+            return true;
+
+        case copy_engine::rep_movsb:
+#if defined(TRROJANSTREAM_REP_MOVSB)
+            return true;
+#else /* defined(TRROJANSTREAM_REP_MOVSB) */
+            return false;
+#endif /* defined(TRROJANSTREAM_REP_MOVSB) */
+
+        default:
+            return trrojan::stream::is_supported(get_instruction_set(engine));
+    }
+}
+
+
+/*
+ * trrojan::stream::memcpy_benchmark::memcpy_benchmark
+ */
+trrojan::stream::memcpy_benchmark::memcpy_benchmark(void)
+        : trrojan::benchmark_base("memcpy") {
+    // If no engine is given, compare all that the machine supports.
+    {
+        std::vector<std::string> engines;
+        auto add = [&engines](const copy_engine e, const std::string& n) {
+            if (memcpy_benchmark::is_supported(e)) {
+                engines.push_back(n);
+            }
+        };
+
+        add(copy_engine::libc,
+            copy_engine_traits<copy_engine::libc>::name());
+        add(copy_engine::rep_movsb,
+            copy_engine_traits<copy_engine::rep_movsb>::name());
+        add(copy_engine::sse2,
+            copy_engine_traits<copy_engine::sse2>::name());
+        add(copy_engine::sse2_non_temporal,
+            copy_engine_traits<copy_engine::sse2_non_temporal>::name());
+        add(copy_engine::avx2,
+            copy_engine_traits<copy_engine::avx2>::name());
+        add(copy_engine::avx2_non_temporal,
+            copy_engine_traits<copy_engine::avx2_non_temporal>::name());
+        add(copy_engine::avx512,
+            copy_engine_traits<copy_engine::avx512>::name());
+        add(copy_engine::avx512_non_temporal,
+            copy_engine_traits<copy_engine::avx512_non_temporal>::name());
+
+        this->_default_configs.add_factor(factor::from_manifestations(
+            factor_engine, engines));
+    }
+
+    // If no size is given, quadruple the size from 4 KiB to 4 GiB, which
+    // covers all cache levels and copies as large as whole data sets.
+    {
+        std::vector<std::uint64_t> sizes;
+        for (std::uint64_t s = 4 * 1024; s <= (static_cast<std::uint64_t>(4)
+                << 30); s *= 4) {
+            sizes.push_back(s);
+        }
+        this->_default_configs.add_factor(factor::from_manifestations(
+            factor_size, sizes));
+    }
+
+    // If no number of threads is given, compare a single thread to one
+    // thread per logical processor.
+    {
+        std::vector<std::uint64_t> threads { 1 };
+        auto cnt = cpu_topology::instance().logical_processors().size();
+        if (cnt > 1) {
+            threads.push_back(cnt);
+        }
+        this->_default_configs.add_factor(factor::from_manifestations(
+            factor_threads, threads));
+    }
+
+    // If no number of iterations is specified, use a magic number.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_iterations, static_cast<std::uint64_t>(5)));
+
+    // Use regular pages unless requested otherwise.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_page_size, page_size_traits<page_size::regular>::name()));
+
+    // Fill the physical cores first like the stream benchmark.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_placement,
+        thread_placement_traits<thread_placement::compact>::name()));
+}
+
+
+/*
+ * trrojan::stream::memcpy_benchmark::~memcpy_benchmark
+ */
+trrojan::stream::memcpy_benchmark::~memcpy_benchmark(void) { }
+
+
+/*
+ * trrojan::stream::memcpy_benchmark::run
+ */
+trrojan::result trrojan::stream::memcpy_benchmark::run(
+        const configuration& config) {
+    typedef trrojan::constants<double> constants;
+    typedef trrojan::timer::millis_type millis_type;
+    typedef std::numeric_limits<millis_type> timer_limits;
+    typedef std::int64_t item_type;
+
+    // The start and the end of a copy of a single thread. The range is
+    // computed from the raw timestamps, because the milliseconds since the
+    // epoch cannot resolve the copies of small buffers.
+    struct measurement {
+        trrojan::timer::value_type start;
+        trrojan::timer::value_type stop;
+    };
+
+    const auto engine = parse_engine(*config.find(factor_engine));
+    const auto iterations = config.get<std::uint64_t>(factor_iterations);
+    const auto pages = parse_page_size(*config.find(factor_page_size));
+    const auto placement = parse_placement(*config.find(factor_placement));
+    const auto size = static_cast<std::size_t>(
+        config.get<std::uint64_t>(factor_size));
+    const auto threads = config.get<std::uint64_t>(factor_threads);
+    kernel_type<item_type> kernel = nullptr;
+
+    if (!memcpy_benchmark::is_supported(engine)) {
+        throw std::invalid_argument("The requested copy engine is not "
+            "supported on this machine.");
+    }
+    if (size < 1) {
+        throw std::invalid_argument("The memcpy benchmark must copy at least "
+            "one byte.");
+    }
+    if (iterations < 1) {
+        throw std::invalid_argument("The memcpy benchmark requires at least "
+            "one iteration.");
+    }
+    if (threads < 1) {
+        throw std::invalid_argument("The memcpy benchmark requires at least "
+            "one thread.");
+    }
+
+    if (uses_kernel(engine)) {
+        kernel = get_kernel<item_type>(get_instruction_set(engine),
+            task_type::copy, 1, get_store_mode(engine));
+    }
+
+    // Do not start threads that would not have a cache line to copy.
+    const auto parallelism = static_cast<std::size_t>((std::min)(threads,
+        static_cast<std::uint64_t>((size + chunk_alignment - 1)
+        / chunk_alignment)));
+    const auto chunk = ((size + parallelism - 1) / parallelism
+        + chunk_alignment - 1) / chunk_alignment * chunk_alignment;
+    if (parallelism < threads) {
+        log::instance().write(log_level::verbose, "Only {} threads are used "
+            "to copy {} bytes.\n", parallelism, size);
+    }
+
+    trrojan::stream::buffer src;
+    trrojan::stream::buffer dst;
+    src.allocate(size, pages);
+    dst.allocate(size, pages);
+
+    auto barrier = worker_thread::make_barrier(parallelism);
+    std::vector<std::exception_ptr> errors(parallelism);
+    std::vector<std::vector<measurement>> measurements(parallelism,
+        std::vector<measurement>(static_cast<std::size_t>(iterations + 1)));
+    auto processors = worker_thread::place(placement, parallelism);
+
+    auto body = [&](const std::size_t rank) {
+        const auto begin = (std::min)(rank * chunk, size);
+        const auto cnt = (std::min)(begin + chunk, size) - begin;
+        auto s = src.data<std::uint8_t>() + begin;
+        auto d = dst.data<std::uint8_t>() + begin;
+
+        try {
+            worker_thread::pin(processors[rank]);
+        } catch (...) {
+            errors[rank] = std::current_exception();
+        }
+
+        // Touch the chunk from the pinned thread such that the pages are
+        // placed on its NUMA node. The source must not be copied from the
+        // shared zero page.
+        for (std::size_t i = 0; i < cnt; ++i) {
+            s[i] = static_cast<std::uint8_t>(begin + i + 1);
+        }
+        std::memset(d, 0, cnt);
+
+        barrier->arrive_and_wait();
+        for (auto& e : errors) {
+            if (e != nullptr) {
+                return;
+            }
+        }
+
+        for (auto& m : measurements[rank]) {
+            barrier->arrive_and_wait();
+            m.start = trrojan::timer::now();
+
+            switch (engine) {
+                case copy_engine::libc:
+                    std::memcpy(d, s, cnt);
+                    break;
+
+                case copy_engine::rep_movsb:
+                    memcpy_benchmark::rep_movsb(d, s, cnt);
+                    break;
+
+                default: {
+                    // The kernel copies whole items, so the bytes of an
+                    // incomplete item at the end of the buffer are copied
+                    // separately.
+                    auto items = cnt / sizeof(item_type);
+                    auto tail = items * sizeof(item_type);
+                    kernel(reinterpret_cast<const item_type *>(s),
+                        reinterpret_cast<const item_type *>(s),
+                        reinterpret_cast<item_type *>(d), 0, items, 1, 0);
+                    std::memcpy(d + tail, s + tail, cnt - tail);
+                    } break;
+            }
+
+            m.stop = trrojan::timer::now();
+        }
+    };
+
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(parallelism);
+        for (std::size_t r = 0; r < parallelism; ++r) {
+            workers.emplace_back(body, r);
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+    for (auto& e : errors) {
+        if (e != nullptr) {
+            std::rethrow_exception(e);
+        }
+    }
+
+    // Consume the copy, because we would otherwise measure nothing.
+    if (std::memcmp(src.data<void>(), dst.data<void>(), size) != 0) {
+        throw std::logic_error("The memcpy benchmark produced a wrong copy.");
+    }
+
+    basic_result::result_names_type names {
+        stream_benchmark::result_name_range_start,
+        stream_benchmark::result_name_range_total,
+        stream_benchmark::result_name_time_maximum,
+        stream_benchmark::result_name_time_average,
+        stream_benchmark::result_name_time_minimum,
+        stream_benchmark::result_name_rate_minimum,
+        stream_benchmark::result_name_rate_average,
+        stream_benchmark::result_name_rate_maximum,
+        stream_benchmark::result_name_rate_total };
+    auto retval = std::make_shared<basic_result>(config, names);
+
+    // The copy reads and writes each byte like the copy task of the stream
+    // benchmark. Skip the first iteration, which warmed up the caches.
+    auto toMegabytes = [](const std::size_t cnt) {
+        return 2.0 * static_cast<double>(cnt) / constants::bytes_per_megabyte;
+    };
+
+    for (std::size_t i = 1; i < iterations + 1; ++i) {
+        auto minStart = measurements[0][i].start;
+        auto maxStart = measurements[0][i].start;
+        auto maxStop = measurements[0][i].stop;
+        auto minTime = (timer_limits::max)();
+        auto maxTime = (timer_limits::min)();
+        auto minRate = (std::numeric_limits<double>::max)();
+        auto maxRate = static_cast<double>(0);
+        auto sumTime = static_cast<millis_type>(0);
+        auto sumRate = static_cast<double>(0);
+
+        for (std::size_t r = 0; r < parallelism; ++r) {
+            auto& m = measurements[r][i];
+            auto time = timer::to_millis(m.stop - m.start);
+            auto begin = (std::min)(r * chunk, size);
+            auto cnt = (std::min)(begin + chunk, size) - begin;
+            auto rate = toMegabytes(cnt)
+                / (time / constants::millis_per_second);
+
+            minStart = (std::min)(minStart, m.start);
+            maxStart = (std::max)(maxStart, m.start);
+            maxStop = (std::max)(maxStop, m.stop);
+            minTime = (std::min)(minTime, time);
+            maxTime = (std::max)(maxTime, time);
+            minRate = (std::min)(minRate, rate);
+            maxRate = (std::max)(maxRate, rate);
+            sumTime += time;
+            sumRate += rate;
+        }
+
+        auto rangeStart = timer::to_millis(maxStart - minStart);
+        auto rangeTotal = timer::to_millis(maxStop - minStart);
+        auto totalRate = toMegabytes(size)
+            / (rangeTotal / constants::millis_per_second);
+
+        retval->add({ rangeStart, rangeTotal, maxTime,
+            sumTime / static_cast<millis_type>(parallelism), minTime,
+            minRate, sumRate / static_cast<double>(parallelism), maxRate,
+            totalRate });
+    }
+
+    return std::dynamic_pointer_cast<result::element_type>(retval);
+}
+
+
+/*
+ * trrojan::stream::memcpy_benchmark::rep_movsb
+ */
+void trrojan::stream::memcpy_benchmark::rep_movsb(void *dst, const void *src,
+        const std::size_t cnt) {
+#if (defined(_MSC_VER) && defined(TRROJANSTREAM_REP_MOVSB))
+    ::__movsb(static_cast<unsigned char *>(dst),
+        static_cast<const unsigned char *>(src), cnt);
+#elif defined(TRROJANSTREAM_REP_MOVSB)
+    auto d = dst;
+    auto s = src;
+    auto n = cnt;
+    asm volatile("rep movsb" : "+D" (d), "+S" (s), "+c" (n) : : "memory");
+#else /* (defined(_MSC_VER) && defined(TRROJANSTREAM_REP_MOVSB)) */
+    throw std::logic_error("rep movsb is not supported on this platform.");
+#endif /* (defined(_MSC_VER) && defined(TRROJANSTREAM_REP_MOVSB)) */
+}
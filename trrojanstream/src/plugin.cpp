@@ -6,6 +6,10 @@
 
 #include "trrojan/stream/plugin.h"
 
+#include "trrojan/stream/allocation_benchmark.h"
+#include "trrojan/stream/coherence_benchmark.h"
+#include "trrojan/stream/latency_benchmark.h"
+#include "trrojan/stream/memcpy_benchmark.h"
 #include "trrojan/stream/stream_benchmark.h"
 
 
@@ -28,7 +32,11 @@ trrojan::stream::plugin::~plugin(void) { }
  */
 size_t trrojan::stream::plugin::create_benchmarks(benchmark_list& dst) const {
     dst.push_back(std::make_shared<stream_benchmark>());
-    return 1;
+    dst.push_back(std::make_shared<latency_benchmark>());
+    dst.push_back(std::make_shared<coherence_benchmark>());
+    dst.push_back(std::make_shared<memcpy_benchmark>());
+    dst.push_back(std::make_shared<allocation_benchmark>());
+    return 5;
 }
 
 
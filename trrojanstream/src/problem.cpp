@@ -6,6 +6,14 @@
 
 #include "trrojan/stream/problem.h"
 
+#include <limits>
+#include <numeric>
+
+#include "trrojan/log.h"
+#include "trrojan/timer.h"
+
+#include "trrojan/stream/kernel.h"
+
 
 /*
  * trrojan::stream::problem::problem
@@ -14,31 +22,345 @@ trrojan::stream::problem::problem(const scalar_type_t scalar,
         const trrojan::variant& value,
         const task_type_t task,
         const access_pattern_t pattern,
-        const size_t size,
-        const size_t iterations,
-        const size_t parallelism)
+        const parameters& params)
         : _access_pattern(pattern),
-        _iterations(iterations),
-        _parallelism(parallelism),
+        _block_size(params.block_size),
+        _chain_length(params.chain_length),
+        _instruction_set(params.isa),
+        _iterations(params.iterations),
+        _numa_policy(params.numa),
+        _parallelism(params.parallelism),
+        _perf_counters(params.perf_counters),
+        _placement(params.placement),
+        _read_streams(params.read_streams),
+        _real_time_priority(params.real_time_priority),
         _scalar_size(0),
         _scalar_type(scalar),
         _scalar_value(value),
-        _task_type(task) {
+        _scaling(params.scaling),
+        _store_mode(params.store),
+        _stride(params.stride),
+        _subtract_timer_overhead(params.subtract_timer_overhead),
+        _task_type(task),
+        _verify(params.verify),
+        _write_streams(params.write_streams) {
+    auto cnt = (std::max)(params.size, static_cast<size_t>(1));
+
+    if (this->_stride < 1) {
+        throw std::invalid_argument("The stride of the access pattern must "
+            "be at least one.");
+    }
+    if (this->_block_size < 1) {
+        throw std::invalid_argument("The block size of the access pattern "
+            "must be at least one.");
+    }
+
+    if (this->_parallelism < 1) {
+        this->_parallelism = 1;
+    }
+
+    if (this->_subtract_timer_overhead) {
+        // Calibrate now rather than in the first measured iteration.
+        trrojan::timer::calibrate();
+    }
+
+    if (this->_task_type == task_type_t::multi_stream) {
+        if ((this->_read_streams < 1) || (this->_read_streams > max_streams)) {
+            throw std::invalid_argument("The number of read streams must be "
+                "within [1, 8].");
+        }
+        if ((this->_write_streams < 1)
+                || (this->_write_streams > max_streams)) {
+            throw std::invalid_argument("The number of write streams must be "
+                "within [1, 8].");
+        }
+        if (this->_access_pattern == access_pattern_t::random) {
+            throw std::invalid_argument("The multi-stream task does not "
+                "support random accesses.");
+        }
+    } else {
+        // The other tasks only use the arrays a, b and c.
+        this->_read_streams = 2;
+        this->_write_streams = 1;
+    }
+
+    if (this->_access_pattern == access_pattern_t::blocked) {
+        // Make sure that the problem consists of full blocks. For weak
+        // scaling, this also ensures that each rank processes the same number
+        // of blocks.
+        cnt = ((cnt + this->_block_size - 1) / this->_block_size)
+            * this->_block_size;
+    }
+
+    switch (this->_scaling) {
+        case scaling_t::strong:
+            if (cnt < this->_parallelism) {
+                throw std::invalid_argument("The problem size for strong "
+                    "scaling must be at least the number of threads.");
+            }
+            break;
+
+        case scaling_t::weak:
+        default:
+            cnt *= this->_parallelism;
+            break;
+    }
+
     switch (this->_scalar_type) {
         case trrojan::stream::scalar_type::float32:
-            this->allocate<trrojan::stream::scalar_type::float32>(size);
+            this->allocate<trrojan::stream::scalar_type::float32>(cnt, params.pages);
             break;
 
         case trrojan::stream::scalar_type::float64:
-            this->allocate<trrojan::stream::scalar_type::float64>(size);
+            this->allocate<trrojan::stream::scalar_type::float64>(cnt, params.pages);
             break;
 
         case trrojan::stream::scalar_type::int32:
-            this->allocate<trrojan::stream::scalar_type::int32>(size);
+            this->allocate<trrojan::stream::scalar_type::int32>(cnt, params.pages);
             break;
 
         case trrojan::stream::scalar_type::int64:
-            this->allocate<trrojan::stream::scalar_type::int64>(size);
+            this->allocate<trrojan::stream::scalar_type::int64>(cnt, params.pages);
             break;
     }
+
+    if (this->_access_pattern == access_pattern_t::random) {
+        // The first rank has the largest slice.
+        if (this->size(0) > (std::numeric_limits<index_type>::max)()) {
+            throw std::invalid_argument("The problem size per thread is too "
+                "large for the index buffer of random accesses.");
+        }
+        this->_indices.allocate(this->total_size() * sizeof(index_type),
+            params.pages);
+    }
+}
+
+
+/*
+ * trrojan::stream::problem::bind
+ */
+void trrojan::stream::problem::bind(
+        const cpu_topology::processor_list& processors) {
+    if (processors.size() != this->_parallelism) {
+        throw std::invalid_argument("A logical processor must be specified "
+            "for each rank of the problem.");
+    }
+
+    auto nodes = cpu_topology::instance().numa_nodes();
+    auto policy = this->_numa_policy;
+
+    if ((policy != numa_policy_t::local) && (nodes.size() < 2)) {
+        log::instance().write(log_level::warning, "The NUMA policy has no "
+            "effect on a system with a single NUMA node. The memory will be "
+            "allocated locally.\n");
+        policy = numa_policy_t::local;
+    }
+
+    for (size_t r = 0; r < this->_parallelism; ++r) {
+        buffer::node_list target;
+
+        switch (policy) {
+            case numa_policy_t::interleave:
+                target = nodes;
+                break;
+
+            case numa_policy_t::remote_node: {
+                // Use the next node after the one of the processor such that
+                // the slices are spread over all remote nodes.
+                auto it = std::find(nodes.begin(), nodes.end(),
+                    processors[r].node);
+                if ((it == nodes.end()) || (++it == nodes.end())) {
+                    it = nodes.begin();
+                }
+                target.push_back(*it);
+                } break;
+
+            case numa_policy_t::local:
+            default:
+                break;
+        }
+
+        log::instance().write(log_level::verbose, "The slice of rank {} on "
+            "NUMA node {} is bound to {} NUMA node(s).\n", r,
+            processors[r].node, target.size());
+        const auto offset = this->offset(r) * this->_scalar_size;
+        const auto size = this->size_in_bytes(r);
+        this->_a.bind(offset, size, target);
+        this->_b.bind(offset, size, target);
+        this->_c.bind(offset, size, target);
+
+        for (auto& s : this->_streams) {
+            s.bind(offset, size, target);
+        }
+
+        if (this->_indices.size() > 0) {
+            this->_indices.bind(this->offset(r) * sizeof(index_type),
+                this->size(r) * sizeof(index_type), target);
+        }
+    }
+}
+
+
+/*
+ * trrojan::stream::problem::effective_bytes
+ */
+size_t trrojan::stream::problem::effective_bytes(
+        const size_t cnt_accesses, const size_t rank) const {
+    const auto items = this->items(rank);
+    const auto line = std::max(cache_line_size, this->_scalar_size);
+
+    switch (this->_access_pattern) {
+        case access_pattern_t::strided:
+            // Items closer than a cache line share the lines in between,
+            // otherwise, a whole line is transferred for every item.
+            return (items * cnt_accesses * std::min(line,
+                this->_stride * this->_scalar_size));
+
+        case access_pattern_t::random:
+            // Every gathered input costs a whole line, whereas the output and
+            // the index buffer are streamed.
+            assert(cnt_accesses > 0);
+            return (items * ((cnt_accesses - 1) * line + this->_scalar_size
+                + sizeof(index_type)));
+
+        default:
+            return this->useful_bytes(cnt_accesses, rank);
+    }
+}
+
+
+/*
+ * trrojan::stream::problem::flops_per_item
+ */
+size_t trrojan::stream::problem::flops_per_item(void) const {
+    switch (this->_task_type) {
+        case task_type_t::add:
+            return task_type_traits<task_type_t::add>::flops;
+
+        case task_type_t::copy:
+            return task_type_traits<task_type_t::copy>::flops;
+
+        case task_type_t::fma_chain: {
+            typedef task_type_traits<task_type_t::fma_chain> traits;
+            return (traits::flops + this->_chain_length * traits::chain_flops);
+            }
+
+        case task_type_t::multi_stream:
+            // All inputs are summed up once and copied to all outputs.
+            return (this->_read_streams - 1);
+
+        case task_type_t::scale:
+            return task_type_traits<task_type_t::scale>::flops;
+
+        case task_type_t::triad:
+            return task_type_traits<task_type_t::triad>::flops;
+
+        default:
+            return 0;
+    }
+}
+
+
+/*
+ * trrojan::stream::problem::footprint
+ */
+size_t trrojan::stream::problem::footprint(void) const {
+    return (this->total_size_in_bytes() * this->memory_accesses()
+        + this->_indices.size());
+}
+
+
+/*
+ * trrojan::stream::problem::items
+ */
+size_t trrojan::stream::problem::items(const size_t rank) const {
+    assert(rank < this->_parallelism);
+    const auto p = this->_parallelism;
+
+    switch (this->_access_pattern) {
+        case access_pattern_t::strided:
+            return ((this->size(rank) + this->_stride - 1) / this->_stride);
+
+        case access_pattern_t::interleaved: {
+            // The rank processes every p-th item starting at its rank.
+            const auto total = this->total_size();
+            return (rank < total) ? ((total - rank - 1) / p + 1) : 0;
+            }
+
+        case access_pattern_t::blocked: {
+            // The rank processes every p-th block starting at its rank.
+            const auto blocks = this->total_size() / this->_block_size;
+            const auto cnt = (rank < blocks)
+                ? ((blocks - rank - 1) / p + 1)
+                : 0;
+            return (cnt * this->_block_size);
+            }
+
+        default:
+            return this->size(rank);
+    }
+}
+
+
+/*
+ * trrojan::stream::problem::initialise
+ */
+void trrojan::stream::problem::initialise(const size_t rank) {
+    switch (this->_scalar_type) {
+        case trrojan::stream::scalar_type::float32:
+            this->initialise<trrojan::stream::scalar_type::float32>(rank);
+            break;
+
+        case trrojan::stream::scalar_type::float64:
+            this->initialise<trrojan::stream::scalar_type::float64>(rank);
+            break;
+
+        case trrojan::stream::scalar_type::int32:
+            this->initialise<trrojan::stream::scalar_type::int32>(rank);
+            break;
+
+        case trrojan::stream::scalar_type::int64:
+            this->initialise<trrojan::stream::scalar_type::int64>(rank);
+            break;
+    }
+
+    if (this->_indices.size() > 0) {
+        // Shuffle the items of the rank, which are addressed relative to the
+        // begin of its slice.
+        const auto cnt = this->size(rank);
+        auto begin = this->indices() + this->offset(rank);
+        std::minstd_rand rng(static_cast<std::minstd_rand::result_type>(
+            rank + 1));
+        std::iota(begin, begin + cnt, static_cast<index_type>(0));
+        std::shuffle(begin, begin + cnt, rng);
+    }
+}
+
+
+/*
+ * trrojan::stream::problem::memory_accesses
+ */
+size_t trrojan::stream::problem::memory_accesses(void) const {
+    switch (this->_task_type) {
+        case task_type_t::add:
+            return task_type_traits<task_type_t::add>::memory_accesses;
+
+        case task_type_t::copy:
+            return task_type_traits<task_type_t::copy>::memory_accesses;
+
+        case task_type_t::fma_chain:
+            return task_type_traits<task_type_t::fma_chain>::memory_accesses;
+
+        case task_type_t::multi_stream:
+            return (this->_read_streams + this->_write_streams);
+
+        case task_type_t::scale:
+            return task_type_traits<task_type_t::scale>::memory_accesses;
+
+        case task_type_t::triad:
+            return task_type_traits<task_type_t::triad>::memory_accesses;
+
+        default:
+            return 0;
+    }
 }
@@ -6,24 +6,65 @@
 
 #include "trrojan/stream/stream_benchmark.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
+#include <set>
 
+#include "trrojan/cpu_topology.h"
 #include "trrojan/factor_enum.h"
 #include "trrojan/factor_range.h"
+#include "trrojan/shard.h"
 #include "trrojan/system_factors.h"
 #include "trrojan/timer.h"
 
 
+namespace {
+
+    /// <summary>
+    /// Creates a copy of <paramref name="c" /> with the value of
+    /// <paramref name="name" /> replaced by <paramref name="value" />.
+    /// </summary>
+    trrojan::configuration replace_factor(const trrojan::configuration& c,
+            const std::string& name, const trrojan::variant& value) {
+        trrojan::configuration retval;
+        for (auto& f : c) {
+            if (f.name() == name) {
+                retval.add(name, value);
+            } else {
+                retval.add(f);
+            }
+        }
+        return retval;
+    }
+}
+
+
 #define _TRROJANSTREAM_DEFINE_FACTOR(f)                                        \
 const std::string trrojan::stream::stream_benchmark::factor_##f(#f)
 
 _TRROJANSTREAM_DEFINE_FACTOR(access_pattern);
+_TRROJANSTREAM_DEFINE_FACTOR(block_size);
+_TRROJANSTREAM_DEFINE_FACTOR(chain_length);
+_TRROJANSTREAM_DEFINE_FACTOR(detailed_results);
+_TRROJANSTREAM_DEFINE_FACTOR(instruction_set);
 _TRROJANSTREAM_DEFINE_FACTOR(iterations);
+_TRROJANSTREAM_DEFINE_FACTOR(numa_policy);
+_TRROJANSTREAM_DEFINE_FACTOR(page_size);
+_TRROJANSTREAM_DEFINE_FACTOR(perf_counters);
+_TRROJANSTREAM_DEFINE_FACTOR(placement);
 _TRROJANSTREAM_DEFINE_FACTOR(problem_size);
+_TRROJANSTREAM_DEFINE_FACTOR(read_write_ratio);
+_TRROJANSTREAM_DEFINE_FACTOR(real_time_priority);
 _TRROJANSTREAM_DEFINE_FACTOR(scalar);
 _TRROJANSTREAM_DEFINE_FACTOR(scalar_type);
+_TRROJANSTREAM_DEFINE_FACTOR(scaling);
+_TRROJANSTREAM_DEFINE_FACTOR(store_mode);
+_TRROJANSTREAM_DEFINE_FACTOR(stride);
+_TRROJANSTREAM_DEFINE_FACTOR(subtract_timer_overhead);
 _TRROJANSTREAM_DEFINE_FACTOR(task_type);
 _TRROJANSTREAM_DEFINE_FACTOR(threads);
+_TRROJANSTREAM_DEFINE_FACTOR(verify);
 
 #undef _TRROJANSTREAM_DEFINE_FACTOR
 
@@ -31,21 +72,52 @@ _TRROJANSTREAM_DEFINE_FACTOR(threads);
 #define _TRROJANSTREAM_DEFINE_RES_NAME(r)                                      \
 const std::string trrojan::stream::stream_benchmark::result_name_##r(#r)
 
+_TRROJANSTREAM_DEFINE_RES_NAME(arithmetic_intensity);
+_TRROJANSTREAM_DEFINE_RES_NAME(arrival_offset);
+_TRROJANSTREAM_DEFINE_RES_NAME(barrier_skew);
+_TRROJANSTREAM_DEFINE_RES_NAME(cache_level);
+_TRROJANSTREAM_DEFINE_RES_NAME(flop_rate);
+_TRROJANSTREAM_DEFINE_RES_NAME(flop_rate_aggregated);
+_TRROJANSTREAM_DEFINE_RES_NAME(flop_rate_total);
+_TRROJANSTREAM_DEFINE_RES_NAME(flops);
+_TRROJANSTREAM_DEFINE_RES_NAME(iteration);
+_TRROJANSTREAM_DEFINE_RES_NAME(parallel_efficiency);
+_TRROJANSTREAM_DEFINE_RES_NAME(processor);
+_TRROJANSTREAM_DEFINE_RES_NAME(rank);
+_TRROJANSTREAM_DEFINE_RES_NAME(rate);
 _TRROJANSTREAM_DEFINE_RES_NAME(rate_aggregated);
 _TRROJANSTREAM_DEFINE_RES_NAME(rate_average);
+_TRROJANSTREAM_DEFINE_RES_NAME(rate_effective);
+_TRROJANSTREAM_DEFINE_RES_NAME(rate_effective_aggregated);
+_TRROJANSTREAM_DEFINE_RES_NAME(rate_effective_total);
 _TRROJANSTREAM_DEFINE_RES_NAME(rate_maximum);
 _TRROJANSTREAM_DEFINE_RES_NAME(rate_minimum);
 _TRROJANSTREAM_DEFINE_RES_NAME(rate_total);
 _TRROJANSTREAM_DEFINE_RES_NAME(range_start);
 _TRROJANSTREAM_DEFINE_RES_NAME(range_total);
+_TRROJANSTREAM_DEFINE_RES_NAME(start_offset);
+_TRROJANSTREAM_DEFINE_RES_NAME(time);
 _TRROJANSTREAM_DEFINE_RES_NAME(time_average);
 _TRROJANSTREAM_DEFINE_RES_NAME(time_maximum);
 _TRROJANSTREAM_DEFINE_RES_NAME(time_minimum);
 _TRROJANSTREAM_DEFINE_RES_NAME(time_slowest);
+_TRROJANSTREAM_DEFINE_RES_NAME(verified);
 
 #undef _TRROJANSTREAM_DEFINE_RES_NAME
 
 
+/*
+ * trrojan::stream::stream_benchmark::auto_problem_size
+ */
+const std::string trrojan::stream::stream_benchmark::auto_problem_size("auto");
+
+
+/*
+ * trrojan::stream::stream_benchmark::auto_threads
+ */
+const std::string trrojan::stream::stream_benchmark::auto_threads("auto");
+
+
 /*
  * trrojan::stream::stream_benchmark::stream_benchmark
  */
@@ -74,11 +146,55 @@ trrojan::stream::stream_benchmark::stream_benchmark(void)
     this->_default_configs.add_factor(factor::from_manifestations(
         factor_threads, { 1u, lc }));
 
-    // If no problem size is given, test all all of them.
+    // If no NUMA policy is specified, allocate memory locally.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_numa_policy, numa_policy_traits<numa_policy::local>::name()));
+
+    // If no scaling is specified, give each thread its own problem.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_scaling, scaling_traits<scaling::weak>::name()));
+
+    // If no page size is specified, use the default of the system.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_page_size, page_size_traits<page_size::regular>::name()));
+
+    // Aggregate the threads of each iteration unless requested otherwise.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_detailed_results, false));
+
+    // Do not capture performance counters unless requested.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_perf_counters, false));
+
+    // Do not use real-time scheduling unless requested.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_real_time_priority, false));
+
+    // Do not check the results unless requested.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_verify, false));
+
+    // Report the raw timings unless requested otherwise.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_subtract_timer_overhead, false));
+
+    // If no placement is specified, use one physical core per thread.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_placement,
+        thread_placement_traits<thread_placement::compact>::name()));
+
+    // If no problem size is given, test some sizes that exceed the caches.
     this->_default_configs.add_factor(factor::from_manifestations(
         factor_problem_size,
-        //8000000));
-        worker_thread::problem_sizes::to_vector()));
+        std::vector<std::uint64_t> { 2000000, 10000000, 20000000 }));
+
+    // If no instruction set is given, use the best one the CPU supports.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_instruction_set, to_string(best_instruction_set())));
+
+    // If no store mode is given, use regular stores like STREAM does.
+    this->_default_configs.add_factor(factor::from_manifestations(
+        factor_store_mode, store_mode_traits<store_mode::regular>::name()));
 
     // Enable all tasks by default.
     this->_default_configs.add_factor(factor::from_manifestations(
@@ -99,39 +215,11 @@ trrojan::stream::stream_benchmark::~stream_benchmark(void) { }
  * trrojan::stream::stream_benchmark::run
  */
 size_t trrojan::stream::stream_benchmark::run(const configuration_set& configs,
-        const on_result_callback& callback, const cool_down& coolDown) {
-    cool_down_evaluator cde(coolDown);
-    std::vector<std::string> changed;
-    size_t retval = 0;
-
-    // Check that caller has provided all required factors.
-    this->check_required_factors(configs);
-
-    // Merge missing factors from default configuration.
-    auto c = configs;
-    c.merge(this->_default_configs, false);
-
-    // Invoke each configuration.
-    c.foreach_configuration([&](const trrojan::configuration& c) {
-        //changed.clear();
-        //this->check_changed_factors(c, std::back_inserter(changed));
-        //this->log_run(c);
-        //std::cout << std::endl;
-        //retval.push_back(this->run(c));
-        //return true;
-        // TODO: optimise reallocs.
-        cde.check();
-        try {
-            this->log_run(c);
-            ++retval;
-            return callback(std::move(this->run(c)));
-        } catch (const std::exception& ex) {
-            log::instance().write_line(ex);
-            return false;
-        }
-    });
-
-    return retval;
+        const on_result_callback& callback, const cool_down& coolDown,
+        const std::size_t continue_at) {
+    // Forget the single-threaded rates of a previous configuration set.
+    this->_baselines.clear();
+    return benchmark_base::run(configs, callback, coolDown, continue_at);
 }
 
 
@@ -140,11 +228,345 @@ size_t trrojan::stream::stream_benchmark::run(const configuration_set& configs,
  */
 trrojan::result trrojan::stream::stream_benchmark::run(
         const configuration& config) {
+    auto detailed = config.get<bool>(factor_detailed_results);
     auto problem = stream_benchmark::to_problem(config);
+    auto baseline = 0.0;
+
+    // Make sure that the single-threaded reference is measured before
+    // running the threads of this configuration.
+    if (!detailed && (problem->parallelism() > 1)) {
+        baseline = this->baseline(config);
+    }
+
     auto threads = worker_thread::create(problem);
     worker_thread::join(threads.begin(), threads.end());
-    return stream_benchmark::collect_results(config, problem, threads.begin(),
-        threads.end());
+
+    if (detailed) {
+        return stream_benchmark::collect_detailed_results(config, problem,
+            threads.begin(), threads.end());
+    } else {
+        auto retval = stream_benchmark::collect_results(config, problem,
+            threads.begin(), threads.end(), baseline);
+        if (problem->parallelism() == 1) {
+            this->_baselines[baseline_key(config)]
+                = stream_benchmark::average_rate_total(retval);
+        }
+        return retval;
+    }
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::expand_configuration
+ */
+std::vector<trrojan::configuration>
+trrojan::stream::stream_benchmark::expand_configuration(
+        const configuration& c) {
+    // Expand the automatic sweeps into concrete configurations, each of which
+    // is reported on its own. The thread counts must be expanded first,
+    // because the problem sizes depend on them.
+    std::vector<configuration> threads;
+    if (stream_benchmark::is_auto_threads(c)) {
+        for (auto t : stream_benchmark::auto_thread_counts(c)) {
+            threads.push_back(replace_factor(c, factor_threads, t));
+        }
+    } else {
+        threads.push_back(c);
+    }
+
+    std::vector<configuration> retval;
+    for (auto& t : threads) {
+        if (stream_benchmark::is_auto_problem_size(t)) {
+            for (auto s : stream_benchmark::auto_problem_sizes(t)) {
+                retval.push_back(replace_factor(t, factor_problem_size, s));
+            }
+        } else {
+            retval.push_back(std::move(t));
+        }
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::auto_problem_sizes
+ */
+std::vector<std::uint64_t>
+trrojan::stream::stream_benchmark::auto_problem_sizes(const configuration& c) {
+    // Two sizes per octave resolve the transitions without making the sweep
+    // too long. The sweep starts and ends two octaves beyond the caches.
+    const auto factor = std::sqrt(2.0);
+    const auto margin = 4.0;
+    std::vector<std::uint64_t> retval;
+    auto& topology = cpu_topology::instance();
+    auto& caches = topology.caches();
+    auto lc = topology.logical_processors().size();
+
+    // Allocate the smallest possible problem to learn how many bytes the
+    // configuration touches per item, including any index buffer.
+    configuration probe;
+    for (auto& f : c) {
+        if (f.name() != factor_problem_size) {
+            probe.add(f);
+        }
+    }
+    auto parallelism = c.get(factor_threads, 1);
+    probe.add(factor_problem_size,
+        static_cast<std::uint64_t>((std::max)(parallelism, 1)));
+    auto p = stream_benchmark::to_problem(probe);
+    auto bytesPerItem = static_cast<double>(p->footprint())
+        / static_cast<double>(p->total_size());
+    auto itemsPerSize = (p->scaling() == scaling::weak)
+        ? p->parallelism()
+        : static_cast<std::size_t>(1);
+
+    // Determine the range of the total working set that covers all caches.
+    // A cache holds the working set of the threads that share an instance of
+    // it, so the total working set at the boundary grows with the number of
+    // instances used.
+    auto first = (std::numeric_limits<double>::max)();
+    auto last = 0.0;
+    for (auto& cache : caches) {
+        auto available = (std::max)(lc / cache.sharing,
+            static_cast<std::size_t>(1));
+        auto instances = (std::min)(p->parallelism(), available);
+        auto boundary = static_cast<double>(cache.size * instances);
+        first = (std::min)(first, boundary);
+        last = (std::max)(last, boundary);
+    }
+
+    if (last <= 0.0) {
+        log::instance().write(log_level::warning, "The cache sizes of the "
+            "CPU are unknown. The automatic problem sizes will cover 16 KiB "
+            "to 1 GiB.\n");
+        first = 16.0 * 1024.0;
+        last = 1024.0 * 1024.0 * 1024.0;
+    }
+
+    first /= margin;
+    last *= margin;
+
+    for (auto b = first; b <= last * (1.0 + 1e-6); b *= factor) {
+        auto s = static_cast<std::uint64_t>(std::llround(b / bytesPerItem
+            / static_cast<double>(itemsPerSize)));
+        s = (std::max)(s, static_cast<std::uint64_t>(parallelism));
+        if (retval.empty() || (retval.back() != s)) {
+            retval.push_back(s);
+        }
+    }
+
+    log::instance().write(log_level::information, "The automatic problem "
+        "sizes range from {} to {} items.\n", retval.front(), retval.back());
+    return retval;
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::average_rate_total
+ */
+double trrojan::stream::stream_benchmark::average_rate_total(
+        const trrojan::result& result) {
+    assert(result != nullptr);
+    auto& names = result->result_names();
+    auto it = std::find(names.begin(), names.end(), result_name_rate_total);
+    auto cnt = result->measurements();
+    auto retval = 0.0;
+
+    if ((it != names.end()) && (cnt > 0)) {
+        auto n = static_cast<std::size_t>(std::distance(names.begin(), it));
+        for (std::size_t m = 0; m < cnt; ++m) {
+            retval += result->raw_result(m, n).as<double>();
+        }
+        retval /= cnt;
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::baseline
+ */
+double trrojan::stream::stream_benchmark::baseline(const configuration& c) {
+    auto key = baseline_key(c);
+    auto it = this->_baselines.find(key);
+
+    if (it == this->_baselines.end()) {
+        // The single-threaded run has not yet been measured (or the
+        // configuration set does not contain it), so do it now. Running the
+        // reference stores it in the cache.
+        configuration reference;
+        for (auto& f : c) {
+            if (f.name() == factor_threads) {
+                reference.add(factor_threads, static_cast<std::uint32_t>(1));
+            } else {
+                reference.add(f);
+            }
+        }
+
+        log::instance().write(log_level::information, "Measuring the "
+            "single-threaded reference for the parallel efficiency.\n");
+        this->run(reference);
+
+        it = this->_baselines.find(key);
+        assert(it != this->_baselines.end());
+    }
+
+    return it->second;
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::baseline_key
+ */
+std::string trrojan::stream::stream_benchmark::baseline_key(
+        const configuration& c) {
+    // The key is the configuration without the number of threads and the
+    // output format, which both do not change the reference. The system
+    // factors and the factors added by sharding must be excluded, too,
+    // because they change for every configuration, eg the timestamp.
+    configuration key;
+    for (auto& f : c) {
+        if ((f.name() != factor_threads)
+                && (f.name() != factor_detailed_results)
+                && !system_factors::is_system_factor(f.name())
+                && (f.name() != shard::entry_factor_name)
+                && (f.name() != shard::factor_name)) {
+            key.add(f);
+        }
+    }
+    return trrojan::to_string(key);
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::cache_level
+ */
+std::string trrojan::stream::stream_benchmark::cache_level(
+        const problem& problem) {
+    auto& topology = cpu_topology::instance();
+    auto footprint = static_cast<double>(problem.footprint());
+    auto lc = topology.logical_processors().size();
+
+    // The caches are sorted by level, so the first one that can hold the
+    // share of the working set of its instance is the one we measure.
+    for (auto& cache : topology.caches()) {
+        auto available = (std::max)(lc / cache.sharing,
+            static_cast<std::size_t>(1));
+        auto instances = (std::min)(problem.parallelism(), available);
+        if (footprint / instances <= static_cast<double>(cache.size)) {
+            return "L" + std::to_string(cache.level);
+        }
+    }
+
+    return "memory";
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::auto_thread_counts
+ */
+std::vector<std::uint32_t>
+trrojan::stream::stream_benchmark::auto_thread_counts(const configuration& c) {
+    auto& topology = cpu_topology::instance();
+    const auto lc = static_cast<std::uint32_t>(
+        topology.logical_processors().size());
+    const auto pc = static_cast<std::uint32_t>(topology.physical_cores());
+    const auto placement = parse_thread_placement(*c.find(factor_placement));
+    std::vector<std::uint32_t> retval { 1, pc, lc };
+
+    // Walk the processors in the order the placement assigns them to the
+    // ranks. Where the next rank would be the first on another package or
+    // another hardware thread of its core, the slope of the scaling curve
+    // is expected to change, so the number of ranks before it is measured.
+    {
+        auto processors = worker_thread::place(placement, lc);
+        std::set<std::uint32_t> packages;
+        std::set<std::uint32_t> smt;
+        for (std::uint32_t i = 0; i < lc; ++i) {
+            auto newPackage = packages.insert(processors[i].package).second;
+            auto newSmt = smt.insert(processors[i].smt).second;
+            if ((i > 0) && (newPackage || newSmt)) {
+                retval.push_back(i);
+            }
+        }
+    }
+
+    // Fill the gaps with the powers of two.
+    for (std::uint32_t t = 2; t < lc; t *= 2) {
+        retval.push_back(t);
+    }
+
+    std::sort(retval.begin(), retval.end());
+    retval.erase(std::unique(retval.begin(), retval.end()), retval.end());
+
+    {
+        std::string counts;
+        for (auto t : retval) {
+            counts += (counts.empty() ? "" : ", ") + std::to_string(t);
+        }
+        log::instance().write(log_level::information, "The automatic thread "
+            "counts for the {} placement are {}.\n",
+            c.find(factor_placement)->value().as<std::string>(), counts);
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::is_auto_problem_size
+ */
+bool trrojan::stream::stream_benchmark::is_auto_problem_size(
+        const configuration& c) {
+    auto it = c.find(factor_problem_size);
+    return ((it != c.end())
+        && (it->value().type() == variant_type::string)
+        && (it->value().as<std::string>() == auto_problem_size));
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::is_auto_threads
+ */
+bool trrojan::stream::stream_benchmark::is_auto_threads(
+        const configuration& c) {
+    auto it = c.find(factor_threads);
+    return ((it != c.end())
+        && (it->value().type() == variant_type::string)
+        && (it->value().as<std::string>() == auto_threads));
+}
+
+
+/*
+ * trrojan::stream::stream_benchmark::parse_read_write_ratio
+ */
+std::pair<std::size_t, std::size_t>
+trrojan::stream::stream_benchmark::parse_read_write_ratio(
+        const trrojan::named_variant& s) {
+    auto value = s.value().as<std::string>();
+    auto colon = value.find(':');
+
+    try {
+        if (colon != std::string::npos) {
+            std::size_t end = 0;
+            auto reads = std::stoul(value.substr(0, colon), &end);
+            auto ok = (end == colon);
+            auto rem = value.substr(colon + 1);
+            auto writes = std::stoul(rem, &end);
+            ok = ok && (end == rem.size());
+            if (ok) {
+                return std::make_pair(static_cast<std::size_t>(reads),
+                    static_cast<std::size_t>(writes));
+            }
+        }
+    } catch (const std::logic_error&) {
+        // Handled below.
+    }
+
+    throw std::invalid_argument("The read/write ratio \"" + value + "\" is "
+        "not of the form \"reads:writes\".");
 }
 
 
@@ -161,10 +583,37 @@ trrojan::stream::stream_benchmark::to_problem(const configuration& c) {
     auto value = c.find(factor_scalar)->value();
     auto task = parse_task_type(*c.find(factor_task_type));
     auto pattern = parse_access_pattern(*c.find(factor_access_pattern));
-    auto size = c.get(factor_problem_size, problem::default_problem_size);
-    auto iterations = c.get(factor_iterations, problem::default_iterations);
-    auto parallelism = c.get(factor_threads, 1);
 
-    return std::make_shared<problem>(scalar, value, task, pattern, size,
-        iterations, parallelism);
+    problem::parameters params;
+    params.block_size = c.get(factor_block_size, params.block_size);
+    params.chain_length = c.get(factor_chain_length, params.chain_length);
+    params.isa = parse_instruction_set(*c.find(factor_instruction_set));
+    params.iterations = c.get(factor_iterations, params.iterations);
+    params.numa = parse_numa_policy(*c.find(factor_numa_policy));
+    params.pages = parse_page_size(*c.find(factor_page_size));
+    params.parallelism = c.get(factor_threads, 1);
+    params.perf_counters = c.get<bool>(factor_perf_counters);
+    params.placement = parse_thread_placement(*c.find(factor_placement));
+    params.real_time_priority = c.get(factor_real_time_priority,
+        params.real_time_priority);
+    params.scaling = parse_scaling(*c.find(factor_scaling));
+    params.size = c.get(factor_problem_size, params.size);
+    params.store = parse_store_mode(*c.find(factor_store_mode));
+    params.stride = c.get(factor_stride, params.stride);
+    params.subtract_timer_overhead = c.get(factor_subtract_timer_overhead,
+        params.subtract_timer_overhead);
+    params.verify = c.get(factor_verify, params.verify);
+    if (c.contains(factor_read_write_ratio)) {
+        auto streams = parse_read_write_ratio(
+            *c.find(factor_read_write_ratio));
+        params.read_streams = streams.first;
+        params.write_streams = streams.second;
+    }
+
+    if (!is_supported(params.isa)) {
+        throw std::invalid_argument("The requested instruction set is not "
+            "supported on this machine.");
+    }
+
+    return std::make_shared<problem>(scalar, value, task, pattern, params);
 }
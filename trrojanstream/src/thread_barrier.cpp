@@ -0,0 +1,142 @@
+/// <copyright file="thread_barrier.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+/// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+/// Licensed under the MIT licence. See LICENCE.txt file in the project root for full licence information.
+/// </copyright>
+/// <author>Christoph Müller</author>
+
+#include "trrojan/stream/thread_barrier.h"
+
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif /* defined(_WIN32) */
+
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) \
+    || defined(__i386__))
+#include <immintrin.h>
+#define TRROJANSTREAM_SPIN_PAUSE() _mm_pause()
+#else /* (defined(_M_X64) || ... */
+#define TRROJANSTREAM_SPIN_PAUSE()
+#endif /* (defined(_M_X64) || ... */
+
+
+/*
+ * trrojan::stream::thread_barrier::default_spin_time
+ */
+const trrojan::stream::thread_barrier::duration_type
+trrojan::stream::thread_barrier::default_spin_time
+    = std::chrono::microseconds(100);
+
+
+/*
+ * trrojan::stream::thread_barrier::thread_barrier
+ */
+trrojan::stream::thread_barrier::thread_barrier(const std::size_t parallelism,
+        const duration_type spin_time)
+        : _arrived(0), _generation(0), _parked(0),
+        _parallelism(static_cast<std::uint32_t>(parallelism)),
+        _spin_time(spin_time) {
+    if (parallelism < 1) {
+        throw std::invalid_argument("A barrier must synchronise at least one "
+            "thread.");
+    }
+    if (parallelism > (std::numeric_limits<std::uint32_t>::max)()) {
+        throw std::invalid_argument("The barrier cannot synchronise the "
+            "requested number of threads.");
+    }
+}
+
+
+/*
+ * trrojan::stream::thread_barrier::arrive_and_wait
+ */
+void trrojan::stream::thread_barrier::arrive_and_wait(void) {
+    typedef std::chrono::steady_clock clock_type;
+
+    // Remember the generation before arriving, because the last thread will
+    // advance it as soon as we have arrived.
+    const auto generation = this->_generation.load(std::memory_order_acquire);
+
+    if (this->_arrived.fetch_add(1, std::memory_order_acq_rel) + 1
+            == this->_parallelism) {
+        // We are the last one, so reset the counter for the next generation
+        // before releasing the other threads. They can only arrive again
+        // after they have observed the new generation.
+        this->_arrived.store(0, std::memory_order_relaxed);
+        this->_generation.store(generation + 1);
+
+        // Only enter the kernel if any thread has given up spinning. This
+        // requires sequential consistency between publishing the generation
+        // and reading the number of parked threads.
+        if (this->_parked.load() > 0) {
+            thread_barrier::wake_all(this->_generation);
+        }
+        return;
+    }
+
+    // Spin for a bounded time. Checking the clock is much more expensive
+    // than checking the generation, so we only do that every few rounds.
+    if (this->_spin_time.count() > 0) {
+        const auto deadline = clock_type::now() + this->_spin_time;
+        for (std::uint32_t i = 1;; ++i) {
+            if (this->_generation.load(std::memory_order_acquire)
+                    != generation) {
+                return;
+            }
+            if (((i % 64) == 0) && (clock_type::now() >= deadline)) {
+                break;
+            }
+            TRROJANSTREAM_SPIN_PAUSE();
+        }
+    }
+
+    // Park until the generation changes. The increment of '_parked' must be
+    // visible before we check the generation for the last time, which is
+    // guaranteed by the sequentially consistent operations.
+    ++this->_parked;
+    while (this->_generation.load() == generation) {
+        thread_barrier::park(this->_generation, generation);
+    }
+    --this->_parked;
+}
+
+
+/*
+ * trrojan::stream::thread_barrier::park
+ */
+void trrojan::stream::thread_barrier::park(std::atomic<std::uint32_t>& word,
+        const std::uint32_t value) {
+#if defined(_WIN32)
+    auto v = value;
+    ::WaitOnAddress(&word, &v, sizeof(v), INFINITE);
+#elif defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word),
+        FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else /* defined(_WIN32) */
+    std::this_thread::yield();
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * trrojan::stream::thread_barrier::wake_all
+ */
+void trrojan::stream::thread_barrier::wake_all(
+        std::atomic<std::uint32_t>& word) {
+#if defined(_WIN32)
+    ::WakeByAddressAll(&word);
+#elif defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word),
+        FUTEX_WAKE_PRIVATE, (std::numeric_limits<int>::max)(), nullptr,
+        nullptr, 0);
+#else /* defined(_WIN32) */
+    // Parked threads yield in a loop on other platforms.
+#endif /* defined(_WIN32) */
+}
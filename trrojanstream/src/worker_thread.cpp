@@ -6,6 +6,13 @@
 
 #include "trrojan/stream/worker_thread.h"
 
+#include <map>
+#include <tuple>
+
+#if !defined(_WIN32)
+#include <sched.h>
+#endif /* !defined(_WIN32) */
+
 
 /*
  * trrojan::stream::worker_thread::create
@@ -30,18 +37,150 @@ trrojan::stream::worker_thread::create(problem_type problem) {
     }
 
     auto barrier = worker_thread::make_barrier(problem->parallelism());
+    auto processors = worker_thread::place(*problem);
+    assert(processors.size() == problem->parallelism());
+    problem->bind(processors);
 
     std::vector<pointer_type> retval;
     retval.reserve(problem->parallelism());
 
     for (size_t i = 0; i < problem->parallelism(); ++i) {
-        retval.push_back(worker_thread::create(problem, barrier, i));
+        auto& p = processors[i];
+        retval.push_back(worker_thread::create(problem, barrier, i,
+            cpu_topology::affinity_mask(p), p.group));
+    }
+
+    return retval;
+}
+
+
+/*
+ * trrojan::stream::worker_thread::make_barrier
+ */
+trrojan::stream::worker_thread::barrier_type
+trrojan::stream::worker_thread::make_barrier(const size_t parallelism) {
+    auto cntProcessors = cpu_topology::instance().logical_processors().size();
+    auto spinTime = (parallelism > cntProcessors)
+        ? thread_barrier::duration_type::zero()
+        : thread_barrier::default_spin_time;
+    return std::make_shared<thread_barrier>(parallelism, spinTime);
+}
+
+
+/*
+ * trrojan::stream::worker_thread::place
+ */
+trrojan::cpu_topology::processor_list trrojan::stream::worker_thread::place(
+        const problem& problem) {
+    return worker_thread::place(problem.placement(), problem.parallelism());
+}
+
+
+/*
+ * trrojan::stream::worker_thread::place
+ */
+trrojan::cpu_topology::processor_list trrojan::stream::worker_thread::place(
+        const thread_placement placement, const size_t parallelism) {
+    typedef cpu_topology::logical_processor processor;
+    typedef std::tuple<std::uint32_t, std::uint32_t, std::uint32_t,
+        std::uint32_t> key_type;
+
+    auto candidates = cpu_topology::instance().logical_processors();
+    cpu_topology::processor_list retval;
+
+    if (candidates.empty()) {
+        throw std::logic_error("No logical processor is available to place "
+            "the worker threads on.");
+    }
+
+    // For the scatter policy, we need the index of a core within its package
+    // in order to alternate between the packages.
+    std::map<std::uint32_t, std::uint32_t> localCores;
+    {
+        std::map<std::uint32_t, std::uint32_t> cntCores;
+        for (auto& c : candidates) {
+            if (localCores.find(c.core) == localCores.end()) {
+                localCores[c.core] = cntCores[c.package]++;
+            }
+        }
+    }
+
+    // Build the sort key that determines in which order the logical
+    // processors are assigned to the ranks. The ID is always the last
+    // criterion to make the order deterministic.
+    auto key = [placement, &localCores](const processor& p) {
+        switch (placement) {
+            case thread_placement::scatter:
+                return key_type(p.smt, localCores[p.core], p.package, p.id);
+
+            case thread_placement::smt_siblings:
+                return key_type(p.package, p.core, p.smt, p.id);
+
+            case thread_placement::compact:
+            default:
+                return key_type(p.smt, p.package, p.core, p.id);
+        }
+    };
+
+    std::sort(candidates.begin(), candidates.end(),
+        [&key](const processor& l, const processor& r) {
+            return (key(l) < key(r));
+        });
+
+    if (parallelism > candidates.size()) {
+        log::instance().write(log_level::warning, "{} worker threads are "
+            "placed on {} logical processors, which will oversubscribe the "
+            "processors.\n", parallelism, candidates.size());
+    }
+
+    retval.reserve(parallelism);
+    for (size_t i = 0; i < parallelism; ++i) {
+        auto& p = candidates[i % candidates.size()];
+        log::instance().write(log_level::verbose, "Rank {} is placed on "
+            "logical processor {} (package {}, core {}, SMT thread {}).\n",
+            i, p.id, p.package, p.core, p.smt);
+        retval.push_back(p);
     }
 
     return retval;
 }
 
 
+/*
+ * trrojan::stream::worker_thread::pin
+ */
+void trrojan::stream::worker_thread::pin(
+        const cpu_topology::logical_processor& processor) {
+#if defined(_WIN32)
+    GROUP_AFFINITY ga;
+    ::ZeroMemory(&ga, sizeof(ga));
+    ga.Group = processor.group;
+    ga.Mask = static_cast<KAFFINITY>(cpu_topology::affinity_mask(processor));
+
+    if (!::SetThreadGroupAffinity(::GetCurrentThread(), &ga, nullptr)) {
+        std::error_code ec(::GetLastError(), std::system_category());
+        throw std::system_error(ec, "Setting thread affinity failed.");
+    }
+
+#elif defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(processor.id, &cpus);
+
+    auto status = ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus),
+        &cpus);
+    if (status != 0) {
+        std::error_code ec(status, std::system_category());
+        throw std::system_error(ec, "Setting thread affinity failed.");
+    }
+
+#else /* defined(_WIN32) */
+    log::instance().write(log_level::warning, "Thread affinity is not "
+        "supported on this platform.\n");
+#endif /* defined(_WIN32) */
+}
+
+
 /*
  * trrojan::stream::worker_thread::start
  */
@@ -128,6 +267,34 @@ void trrojan::stream::worker_thread::start(problem_type problem,
     ::pthread_attr_setscope(&attribs, PTHREAD_SCOPE_SYSTEM);
     ::pthread_attr_setdetachstate(&attribs, PTHREAD_CREATE_JOINABLE);
 
+    /* Set affinity before the thread starts running. */
+#if defined(__linux__)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        if (affinity_mask != 0) {
+            for (size_t i = 0; i < sizeof(affinity_mask) * CHAR_BIT; ++i) {
+                if ((affinity_mask & (static_cast<uint64_t>(1) << i)) != 0) {
+                    CPU_SET(affinity_group * 64 + i, &cpus);
+                }
+            }
+        } else {
+            CPU_SET(rank, &cpus);
+        }
+
+        auto status = ::pthread_attr_setaffinity_np(&attribs, sizeof(cpus),
+            &cpus);
+        if (status != 0) {
+            std::error_code ec(status, std::system_category());
+            ::pthread_attr_destroy(&attribs);
+            throw std::system_error(ec, "Setting thread affinity failed.");
+        }
+    }
+#else /* defined(__linux__) */
+    log::instance().write(log_level::warning, "Thread affinity is not "
+        "supported on this platform.\n");
+#endif /* defined(__linux__) */
+
     if (::pthread_create(&this->hThread, &attribs, worker_thread::thunk,
             static_cast<void *>(this)) != 0) {
         std::error_code ec(errno, std::system_category());
@@ -137,27 +304,22 @@ void trrojan::stream::worker_thread::start(problem_type problem,
         ::pthread_attr_destroy(&attribs);
     }
 
-    // TODO: priority
-    // TODO: affinity
-
-    log::instance().write(log_level::error, "TODO: IMPLEMENTATION OF AFFINITY MISSING!\n");
-
-    // http://eli.thegreenplace.net/2016/c11-threads-affinity-and-hyperthreading/
-    /*
-    // Create a cpu_set_t object representing a set of CPUs. Clear it and mark
-    // only CPU i as set.
-    cpu_set_t cpuset;
-    CPU_ZERO(&cpuset);
-    CPU_SET(i, &cpuset);
-    int rc = pthread_setaffinity_np(threads[i].native_handle(),
-    sizeof(cpu_set_t), &cpuset);
-    if (rc != 0) {
-    std::cerr << "Error calling pthread_setaffinity_np: " << rc << "\n";
+    /* Give maximum priority to thread if requested. */
+    if (this->_problem->real_time_priority()) {
+        sched_param param;
+        param.sched_priority = ::sched_get_priority_max(SCHED_FIFO);
+        auto status = ::pthread_setschedparam(this->hThread, SCHED_FIFO,
+            &param);
+        if (status != 0) {
+            // This is expected if the process has no CAP_SYS_NICE, so we do
+            // not fail, but the user should know that the results might be
+            // disturbed by other processes.
+            log::instance().write(log_level::warning, "Real-time scheduling "
+                "could not be enabled for worker thread {} (error {}). The "
+                "thread will run with normal priority.\n", this->rank,
+                status);
+        }
     }
-    */
-
-//    throw 1;
-
 #endif /* _WIN32 */
 }
 
@@ -174,11 +336,14 @@ void *trrojan::stream::worker_thread::thunk(void *param) {
     assert(that != nullptr);
     assert(that->_problem != nullptr);
 
+    // Initialise the slice of the rank from the pinned thread such that the
+    // pages are first touched on the NUMA node we are running on.
+    that->_problem->initialise(that->rank);
+
     that->results_lock.lock();
     that->dispatch(scalar_type_list(),
         that->_problem->scalar_type(),
         that->_problem->access_pattern(),
-        that->_problem->size(),
         that->_problem->task_type());
     that->results_lock.unlock();
 
@@ -189,17 +354,14 @@ void *trrojan::stream::worker_thread::thunk(void *param) {
 /*
  * trrojan::stream::worker_thread::synchronise
  */
-void trrojan::stream::worker_thread::synchronise(const int barrierId) {
-    // Implementation of repeated barrier as in
-    // http://stackoverflow.com/questions/24205226/how-to-implement-a-re-usable-thread-barrier-with-stdatomic
+trrojan::timer::value_type trrojan::stream::worker_thread::synchronise(
+        void) {
     assert(this->barrier != nullptr);
     assert(this->_problem != nullptr);
-    assert(INT_MAX / this->_problem->parallelism() > barrierId);
-    auto& barrier = *this->barrier;
-    auto expected = static_cast<int>(this->_problem->parallelism());
-    expected *= (barrierId + 1);
-    ++barrier;
-    while (barrier.load() - barrierId < 0);    // TODO: Should yield if too many threads?
+    assert(this->barrier->parallelism() == this->_problem->parallelism());
+    auto retval = trrojan::timer::now();
+    this->barrier->arrive_and_wait();
+    return retval;
 }
 
 #if 0